@@ -23,8 +23,12 @@
 #include "config/SLArCfgMegaTile.hh"
 #include "config/SLArCfgSuperCellArray.hh"
 #include "event/SLArMCEvent.hh"
+#include "event/SLArPixelFrontEnd.hh"
 
 #include "SLArBacktrackerManager.hh"
+#include "SLArPhaseSpaceRecord.hh"
+#include "SLArImportanceMap.hh"
+#include "SLArTrackKillingRules.hh"
 #include "SLArAnalysisManagerMsgr.hh"
 
 #include "G4ToolsAnalysisManager.hh"
@@ -111,13 +115,30 @@ class SLArAnalysisManager
     void RegisterXSecDump(const SLArXSecDumpSpec xsec_dump); 
     inline void SetStoreTrajectoryFull(const bool store_trj_pts) {fTrajectoryFull = store_trj_pts;} 
     inline G4bool StoreTrajectoryFull() const {return fTrajectoryFull;}
+    inline void EnablePixelFrontEnd(const bool enable) {fEnablePixelFrontEnd = enable;}
+    inline G4bool IsPixelFrontEndEnabled() const {return fEnablePixelFrontEnd;}
+    inline void SetDropRawChargeTicks(const bool drop) {fDropRawChargeTicks = drop;}
+    inline G4bool DropRawChargeTicks() const {return fDropRawChargeTicks;}
+    inline SLArPixelFrontEnd& GetPixelFrontEnd() {return fPixelFrontEnd;}
+    G4int  ProcessPixelFrontEnd(); 
+    void   ClearRawChargeTicks(); 
 
     SLArAnalysisManagerMsgr* fAnaMsgr;
-#ifdef SLAR_EXTERNAL
+
+    // external background (stage-1) mode
+    inline void SetExternalMode(const bool ext) {fExternalMode = ext;}
+    inline G4bool IsExternalMode() const {return fExternalMode;}
+    inline G4bool IsRecordingPhaseSpace() const {return fExternalMode || !fPhaseSpaceScorers.empty();}
+    G4int RegisterPhaseSpaceScorer(const G4String alias); 
+    inline const std::vector<G4String>& GetPhaseSpaceScorers() const {return fPhaseSpaceScorers;}
     void SetupExternalsTree(); 
     inline TTree* GetExternalsTree() {return fExternalsTree;}
     inline SLArEventTrajectoryLite& GetExternalRecord() {return fExternalRecord;}
-#endif 
+    void SetupPhaseSpaceTree(); 
+    inline SLArPhaseSpaceRecord_t& GetPhaseSpaceRecord() {return fPhaseSpaceRecord;}
+    void FillPhaseSpaceTree(); 
+    inline SLArImportanceMap& GetImportanceMap() {return fImportanceMap;}
+    inline SLArTrackKillingRules& GetTrackKillingRules() {return fTrackKillingRules;}
 
   protected:
     // virtual functions (overriden in MPI implementation)
@@ -133,16 +154,23 @@ class SLArAnalysisManager
     G4String fOutputPath;
     G4String fOutputFileName;
     G4bool   fTrajectoryFull;
+    G4bool   fEnablePixelFrontEnd;
+    G4bool   fDropRawChargeTicks;
+    SLArPixelFrontEnd fPixelFrontEnd;
     std::map<G4String, G4double> fBiasing; 
     std::vector<SLArXSecDumpSpec> fXSecDump;
 
     TFile* fRootFile;
     TTree* fEventTree;
     SLArMCEvent  fMCEvent;
-#ifdef SLAR_EXTERNAL
+    G4bool   fExternalMode; 
+    std::vector<G4String> fPhaseSpaceScorers; 
     SLArEventTrajectoryLite fExternalRecord;
     TTree* fExternalsTree;
-#endif 
+    SLArPhaseSpaceRecord_t fPhaseSpaceRecord; 
+    TTree* fPhaseSpaceTree; 
+    SLArImportanceMap fImportanceMap; 
+    SLArTrackKillingRules fTrackKillingRules; 
 
     backtracker::SLArBacktrackerManager* fSuperCellBacktrackerManager;
     backtracker::SLArBacktrackerManager* fVUVSiPMBacktrackerManager;
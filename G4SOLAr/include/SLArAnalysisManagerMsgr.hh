@@ -45,15 +45,25 @@ class SLArAnalysisManagerMsgr : public G4UImessenger
     G4UIcmdWithAString*         fCmdWriteCfgFile  ; 
     G4UIcmdWithAString*         fCmdPlotXSec      ; 
     G4UIcmdWithAnInteger*       fCmdGeoAnodeDepth ; 
+    G4UIcmdWithAString*         fCmdGeoProfile    ; 
     G4UIcmdWithABool*           fCmdStoreFullTrajectory;
     G4UIcmdWithAString*         fCmdEnableBacktracker;
     G4UIcmdWithAString*         fCmdRegisterBacktracker;
     G4UIcmdWithAnInteger*       fCmdSetZeroSuppressionThrs;
+    G4UIcmdWithAString*         fCmdSetZeroSuppressionMode;
+    G4UIcmdWithABool*           fCmdEnablePixelFrontEnd;
+    G4UIcmdWithABool*           fCmdDropRawChargeTicks;
+    G4UIcmdWithAString*         fCmdSetPixelFrontEndPar;
 #ifdef SLAR_GDML
     G4UIcmdWithAString*         fCmdGDMLFileName  ; 
     G4UIcmdWithAString*         fCmdGDMLExport    ;
 #endif
     G4UIcmdWithAString*         fCmdAddExtScorer; 
+    G4UIcmdWithAString*         fCmdScoreImportance; 
+    G4UIcmdWithAString*         fCmdSetImportanceMapOutput; 
+    G4UIcmdWithADouble*         fCmdSetMaxImportance; 
+    G4UIcmdWithAString*         fCmdLoadTrackKillingRules; 
+    G4UIcmdWithABool*           fCmdEnablePDECulling; 
     G4String                    fGDMLFileName     ; 
 };
 
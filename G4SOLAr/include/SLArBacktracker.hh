@@ -11,6 +11,7 @@
 #include <vector>
 #include <functional>
 #include "G4String.hh"
+#include "RtypesCore.h"
 
 class SLArEventGenericHit;
 class SLArEventPhotonHit;
@@ -33,7 +34,7 @@ class SLArBacktracker {
     SLArBacktracker(const G4String name);
     inline ~SLArBacktracker() {}; 
     
-    inline virtual void Eval(SLArEventGenericHit* hit, SLArEventBacktrackerRecord* rec) {}; 
+    inline virtual void Eval(SLArEventGenericHit* hit, SLArEventBacktrackerRecord* rec, const UShort_t w = 1) {}; 
     inline G4String GetName() const {return fName;}
     inline void SetName(const G4String name) {fName = name;}
 
@@ -47,7 +48,7 @@ class SLArBacktrackerTrkID : public SLArBacktracker {
     inline SLArBacktrackerTrkID(const G4String name) : SLArBacktracker(name) {}
     inline ~SLArBacktrackerTrkID() {}
 
-    void Eval(SLArEventGenericHit* hit, SLArEventBacktrackerRecord* rec) override;
+    void Eval(SLArEventGenericHit* hit, SLArEventBacktrackerRecord* rec, const UShort_t w = 1) override;
 };
 
 class SLArBacktrackerAncestorID : public SLArBacktracker {
@@ -56,7 +57,7 @@ class SLArBacktrackerAncestorID : public SLArBacktracker {
     inline SLArBacktrackerAncestorID(const G4String name) : SLArBacktracker(name) {}
     inline ~SLArBacktrackerAncestorID() {}
 
-    void Eval(SLArEventGenericHit* hit, SLArEventBacktrackerRecord* rec) override;
+    void Eval(SLArEventGenericHit* hit, SLArEventBacktrackerRecord* rec, const UShort_t w = 1) override;
 };
 
 class SLArBacktrackerOpticalProcess : public SLArBacktracker {
@@ -65,7 +66,7 @@ class SLArBacktrackerOpticalProcess : public SLArBacktracker {
     inline SLArBacktrackerOpticalProcess(const G4String name) : SLArBacktracker(name) {}
     inline ~SLArBacktrackerOpticalProcess() {}
 
-    void Eval(SLArEventGenericHit* hit, SLArEventBacktrackerRecord* rec) override;
+    void Eval(SLArEventGenericHit* hit, SLArEventBacktrackerRecord* rec, const UShort_t w = 1) override;
 };
 
 }
@@ -32,6 +32,7 @@ namespace gen{
 #ifdef SLAR_RADSRC
       ,kRadSrc=8
 #endif // DEBUG
+      ,kPhaseSpace=9
   };
 
   static const std::map<G4String, EGenerator> genMap = {
@@ -47,6 +48,7 @@ namespace gen{
 #ifdef SLAR_RADSRC
     ,{"radsrc", EGenerator::kRadSrc}
 #endif
+    ,{"phasespace", EGenerator::kPhaseSpace}
   };
 
   static inline EGenerator GetGeneratorIndex(const G4String gen_type) {
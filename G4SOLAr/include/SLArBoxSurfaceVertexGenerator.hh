@@ -43,6 +43,8 @@ class SLArBoxSurfaceVertexGenerator : public SLArVertexGenerator
     void SetRandomSeed(unsigned int seed_);
     void SetNoDaughters(bool no_daughters_);
     G4double GetSurfaceGenerator() const; 
+    //! Inward normal of the current vertex face in the world frame
+    G4ThreeVector GetVertexFaceNormal() const; 
 
     void ShootVertex(G4ThreeVector & vertex_) override;
     void Config(const rapidjson::Value& config) override;
@@ -72,7 +74,14 @@ class SLArBoxSurfaceVertexGenerator : public SLArVertexGenerator
     const G4VSolid * fSolid = nullptr; ///< Reference to the solid volume from which are generated vertexes
     G4RotationMatrix fBulkInverseRotation; ///< The inverse box rotation
     G4double fSurface = 0.0; 
+    G4ThreeVector fBoxCenter; ///< Center of the bounding box in the solid frame
+    G4ThreeVector fBoxDim; ///< Dimensions of the bounding box
+    G4double fFaceArea[6] = {0.}; ///< Area of the bounding box faces
+    G4double fFaceCDF[6] = {0.}; ///< Cumulative face sampling probability
     unsigned int fCounter = 0.0; // Internal vertex counter
+
+    //! Cache the bounding box dimensions and the face sampling CDF
+    void ComputeFaceCDF(); 
 }; 
 }
 #endif /* end of include guard SLARBOXSURFACEVERTEXGENERATOR_HH */
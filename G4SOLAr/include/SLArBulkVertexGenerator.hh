@@ -10,6 +10,7 @@
 
 // Standard library
 #include <random>
+#include <vector>
 
 #include <G4LogicalVolume.hh>
 #include <G4Box.hh>
@@ -21,6 +22,13 @@ namespace gen {
 class SLArBulkVertexGenerator: public SLArVertexGenerator
 {
 public:
+  enum ESamplingMode {kBoxRejection = 0, kVoxelized = 1};
+
+  /// Voxel of the inside-map used by the voxelized sampler
+  struct BulkVoxel_t {
+    G4ThreeVector fLow; //!< Lower corner of the voxel (solid local frame)
+    bool fFullyInside = false; //!< Voxel is entirely contained in the solid
+  };
 
   SLArBulkVertexGenerator();
 
@@ -54,7 +62,7 @@ public:
 
   void SetNoDaughters(bool no_daughters_);
 
-  void SetFiducialFraction(double fvf) {fFVFraction = fvf;} 
+  void SetFiducialFraction(double fvf); 
 
   double GetFiducialFraction() {return fFVFraction;}
 
@@ -72,12 +80,32 @@ public:
     return fLogVol->GetMass();
   }
 
+  inline ESamplingMode GetSamplingMode() const {return fSamplingMode;}
+
+  inline double GetAcceptance() const {return fAcceptance;}
+
+  inline size_t GetNumberOfVoxels() const {return fVoxels.size();}
+
+  void SetVoxelThreshold(double threshold) {fVoxelThreshold = threshold;}
+
+  void SetVoxelTargetCount(size_t n) {fVoxelTargetCount = n;}
+
+  void BuildSampler(); 
+
+  void PrintSamplerReport(const size_t n_vertices); 
+
   inline void Print() const override {
     printf("SLArBulkVertexGenerator info dump:\n"); 
     printf("logical (solid) volume name: %s (%s)\n",
         fLogVol->GetName().data(), fSolid->GetName().data()); 
-    printf("Reject daughters: %i\nFiducial fraction: %g\n\n", 
+    printf("Reject daughters: %i\nFiducial fraction: %g\n", 
         fNoDaughters, fFVFraction); 
+    printf("Sampling mode: %s - box acceptance: %g", 
+        fSamplingMode == kVoxelized ? "voxelized" : "box rejection", fAcceptance);
+    if (fSamplingMode == kVoxelized) {
+      printf(" - %lu voxels (acceptance %g)", fVoxels.size(), fVoxelAcceptance);
+    }
+    printf("\n\n");
     return;
   }
 
@@ -97,8 +125,23 @@ private:
   G4VSolid * fSolid = nullptr; ///< Reference to the solid volume from which are generated vertexes
   G4RotationMatrix fBulkInverseRotation; ///< The inverse box rotation
   unsigned int fCounter = 0.0; // Internal vertex counter
-
-  double ComputeDeltaX(G4ThreeVector& lo, G4ThreeVector& hi, double fiducialf = 1.); 
+  
+  // Precomputed sampler:
+  G4ThreeVector fLo; //!< Cached lower sampling limits (fiducial box, local frame)
+  G4ThreeVector fHi; //!< Cached upper sampling limits (fiducial box, local frame)
+  ESamplingMode fSamplingMode = kBoxRejection; //!< Active sampling strategy
+  double fAcceptance{1.0}; //!< Estimated acceptance of the bounding box rejection
+  double fVoxelAcceptance{1.0}; //!< Estimated acceptance within the voxel map
+  double fVoxelThreshold{0.2}; //!< Box acceptance below which the voxel map is built
+  size_t fVoxelTargetCount{100000}; //!< Approximate number of voxels of the inside-map
+  size_t fAcceptanceSamples{20000}; //!< Number of probes for the acceptance estimate
+  G4ThreeVector fVoxelSize; //!< Voxel dimensions
+  std::vector<BulkVoxel_t> fVoxels; //!< Voxels intersecting the solid
+
+  double ComputeDeltaX(const G4ThreeVector& lo, const G4ThreeVector& hi, double fiducialf = 1.); 
+  double EstimateAcceptance(std::mt19937_64& rng) const; 
+  void BuildVoxelMap(std::mt19937_64& rng); 
+  void ShootLocalVertex(G4ThreeVector& localVertex, G4int& ntries); 
      
 };
 }
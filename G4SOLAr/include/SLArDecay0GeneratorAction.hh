@@ -70,6 +70,24 @@ class SLArDecay0GeneratorAction : public SLArBaseGenerator {
       G4bool    mdl_error_on_missing_particle = false;
       
     };
+
+    /// \brief Pile-up mode configuration
+    ///
+    /// When enabled, a single G4Event contains all the decays expected in 
+    /// the given time window according to the specific activity of the 
+    /// nuclide and the mass of the volume sampled by the bulk vertex generator. 
+    /// Decay times are uniformly distributed in the window (Poisson process). 
+    struct PileUpConfig_t
+    {
+      void print(std::ostream & out_, const std::string & indent_ = "") const;
+
+      G4bool    enabled = false;    ///< Pile-up mode flag
+      G4double  activity = 0.0;     ///< Specific activity (e.g. Bq/kg)
+      G4double  mass = 0.0;         ///< Mass of the sampled volume
+      G4double  time_window = 0.0;  ///< Length of the readout window
+      G4double  time_offset = 0.0;  ///< Start time of the readout window
+      G4double  mean_decays = 0.0;  ///< Expected number of decays in the window
+    };
  
     SLArDecay0GeneratorAction(const G4String label = "decay0", int verbosity_ = 0); 
     SLArDecay0GeneratorAction(const Decay0Config_t&, const G4String label, int verbosity_); 
@@ -77,6 +95,11 @@ class SLArDecay0GeneratorAction : public SLArBaseGenerator {
 
     void Configure( const rapidjson::Value& config) override;
 
+    /// Configure the pile-up mode (requires a bulk vertex generator)
+    void ConfigurePileUp( const rapidjson::Value& config);
+
+    const PileUpConfig_t & GetPileUpConfiguration() const {return fPileUp;}
+
     G4String GetGeneratorType() const override {return "decay0";}
     EGenerator GetGeneratorEnum() const override {return kDecay0;}
 
@@ -132,6 +155,7 @@ class SLArDecay0GeneratorAction : public SLArBaseGenerator {
     std::unique_ptr<G4ParticleGun> _particle_gun_ = nullptr; ///< The Geant4 particle gun
     SLArDecay0GeneratorMessenger * _messenger_ = nullptr; ///< Messenger
     Decay0Config_t fConfig; ///< Current configuration
+    PileUpConfig_t fPileUp; ///< Pile-up mode configuration
     bool _config_has_changed_ = false; ///< Config change flag
     int _verbosity_ = 0; ///< Verbosity level (0=mute, 1=info, 2=debug, 3=trace)
     double _decaytime_ = 0;
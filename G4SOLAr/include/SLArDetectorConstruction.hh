@@ -17,6 +17,7 @@
 #include "detector/Anode/SLArDetAnodeAssembly.hh"
 
 #include "SLArAnalysisManagerMsgr.hh"
+#include "SLArUserRegionInformation.hh"
 
 #include "globals.hh"
 #include "G4VUserDetectorConstruction.hh"
@@ -31,6 +32,7 @@
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 class SLArCfgSuperCellArray;
+class SLArOpticalLookup;
 
 /**
  * @brief SoLAr detector construction class
@@ -65,6 +67,10 @@ class SLArDetectorConstruction : public G4VUserDetectorConstruction
     virtual void ConstructSDandField();
     //! Construct virtual pixelization of the anode readout system
     void ConstructAnodeMap(); 
+    //! Build the megatile, tile and pixel maps of a single anode
+    void BuildAnodeMap(SLArCfgAnode& anodeCfg); 
+    //! Create the G4Regions declared in the geometry configuration
+    void ConstructRegions(); 
     G4VIStore* CreateImportanceStore();
     //! Return SLArDetectorConstruction::fTPCs map
     inline std::map<G4int, SLArDetTPC*>& GetDetTPCs() {return fTPC;}
@@ -91,8 +97,17 @@ class SLArDetectorConstruction : public G4VUserDetectorConstruction
     void                            ConstructCryostatScorer(); 
     //! Set anode visualization attributes 
     void                            SetAnodeVisAttributes(const int depth = 0); 
+    //! Profile the navigation cost of the geometry with probe rays in the LAr target
+    void                            ProfileGeometry(const G4int n_rays, const G4String& output); 
     //! Add External Scorer Volume
     void                            AddExternalScorer(const G4String phys_volume_name, const G4String alias);
+    //! Apply the sensor detection efficiency at the photon creation
+    inline void                     SetEarlyPDECulling(const G4bool culling) {fEarlyPDECulling = culling;}
+    inline G4bool                   IsEarlyPDECulling() const {return fEarlyPDECulling;}
+    //! Survival probability of the optical photons at creation (1 if culling is off)
+    inline G4double                 GetPhotonSurvivalProb() const {return fPhotonSurvivalProb;}
+    //! Build the optical lookup used by the hybrid optical mode (owned by the caller)
+    SLArOpticalLookup*              BuildOpticalLookup() const; 
 
   private:
     //! Detector description initilization
@@ -121,6 +136,10 @@ class SLArDetectorConstruction : public G4VUserDetectorConstruction
     G4VPhysicalVolume* fCavernPhys;//!< Cavern physical volume
     std::vector<G4VPhysicalVolume*> fSuperCellsPV;
     std::vector<G4VPhysicalVolume*> fExtScorerPV;
+    //! Regions declared in the geometry configuration
+    std::vector<SLArUserRegionInformation*> fRegionInfo; 
+    G4bool fEarlyPDECulling; //!< Enable the early photon-detection-efficiency culling
+    G4double fPhotonSurvivalProb; //!< Max sensor PDE used as photon survival probability
     G4String GetFirstChar(G4String line);
     
     //! Construct Cavern
@@ -137,6 +156,8 @@ class SLArDetectorConstruction : public G4VUserDetectorConstruction
     void InitTPC(const rapidjson::Value&); 
     //! Parse the description of the cathode elements
     void InitCathode(const rapidjson::Value&); 
+    //! Rescale the sensor efficiency tables by the maximum PDE
+    void ApplyEarlyPDECulling(); 
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
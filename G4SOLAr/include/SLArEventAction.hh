@@ -51,7 +51,7 @@ public:
     virtual void BeginOfEventAction(const G4Event*);
     virtual void EndOfEventAction(const G4Event*);
 
-    inline void IncPhotonCount_Scnt()  {fPhotonCount_Scnt++;}
+    inline void IncPhotonCount_Scnt(G4int n=1) {fPhotonCount_Scnt+=n;}
     inline void IncPhotonCount_Cher()  {fPhotonCount_Cher++;}
     inline void IncPhotonCount_WLS ()  {fPhotonCount_WLS ++;}
     inline void IncAbsorption()        {fAbsorptionCount++;}
@@ -130,7 +130,7 @@ private:
     G4int fBoundaryAbsorptionCount;
     G4double fTotEdep;
 
-    std::map<int, int> fParentIDMap;
+    std::vector<int> fAncestorIDs; //!< Primary ancestor of each track (indexed by track ID)
     std::map<TrackIdHelpInfo_t, G4String> fExtraProcessInfo;
 
     G4int RecordEventReadoutTile (const G4Event* ev, const G4int& verbose = 0);
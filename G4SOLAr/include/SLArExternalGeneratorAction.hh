@@ -11,12 +11,12 @@
 #include <SLArVertextGenerator.hh>
 #include <SLArBaseGenerator.hh>
 #include <SLArPGunGeneratorAction.hh>
+#include <SLArRandomExtra.hh>
 
 #include <G4VUserPrimaryGeneratorAction.hh>
 #include <G4ParticleGun.hh>
 
 #include <TH1D.h>
-#include <TRandom3.h>
 
 class G4ParticleTable;
 
@@ -32,6 +32,7 @@ class SLArExternalGeneratorAction : public SLArBaseGenerator
       G4String ext_primary_particle {};
       G4double ext_particle_energy {};
       G4int    n_particles = 1;
+      G4String angular_distribution = "cosine"; //!< "cosine" or "isotropic" (surface vertices only)
     };
     SLArExternalGeneratorAction(const G4String label = "");
     virtual ~SLArExternalGeneratorAction(); 
@@ -50,7 +51,7 @@ class SLArExternalGeneratorAction : public SLArBaseGenerator
     std::unique_ptr<G4ParticleGun> fParticleGun; 
     G4ParticleDefinition* fParticleDef; 
     std::unique_ptr<TH1D> fEnergySpectrum; 
-    std::unique_ptr<TRandom3> fRandomEngine; 
+    SLArSpectrumSampler fEnergySampler; //!< Alias sampler built from fEnergySpectrum
 
 }; 
 
@@ -0,0 +1,81 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArGeometryProfiler.hh
+ * @created     Tuesday Oct 20, 2026 12:06:40 CEST
+ */
+
+#ifndef SLARGEOMETRYPROFILER_HH
+
+#define SLARGEOMETRYPROFILER_HH
+
+#include <map>
+#include <vector>
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+class G4VPhysicalVolume;
+class G4LogicalVolume;
+
+/**
+ * @brief Navigation cost profiler of the detector geometry
+ *
+ * The profiler shoots straight probe rays from random points sampled in a
+ * box (by default the LAr target) along isotropic directions and steps
+ * them through the geometry with a dedicated G4Navigator, as a geantino
+ * would be transported. For each logical volume it records the number of
+ * navigation steps and the time spent in G4Navigator::ComputeStep and
+ * G4Navigator::LocateGlobalPointAndSetup, together with static information
+ * on the volume: number of daughters, smartless parameter and number of
+ * voxel slices, depth in the volume tree and number of replicated or
+ * parameterised levels above it. Volumes with replicated/parameterised
+ * daughters nested below other parameterised levels (such as the anode
+ * and SuperCell arrays) are flagged as deep parameterised hierarchies.
+ *
+ * The summary is printed and written to a json file, e.g.
+ * ```
+ * /SLAr/geometry/profile 10000 geometry_profile.json
+ * ```
+ */
+class SLArGeometryProfiler {
+  public:
+    struct VolumeStats_t {
+      G4String fName;
+      G4int    fNDaughters = 0;
+      G4bool   fParamDaughters = false; //!< Has replicated/parameterised daughters
+      G4double fSmartless = 0.0;
+      G4int    fNVoxelSlices = 0;
+      G4int    fDepth = 0;              //!< Depth in the volume tree (world = 0)
+      G4int    fParamLevels = 0;        //!< Replicated/parameterised placements above the volume
+      G4bool   fDeepHierarchy = false;
+      G4long   fSteps = 0;
+      G4double fNavTime = 0.0;          //!< Navigation time [s]
+    };
+
+    SLArGeometryProfiler(G4VPhysicalVolume* world);
+    ~SLArGeometryProfiler() {}
+
+    inline void SetSamplingBox(const G4ThreeVector& center, const G4ThreeVector& half_size) {
+      fBoxCenter = center; fBoxHalfSize = half_size;
+    }
+    inline void SetMaxStepsPerRay(const G4int n) {fMaxStepsPerRay = n;}
+
+    void Run(const G4int n_rays);
+    void Print() const;
+    G4bool Write(const G4String& file_path) const;
+
+  private:
+    void ScanVolumeTree(const G4LogicalVolume* lv, const G4int depth, const G4int param_levels);
+
+    G4VPhysicalVolume* fWorld;
+    G4ThreeVector fBoxCenter;
+    G4ThreeVector fBoxHalfSize;
+    G4int fMaxStepsPerRay;
+    G4int fNRays;
+    G4long fNSteps;
+    G4double fTotalTime; //!< Total navigation time [s]
+    std::map<const G4LogicalVolume*, VolumeStats_t> fStats;
+};
+
+#endif /* end of include guard SLARGEOMETRYPROFILER_HH */
+
@@ -0,0 +1,82 @@
+/**
+ * @author      : Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        : SLArImportanceMap.hh
+ * @created     : Monday Oct 19, 2026 19:24:16 CEST
+ */
+
+#ifndef SLARIMPORTANCEMAP_HH
+
+#define SLARIMPORTANCEMAP_HH
+
+#include <map>
+#include <utility>
+#include "globals.hh"
+
+class G4VPhysicalVolume;
+
+/**
+ * @brief Importance map of the geometry cells used by the importance sampling
+ *
+ * The map associates an importance to each geometry cell (physical volume
+ * name and replica number) and can be stored in or loaded from a json file.
+ *
+ * The importances are derived from a pilot run: when scoring is enabled the
+ * weighted population of the particle of interest entering each cell is
+ * accumulated, and the importance of a cell is set to the ratio between the
+ * population of the most populated cell (the source region) and its own,
+ * rounded to a power of two and capped to a maximum value. Since the
+ * population is weighted, a pilot run can itself use the previous map and
+ * the procedure can be iterated to reach deeper cells. Cells missing from
+ * a loaded map, i.e. never reached in the pilot runs, inherit the
+ * importance of their mother volume when the importance store is built
+ * (see SLArDetectorConstruction::CreateImportanceStore).
+ */
+class SLArImportanceMap {
+  public:
+    typedef std::pair<G4String, G4int> CellKey_t;
+    struct CellData_t {
+      G4double fImportance = 1.0;  //!< Cell importance
+      G4double fPopulation = 0.0;  //!< Weighted population scored in the pilot run
+      G4int    fEntries = 0;       //!< Number of tracks scored in the pilot run
+    };
+
+    SLArImportanceMap();
+    ~SLArImportanceMap() {}
+
+    G4bool Load(const G4String& file_path);
+    G4bool Write(const G4String& file_path) const;
+
+    inline G4bool IsLoaded() const {return fIsLoaded;}
+    G4double GetImportance(const G4String& pv_name, const G4int replica, const G4double default_imp) const;
+    inline G4bool HasCell(const G4String& pv_name, const G4int replica) const {
+      return fCells.count(CellKey_t(pv_name, replica)) > 0;
+    }
+    inline void SetImportance(const G4String& pv_name, const G4int replica, const G4double imp) {
+      fCells[CellKey_t(pv_name, replica)].fImportance = imp;
+    }
+    inline const std::map<CellKey_t, CellData_t>& GetCells() const {return fCells;}
+
+    // pilot run scoring
+    void EnableScoring(const G4String& particle_name);
+    inline G4bool IsScoring() const {return fIsScoring;}
+    inline const G4String& GetScoringParticle() const {return fParticleName;}
+    inline void SetMaxImportance(const G4double max_imp) {fMaxImportance = max_imp;}
+    inline G4double GetMaxImportance() const {return fMaxImportance;}
+    inline void SetOutputFile(const G4String& file_path) {fOutputFile = file_path;}
+    inline const G4String& GetOutputFile() const {return fOutputFile;}
+    void ScoreEntry(const G4VPhysicalVolume* pv, const G4int replica, const G4double weight);
+    void ComputeImportances();
+
+  private:
+    std::map<CellKey_t, CellData_t> fCells;
+    //! Cells indexed by physical volume pointer for the scoring
+    std::map<std::pair<const G4VPhysicalVolume*, G4int>, CellData_t*> fCellCache;
+    G4bool   fIsLoaded;
+    G4bool   fIsScoring;
+    G4String fParticleName;
+    G4double fMaxImportance;
+    G4String fOutputFile;
+};
+
+#endif /* end of include guard SLARIMPORTANCEMAP_HH */
+
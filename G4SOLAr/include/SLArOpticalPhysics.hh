@@ -46,6 +46,8 @@
 #include "G4OpAbsorption.hh"
 #include "G4OpBoundaryProcess.hh"
 #include "SLArScintillation.h"
+#include "physics/SLArOpAbsorption.hh"
+#include "physics/SLArOpRayleigh.hh"
 
 #include "G4VPhysicsConstructor.hh"
 
@@ -76,6 +78,9 @@ class SLArOpticalPhysics : public G4VPhysicsConstructor
 
     void SetNbOfPhotonsCerenkov(G4int);
 
+    //! Use tabulated absorption and Rayleigh mean free paths (before ConstructProcess)
+    void SetTabulatedProperties(G4bool toggle) {fTabulatedOn = toggle;}
+
   private:
 
     //G4OpWLS*             fWLSProcess;
@@ -88,6 +93,7 @@ class SLArOpticalPhysics : public G4VPhysicsConstructor
 
     G4bool fAbsorptionOn;
     G4bool fCerenkovOn; 
+    G4bool fTabulatedOn;
 
 };
 #endif
@@ -11,6 +11,7 @@
 #include <string>
 #include <SLArVertextGenerator.hh>
 #include <SLArBaseGenerator.hh>
+#include <SLArRandomExtra.hh>
 
 #include <G4ParticleDefinition.hh>
 #include <G4ThreeVector.hh>
@@ -56,6 +57,8 @@ class SLArPBombGeneratorAction : public SLArBaseGenerator
 
   protected: 
     PBombConfig_t fBombConfig;
+    SLArSpectrumSampler fEnergySampler; //!< Energy distribution (if any)
+    SLArSpectrumSampler fCosThetaSampler; //!< cos(theta) distribution w.r.t. the bomb direction (if any)
     G4ThreeVector fVertex; 
     G4ParticleDefinition* fParticleDefinition; 
     G4ParticleTable* fParticleTable; 
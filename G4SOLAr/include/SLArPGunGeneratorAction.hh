@@ -10,6 +10,7 @@
 
 #include <string>
 #include <SLArBaseGenerator.hh>
+#include <SLArRandomExtra.hh>
 #include <G4VUserPrimaryGeneratorAction.hh>
 #include <G4ParticleGun.hh>
 class G4ParticleTable; 
@@ -51,6 +52,8 @@ class SLArPGunGeneratorAction : public SLArBaseGenerator
 
   protected: 
     PGunConfig_t fGunConfig; 
+    SLArSpectrumSampler fEnergySampler; //!< Energy distribution (if any)
+    SLArSpectrumSampler fCosThetaSampler; //!< cos(theta) distribution w.r.t. the gun direction (if any)
     std::unique_ptr<G4ParticleGun> fParticleGun; 
     G4ParticleTable* fParticleTable; 
 
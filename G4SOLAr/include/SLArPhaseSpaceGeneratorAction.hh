@@ -0,0 +1,80 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArPhaseSpaceGeneratorAction.hh
+ * @created     Monday Oct 19, 2026 18:47:05 CEST
+ */
+
+#ifndef SLARPHASESPACEGENERATORACTION_HH
+
+#define SLARPHASESPACEGENERATORACTION_HH
+
+#include <vector>
+
+#include <SLArBaseGenerator.hh>
+#include <SLArPhaseSpaceRecord.hh>
+
+class G4ParticleDefinition;
+
+namespace gen {
+
+/**
+ * @brief Second stage of the external background simulation
+ *
+ * Replay the phase-space records written at the external scorers during the
+ * first stage (solar_sim --external). Each record can be split into
+ * `splitting_factor` identical primaries and the whole file can be reused
+ * `reuse_factor` times: the primary weights are the stage-1 weights divided
+ * by the product of the two factors, so that weighted sums stay unbiased.
+ * The copies of a record are generated in consecutive events, so that each
+ * event still reproduces a single stage-1 history and event-level
+ * observables (coincidences, multiplicities, pile-up) are not distorted.
+ *
+ * By default the records of the same stage-1 event are generated together,
+ * otherwise a fixed number of records is consumed at each event.
+ */
+class SLArPhaseSpaceGeneratorAction : public SLArBaseGenerator
+{
+  public:
+    struct PhaseSpaceConfig_t {
+      G4String file_path {};
+      G4String tree_key = "PhaseSpaceTree";
+      G4int    reuse_factor = 1;      //!< Number of passes over the phase-space file
+      G4int    splitting_factor = 1;  //!< Number of events replaying each record
+      G4bool   group_by_event = true; //!< Replay the stage-1 events as a whole
+      G4int    n_particles = 1;       //!< Records per event when not grouping by event
+      G4bool   keep_time = true;      //!< Keep the time of the stage-1 records
+      std::vector<G4int> pdg_filter {};     //!< Replay only these particles (all if empty)
+      std::vector<G4int> scorer_filter {};  //!< Replay only these scorers (all if empty)
+    };
+
+    SLArPhaseSpaceGeneratorAction(const G4String label = "");
+    virtual ~SLArPhaseSpaceGeneratorAction();
+
+    G4String GetGeneratorType() const override {return "phasespace";}
+    EGenerator GetGeneratorEnum() const override {return kPhaseSpace;}
+
+    void Configure(const rapidjson::Value& config) override;
+    void GeneratePrimaries(G4Event* ev) override;
+    G4String WriteConfig() const override;
+
+    inline size_t GetNumberOfRecords() const {return fRecords.size();}
+    inline size_t GetNumberOfGroups() const {return fGroupOffset.size();}
+
+  protected:
+    PhaseSpaceConfig_t fConfig;
+    std::vector<SLArPhaseSpaceRecord_t> fRecords; //!< Selected phase-space records
+    std::vector<size_t> fGroupOffset; //!< First record of each stage-1 event
+    size_t fCursor; //!< Next record (or group) to be replayed
+    G4int  fPass;   //!< Current pass over the phase-space file
+    G4int  fSplit;  //!< Copies of the current record (or group) already generated
+
+    void LoadPhaseSpace();
+    G4bool AcceptRecord(const SLArPhaseSpaceRecord_t& rec) const;
+    G4ParticleDefinition* FindParticle(const G4int pdg) const;
+    void AddPrimaries(G4Event* ev, const SLArPhaseSpaceRecord_t& rec) const;
+};
+
+}
+
+#endif /* end of include guard SLARPHASESPACEGENERATORACTION_HH */
+
@@ -0,0 +1,73 @@
+/**
+ * @author      : Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        : SLArPhaseSpaceRecord.hh
+ * @created     : Monday Oct 19, 2026 18:12:40 CEST
+ */
+
+#ifndef SLARPHASESPACERECORD_HH
+
+#define SLARPHASESPACERECORD_HH
+
+#include "TTree.h"
+
+/**
+ * @brief Flat record of a particle crossing an external background scorer
+ *
+ * Phase-space point (position, direction, kinetic energy, time and weight)
+ * of the particles stopped at the scorer surfaces during the first stage of
+ * an external background simulation. The records are written to a flat
+ * TTree with one branch per field and replayed in the second stage by
+ * the SLArPhaseSpaceGeneratorAction.
+ * Units are the Geant4 internal ones (mm, MeV, ns).
+ */
+struct SLArPhaseSpaceRecord_t {
+  Int_t   fEvNumber = 0;   //!< Stage-1 event number
+  Int_t   fPDGCode = 0;    //!< Particle PDG code
+  Short_t fScorerID = -1;  //!< Scorer index (-1 for the LAr interface)
+  Float_t fX = 0;          //!< Crossing point x
+  Float_t fY = 0;          //!< Crossing point y
+  Float_t fZ = 0;          //!< Crossing point z
+  Float_t fUx = 0;         //!< Momentum direction x
+  Float_t fUy = 0;         //!< Momentum direction y
+  Float_t fUz = 0;         //!< Momentum direction z
+  Float_t fEnergy = 0;     //!< Kinetic energy at the crossing point
+  Float_t fTime = 0;       //!< Global time at the crossing point
+  Float_t fWeight = 1;     //!< Track weight at the crossing point
+
+  inline void Reset() {*this = SLArPhaseSpaceRecord_t();}
+
+  //! Create the phase-space branches on the output tree
+  inline void SetupBranches(TTree* tree) {
+    tree->Branch("iev", &fEvNumber, "iev/I");
+    tree->Branch("pdg", &fPDGCode, "pdg/I");
+    tree->Branch("scorer", &fScorerID, "scorer/S");
+    tree->Branch("x", &fX, "x/F");
+    tree->Branch("y", &fY, "y/F");
+    tree->Branch("z", &fZ, "z/F");
+    tree->Branch("ux", &fUx, "ux/F");
+    tree->Branch("uy", &fUy, "uy/F");
+    tree->Branch("uz", &fUz, "uz/F");
+    tree->Branch("ekin", &fEnergy, "ekin/F");
+    tree->Branch("time", &fTime, "time/F");
+    tree->Branch("weight", &fWeight, "weight/F");
+  }
+
+  //! Attach the record to the branches of an input tree
+  inline void SetBranchAddresses(TTree* tree) {
+    tree->SetBranchAddress("iev", &fEvNumber);
+    tree->SetBranchAddress("pdg", &fPDGCode);
+    tree->SetBranchAddress("scorer", &fScorerID);
+    tree->SetBranchAddress("x", &fX);
+    tree->SetBranchAddress("y", &fY);
+    tree->SetBranchAddress("z", &fZ);
+    tree->SetBranchAddress("ux", &fUx);
+    tree->SetBranchAddress("uy", &fUy);
+    tree->SetBranchAddress("uz", &fUz);
+    tree->SetBranchAddress("ekin", &fEnergy);
+    tree->SetBranchAddress("time", &fTime);
+    tree->SetBranchAddress("weight", &fWeight);
+  }
+};
+
+#endif /* end of include guard SLARPHASESPACERECORD_HH */
+
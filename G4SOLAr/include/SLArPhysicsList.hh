@@ -74,10 +74,15 @@ class SLArPhysicsList: public G4VModularPhysicsList
 
     void SetNbOfPhotonsCerenkov(G4int);
 
+    // Turn on or off the tabulated optical mean free paths
+    void SetTabulatedOptical(G4bool);
+
     void SetVerbose(G4int);
 
   private:
 
+    void ApplyRegionCuts();
+
     G4double fCutForGamma;
     G4double fCutForElectron;
     G4double fCutForPositron;
@@ -90,6 +95,7 @@ class SLArPhysicsList: public G4VModularPhysicsList
 
     G4bool fAbsorptionOn;
     G4bool fCerenkovOn;
+    G4bool fTabulatedOpticalOn;
 
     G4VMPLData::G4PhysConstVectorData* fPhysicsVector;
 
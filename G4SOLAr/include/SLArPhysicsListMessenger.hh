@@ -72,6 +72,7 @@ class SLArPhysicsListMessenger : public G4UImessenger
     G4UIdirectory* fDecayDirectory;
 
     G4UIcmdWithABool* fSetAbsorptionCMD;
+    G4UIcmdWithABool* fTabulateOpticalCMD;
 
     G4UIcmdWithAnInteger* fVerboseCmd;
     G4UIcmdWithAnInteger* fCerenkovCmd;
@@ -50,6 +50,7 @@ namespace gen {
   //class SLArBackgroundGeneratorAction;
   class SLArExternalGeneratorAction;
   class SLArGENIEGeneratorAction;//--JM
+  class SLArPhaseSpaceGeneratorAction;
 
 
   namespace bxdecay0_g4 {
@@ -8,10 +8,100 @@
 
 #define SLARRANDOMEXTRA_HH
 
+#include <vector>
+
 #include "G4ThreeVector.hh"
 #include "G4RandomTools.hh"
 
+#include "rapidjson/document.h"
+
+class TH1;
+
 G4ThreeVector SampleRandomDirection();
 
+//! Sample a direction in the hemisphere around the (unit) normal with uniform solid angle
+G4ThreeVector SampleHemisphereDirection(const G4ThreeVector& normal);
+
+//! Sample a direction around the (unit) normal following the cosine law
+//! (flux of an isotropic field crossing a surface)
+G4ThreeVector SampleCosineDirection(const G4ThreeVector& normal);
+
+//! Build a direction with the given cosine w.r.t. the (unit) axis and uniform azimuth
+G4ThreeVector SampleDirectionAroundAxis(const G4ThreeVector& axis, const G4double cosTheta);
+
+/**
+ * @brief Walker alias table for the O(1) sampling of a discrete distribution
+ *
+ * The table is built once from the (non-normalized) weights of the
+ * distribution, each draw uses a single uniform random number from the
+ * thread-local Geant4 engine.
+ */
+class SLArAliasTable {
+  public:
+    SLArAliasTable() = default;
+    SLArAliasTable(const std::vector<G4double>& weights);
+    ~SLArAliasTable() {}
+
+    void Build(const std::vector<G4double>& weights);
+    size_t SampleIndex() const;
+    inline size_t GetSize() const {return fProb.size();}
+    inline G4bool IsEmpty() const {return fProb.empty();}
+    inline G4double GetTotalWeight() const {return fTotalWeight;}
+
+  private:
+    std::vector<G4double> fProb; //!< Probability of keeping the selected bin
+    std::vector<size_t> fAlias;  //!< Alias of each bin
+    G4double fTotalWeight = 0.0;
+};
+
+/**
+ * @brief Sampler of a tabulated or binned distribution
+ *
+ * The distribution is described either as a histogram (bin edges and
+ * contents, values uniformly distributed within the selected bin) or as a
+ * set of points (x, y) of the pdf with linear interpolation between them.
+ * In both cases the bin (segment) is drawn from a Walker alias table, so
+ * each draw costs O(1) independently of the number of bins, and the
+ * sampler can be shared by the threads once built since it only reads the
+ * tables and uses the thread-local Geant4 random engine.
+ *
+ * The sampler can be configured from json with either a ROOT histogram
+ * ```
+ * {"file" : "spectrum.root", "key" : "hEnergy", "unit" : "MeV", "interpolation" : "histogram"}
+ * ```
+ * or a table
+ * ```
+ * {"x" : [0.0, 1.0, 2.0, 3.0], "y" : [0.0, 1.0, 0.5, 0.0], "unit" : "MeV"}
+ * ```
+ * where "x" are the bin edges (size n+1 for n values of "y") in histogram
+ * mode or the points of the pdf (same size as "y") in linear mode. When
+ * "interpolation" is not given the mode is deduced from the table sizes.
+ */
+class SLArSpectrumSampler {
+  public:
+    enum EInterpolation {kHistogram = 0, kLinear = 1};
+
+    SLArSpectrumSampler() = default;
+    ~SLArSpectrumSampler() {}
+
+    void Build(const std::vector<G4double>& x, const std::vector<G4double>& y,
+        const EInterpolation interpolation = kHistogram);
+    void BuildFromHistogram(const TH1* h, const EInterpolation interpolation = kHistogram);
+    void Configure(const rapidjson::Value& jspec);
+    G4double Sample() const;
+    inline G4bool IsEmpty() const {return fTable.IsEmpty();}
+    inline EInterpolation GetInterpolation() const {return fInterpolation;}
+    inline G4double GetMin() const {return fX.front();}
+    inline G4double GetMax() const {return fX.back();}
+    //! Summary of the sampler configuration for the generator output
+    rapidjson::Value ExportConfig(rapidjson::Document::AllocatorType& allocator) const;
+
+  private:
+    SLArAliasTable fTable;
+    EInterpolation fInterpolation = kHistogram;
+    std::vector<G4double> fX; //!< Bin edges or pdf points
+    std::vector<G4double> fY; //!< pdf values at fX (linear mode only)
+};
+
 #endif /* end of include guard SLARRANDOMEXTRA_HH */
 
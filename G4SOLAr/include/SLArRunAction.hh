@@ -13,6 +13,7 @@
 #include "globals.hh"
 
 class SLArEventAction;
+class SLArOpticalLookup;
 class G4LogicalVolume;
 
 class G4Run;
@@ -34,9 +35,13 @@ class SLArRunAction : public G4UserRunAction
     inline void RegisterExtScorerLV(G4LogicalVolume* lv) {fExtScorerLV.push_back(lv);}
 
   private:
+    //! Grow the pages of the thread-local photon track information allocator
+    void ConfigurePhotonInfoAllocator();
+
     G4String fG4MacroFile; 
     SLArEventAction* fEventAction;
     SLArElectronDrift* fElectronDrift; 
+    SLArOpticalLookup* fOpticalLookup; //!< Lookup installed in the scintillation process (hybrid mode)
 
     std::vector<G4String> fSDName;  
     std::vector<G4LogicalVolume*> fExtScorerLV; 
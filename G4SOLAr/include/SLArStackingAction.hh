@@ -51,6 +51,7 @@ class SLArStackingAction : public G4UserStackingAction
 
   private:
     SLArEventAction* fEventAction;
+    G4double fPhotonSurvivalProb; //!< Survival probability of new optical photons (early PDE culling)
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,82 @@
+/**
+ * @author      : Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        : SLArTrackKillingRules.hh
+ * @created     : Monday Oct 19, 2026 20:14:37 CEST
+ */
+
+#ifndef SLARTRACKKILLINGRULES_HH
+
+#define SLARTRACKKILLINGRULES_HH
+
+#include <map>
+#include <vector>
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include "rapidjson/document.h"
+
+class G4LogicalVolume;
+class G4ParticleDefinition;
+
+/**
+ * @brief Russian roulette and track killing rules for the passive volumes
+ *
+ * Each rule applies to the tracks of the given particles found in the
+ * given logical volumes (a trailing `*` matches a name prefix) with
+ * kinetic energy below a threshold and farther than a minimum distance
+ * from the LAr target. Tracks matching a rule survive with the rule
+ * probability and their weight is divided by it, so that rates stay
+ * unbiased. A null survival probability kills the track.
+ *
+ * Rules are read from a json file:
+ * ```
+ * {"track_killing" : [
+ *   {"volumes" : ["rock_gen_lv", "shotcrete*"], "particles" : ["e-", "e+", "gamma"],
+ *    "energy_threshold" : {"val" : 1, "unit" : "MeV"},
+ *    "min_distance" : {"val" : 1, "unit" : "m"}, "survival" : 0.0}
+ * ]}
+ * ```
+ */
+class SLArTrackKillingRules {
+  public:
+    enum EAction {kKeep = 0, kRoulette = 1, kKill = 2};
+
+    struct Rule_t {
+      std::vector<G4String> fVolumes;
+      std::vector<const G4ParticleDefinition*> fParticles; //!< empty for all particles
+      G4double fEnergyThreshold = DBL_MAX;
+      G4double fMinDistance = 0.0;
+      G4double fSurvivalProb = 0.0;
+      G4int    fNKilled = 0;
+      G4int    fNSurvived = 0;
+
+      G4bool MatchVolume(const G4String& lv_name) const;
+      G4bool MatchParticle(const G4ParticleDefinition* particle) const;
+    };
+
+    SLArTrackKillingRules();
+    ~SLArTrackKillingRules() {}
+
+    //! Load the rules from file, replacing those currently configured
+    void Load(const G4String& file_path);
+    //! Append the given rules to those currently configured
+    void Configure(const rapidjson::Value& jrules);
+    inline G4bool IsActive() const {return !fRules.empty();}
+    inline const std::vector<Rule_t>& GetRules() const {return fRules;}
+    void SetTarget(const G4ThreeVector& center, const G4ThreeVector& half_size);
+    G4double GetDistanceToTarget(const G4ThreeVector& pos) const;
+
+    EAction Apply(const G4ParticleDefinition* particle, const G4LogicalVolume* lv,
+        const G4ThreeVector& pos, const G4double ekin, G4double& weight);
+    void PrintSummary() const;
+
+  private:
+    std::vector<Rule_t> fRules;
+    //! Rules matching each logical volume, filled on first use
+    std::map<const G4LogicalVolume*, std::vector<size_t>> fVolumeRules;
+    G4ThreeVector fTargetCenter;
+    G4ThreeVector fTargetHalfSize;
+};
+
+#endif /* end of include guard SLARTRACKKILLINGRULES_HH */
+
@@ -11,6 +11,7 @@
 #define SLArUSERPHOTONTRACKINFORMATION_HH
 
 #include "G4VUserTrackInformation.hh"
+#include "G4Allocator.hh"
 #include "globals.hh"
 
 
@@ -34,6 +35,9 @@ class SLArUserPhotonTrackInformation : public G4VUserTrackInformation
     SLArUserPhotonTrackInformation();
     virtual ~SLArUserPhotonTrackInformation();
 
+    inline void *operator new(size_t);
+    inline void operator delete(void *aInfo);
+
     //Sets the track status to s (does not check validity of flags)
     void SetTrackStatusFlags(int status){fStatus=status;}
     //Does a smart add of track status flags (disabling old flags that conflict)
@@ -57,6 +61,19 @@ class SLArUserPhotonTrackInformation : public G4VUserTrackInformation
     G4bool fForcedraw;
 };
 
+extern G4ThreadLocal G4Allocator<SLArUserPhotonTrackInformation>* SLArUserPhotonTrackInformationAllocator;
+
+inline void* SLArUserPhotonTrackInformation::operator new(size_t)
+{
+  if(!SLArUserPhotonTrackInformationAllocator)
+    SLArUserPhotonTrackInformationAllocator = new G4Allocator<SLArUserPhotonTrackInformation>;
+  return (void*)SLArUserPhotonTrackInformationAllocator->MallocSingle();
+}
+
+inline void SLArUserPhotonTrackInformation::operator delete(void* aInfo)
+{
+  SLArUserPhotonTrackInformationAllocator->FreeSingle((SLArUserPhotonTrackInformation*)aInfo);
+}
 
 
 
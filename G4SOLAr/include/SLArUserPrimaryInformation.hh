@@ -0,0 +1,37 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArUserPrimaryInformation.hh
+ * @created     Mon Oct 19, 2026 10:12:31 CEST
+ */
+
+#ifndef SLARUSERPRIMARYINFORMATION_HH
+
+#define SLARUSERPRIMARYINFORMATION_HH
+
+#include "G4VUserPrimaryParticleInformation.hh"
+
+/**
+ * @brief Link between a G4PrimaryParticle and its SLArMCPrimaryInfo
+ *
+ * @details Attached to each G4PrimaryParticle in 
+ * SLArBaseGenerator::RegisterPrimaries, it stores the index of the 
+ * corresponding primary in the SLArMCEvent primary list, so that 
+ * the primary track can be associated to its record without any 
+ * kinematic matching. 
+ */
+class SLArUserPrimaryInformation : public G4VUserPrimaryParticleInformation {
+  public: 
+    inline SLArUserPrimaryInformation(const size_t idx) 
+      : G4VUserPrimaryParticleInformation(), fPrimaryIdx(idx) {}
+    inline ~SLArUserPrimaryInformation() override {}
+
+    inline size_t GetPrimaryIdx() const {return fPrimaryIdx;}
+
+    void Print() const override; 
+
+  private:
+    size_t fPrimaryIdx; //!< Index of the primary in SLArMCEvent
+};
+
+#endif /* end of include guard SLARUSERPRIMARYINFORMATION_HH */
+
@@ -0,0 +1,77 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArUserRegionInformation.hh
+ * @created     Monday Oct 19, 2026 21:05:12 CEST
+ */
+
+#ifndef SLARUSERREGIONINFORMATION_HH
+
+#define SLARUSERREGIONINFORMATION_HH
+
+#include <map>
+#include <vector>
+
+#include "G4VUserRegionInformation.hh"
+#include "globals.hh"
+
+#include "rapidjson/document.h"
+
+class G4Region;
+
+/**
+ * @brief Description of a detector region read from the geometry configuration
+ *
+ * Regions are declared in the "Regions" section of the geometry json file
+ * by listing their root logical volumes (daughters inherit the region unless
+ * they are roots of another region) together with the region production
+ * cuts, the maximum step length of charged particles and the optical
+ * physics switch:
+ * ```
+ * "Regions" : [
+ *   {"name" : "CavernRegion", "volumes" : ["cavern_lv"],
+ *    "production_cuts" : {"all" : {"val" : 10, "unit" : "cm"}},
+ *    "optical" : false},
+ *   {"name" : "LArRegion", "volumes" : ["lar_target_lv"],
+ *    "production_cuts" : {"gamma" : {"val" : 0.1, "unit" : "mm"},
+ *                         "e-" : {"val" : 0.1, "unit" : "mm"}},
+ *    "max_step" : {"val" : 1, "unit" : "mm"},
+ *    "optical" : true,
+ *    "optical_fast_sim" : {"handoff_distance" : {"val" : 1, "unit" : "cm"}}}
+ * ]
+ * ```
+ * Particles missing from "production_cuts" (gamma, e-, e+, proton) take the
+ * "all" value if given, or the global production cuts of the physics list
+ * otherwise (see ApplyProductionCuts).
+ * When "optical_fast_sim" is given, the optical photons are transported
+ * through the region bulk by the SLArOpticalFastSimModel and handed back to
+ * the full tracking at "handoff_distance" from the volume surfaces.
+ */
+class SLArUserRegionInformation : public G4VUserRegionInformation {
+  public:
+    SLArUserRegionInformation();
+    inline virtual ~SLArUserRegionInformation() {}
+
+    void Configure(const rapidjson::Value& jregion);
+    G4Region* BuildRegion();
+    void ApplyProductionCuts(G4Region* region) const;
+    virtual void Print() const;
+
+    inline const G4String& GetName() const {return fName;}
+    inline G4bool IsOpticalEnabled() const {return fOpticalEnabled;}
+    inline G4double GetMaxStep() const {return fMaxStep;}
+    inline const std::map<G4String, G4double>& GetProductionCuts() const {return fCuts;}
+    inline G4bool IsOpticalFastSimEnabled() const {return fOpticalFastSim;}
+    inline G4double GetOpticalHandoffDistance() const {return fOpticalHandoffDistance;}
+
+  private:
+    G4String fName;
+    std::vector<G4String> fVolumes; //!< Root logical volumes of the region
+    std::map<G4String, G4double> fCuts; //!< Production cuts by particle name
+    G4double fMaxStep; //!< Maximum step of charged particles (DBL_MAX for none)
+    G4bool fOpticalEnabled; //!< Track the optical photons produced in the region
+    G4bool fOpticalFastSim; //!< Use the fast optical transport in the region
+    G4double fOpticalHandoffDistance; //!< Distance from the surfaces where full tracking resumes
+};
+
+#endif /* end of include guard SLARUSERREGIONINFORMATION_HH */
+
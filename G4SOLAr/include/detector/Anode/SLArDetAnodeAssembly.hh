@@ -9,19 +9,59 @@
 #define SLARDETANODEASSEMBLY_HH
 
 #include <map>
+#include <vector>
 #include "detector/SLArBaseDetModule.hh"
 
+class SLArDetReadoutTile; 
 class SLArDetReadoutTileAssembly; 
 class SLArCfgAnode; 
+class G4MaterialPropertiesTable; 
 
 class SLArDetAnodeAssembly : public SLArBaseDetModule {
   public: 
+    /**
+     * @brief Layout of a flat anode sensor plane
+     *
+     * Pitch and number of the megatiles, tiles and unit cells along the 
+     * anode x and z axes and position of the SiPMs in the unit cell, used 
+     * to find the SiPM hit by a photon from its intercept on the plane, 
+     * and optical properties of the SiPM surface, applied to the photons 
+     * reaching the plane inside a SiPM active area.
+     */
+    struct FlatSensorLayout_t {
+      G4int fNMegaTile[2] = {0, 0}; 
+      G4double fMegaTilePitch[2] = {0., 0.}; 
+      G4int fNTile[2] = {0, 0}; 
+      G4double fTilePitch[2] = {0., 0.}; 
+      G4int fNCell[2] = {0, 0}; 
+      G4double fCellPitch[2] = {0., 0.}; 
+      std::vector<G4ThreeVector> fSiPMPos; //!< SiPM positions in the unit cell
+      G4double fSiPMHalfSize[2] = {0., 0.}; //!< Half size of the SiPM active area
+      const G4MaterialPropertiesTable* fSiPMSurfaceProperties = nullptr; //!< SiPM optical surface properties
+
+      //! Indices of the SiPM found at the given point of the sensor plane
+      struct SensorIdx_t {
+        G4int fRowMegaTile = 0; 
+        G4int fMegaTile = 0; 
+        G4int fRowTile = 0; 
+        G4int fTile = 0; 
+        G4int fRowCell = 0; 
+        G4int fCell = 0; 
+        G4ThreeVector fLocalPos; //!< Position w.r.t. the SiPM center
+      };
+
+      G4bool Locate(const G4ThreeVector& plane_pos, SensorIdx_t& idx) const; 
+      //! Sample the response of the SiPM surface to a photon of the given energy
+      G4bool SampleSiPMDetection(const G4double phEne) const; 
+    };
+
     SLArDetAnodeAssembly(); 
     ~SLArDetAnodeAssembly(); 
 
     SLArCfgAnode BuildAnodeConfig(); 
     void BuildMaterial(G4String materials_db); 
     void BuildAnodeAssembly(SLArDetReadoutTileAssembly*); 
+    void BuildFlatAnodeAssembly(SLArDetReadoutTileAssembly*, SLArDetReadoutTile*); 
 
     inline const G4ThreeVector& GetNormal() {return fNormal;}
     inline const G4ThreeVector& GetPosition() {return fPosition;}
@@ -29,6 +69,9 @@ class SLArDetAnodeAssembly : public SLArBaseDetModule {
     inline SLArBaseDetModule* GetTileAssemblyRow() {return fAnodeRow;}
     inline G4String GetTileAssemblyModel() {return fTileAssemblyModel;}
     inline G4int GetTPCID() {return fTPCID;}
+    inline G4bool IsFlatSensorPlane() const {return fFlatSensorPlane;}
+    inline const FlatSensorLayout_t& GetFlatSensorLayout() const {return fFlatLayout;}
+    inline SLArBaseDetModule* GetSensorPlane() {return fSensorPlane;}
 
     virtual void Init(const rapidjson::Value&) override; 
 
@@ -40,6 +83,10 @@ class SLArDetAnodeAssembly : public SLArBaseDetModule {
     G4ThreeVector fNormal; 
     G4RotationMatrix* fRotation; 
     G4String fTileAssemblyModel;
+    G4bool fFlatSensorPlane; //!< Single sensitive plane instead of nested tiles
+    SLArDetReadoutTileAssembly* fMegaTile; 
+    SLArBaseDetModule* fSensorPlane; 
+    FlatSensorLayout_t fFlatLayout; 
     void SetupAnodePlaneAxes( SLArCfgAnode& );
 }; 
 
@@ -55,6 +55,7 @@ public:
   void SetVisAttributes(const int depth = 0);
 
   SLArBaseDetModule* GetSiPMActive();
+  SLArBaseDetModule* GetSiPM() {return fSiPM;}
   SLArBaseDetModule* GetUnitCell() {return fUnitCell;}
   SLArMaterial* GetSiPMActiveMaterial();
   SLArBaseDetModule* GetChargePixel() {return fChargePix;}
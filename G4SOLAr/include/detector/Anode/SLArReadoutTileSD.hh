@@ -8,13 +8,17 @@
 
 #define SLARREADOUTTILESD_HH
 
+#include <map>
+
 #include "G4VSensitiveDetector.hh"
 
 #include "detector/Anode/SLArReadoutTileHit.hh"
+#include "detector/Anode/SLArDetAnodeAssembly.hh"
 
 class G4Step;
 class G4HCofThisEvent;
 class G4TouchableHistory;
+class G4VTouchable;
 
 class SLArReadoutTileSD : public G4VSensitiveDetector
 {
@@ -26,10 +30,19 @@ public:
     virtual G4bool ProcessHits(G4Step* aStep, G4TouchableHistory* ROhist);
     G4bool ProcessHits_constStep(const G4Step* ,
                                  G4TouchableHistory* );
+    //! Record a photon reaching the SiPM (or flat sensor plane) volume of
+    //! the given touchable, also used by the hybrid optical lookup
+    G4bool ProcessPhotonHit(const G4VTouchable* touchable, 
+        const G4ThreeVector& worldPos, const G4double time, 
+        const G4double phEne, const G4String& procName, const G4int producerID);
+    //! Register the sensor layout of an anode built as a flat sensor plane
+    void RegisterFlatAnode(const G4int anode_id, 
+        const SLArDetAnodeAssembly::FlatSensorLayout_t& layout);
    
 private:
     SLArReadoutTileHitsCollection* fHitsCollection;
     G4int fHCID;
+    std::map<G4int, SLArDetAnodeAssembly::FlatSensorLayout_t> fFlatAnodes;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -47,6 +47,12 @@ class SLArExtHit : public G4VHit
     G4float fVertex[3];
     G4float fOriginVertex[3];
     G4String fCreator;
+    G4int fScorerID;           ///< Index of the scorer volume
+    G4float fEntryEnergy;      ///< Kinetic energy entering the scorer
+    G4float fEntryTime;        ///< Global time entering the scorer
+    G4float fEntryWeight;      ///< Track weight entering the scorer
+    G4float fEntryVertex[3];   ///< Position entering the scorer
+    G4float fEntryDir[3];      ///< Momentum direction entering the scorer
 };
 
 typedef G4THitsCollection<SLArExtHit> SLArExtHitsCollection;
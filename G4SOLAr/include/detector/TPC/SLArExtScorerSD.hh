@@ -18,16 +18,18 @@ class G4TouchableHistory;
 class SLArExtScorerSD : public G4VSensitiveDetector
 {
   public: 
-    SLArExtScorerSD(G4String name); 
+    SLArExtScorerSD(G4String name, const G4int scorer_id = -1); 
     virtual ~SLArExtScorerSD(); 
 
     void Initialize(G4HCofThisEvent*HCE) override;
     G4bool ProcessHits(G4Step* step, G4TouchableHistory* touchHistory) override; 
     G4int GetHitsCollectionID() const {return fHCID;}
+    G4int GetScorerID() const {return fScorerID;}
 
   private: 
     SLArExtHitsCollection* fHitsCollection;
     G4int    fHCID;
+    G4int    fScorerID; //!< Scorer index in the phase-space records
 };
 
 #endif /* end of include guard SLAREXTSCORERSD_HH */
@@ -8,13 +8,35 @@
 
 #define SLAREVENTANODE_HH
 
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
 #include "config/SLArCfgAnode.hh"
 #include "config/SLArCfgAssembly.hh"
 #include "config/SLArCfgMegaTile.hh"
 #include "event/SLArEventMegatile.hh"
 
+class SLArPixelFrontEnd; 
+
 class SLArEventAnode : public TNamed {
   public:
+    //! Charge collected by a single track in a staged pixel tick
+    struct ChargeContributor_t {
+      Int_t fTrkID; 
+      Int_t fPrimaryTrkID; 
+      UShort_t fN; 
+    };
+
+    //! Per-pixel tick accumulator used by the online zero suppression
+    struct ChargeStagingEntry_t {
+      UShort_t fNhits = 0; 
+      std::vector<ChargeContributor_t> fContributors; 
+    };
+
+    typedef std::unordered_map<ULong64_t, ChargeStagingEntry_t> ChargeStagingBuffer_t; 
+    typedef std::function<void(const SLArEventChargeHit&, const UShort_t, SLArEventBacktrackerVector&)> ChargeBacktrackerEval_t; 
+
     SLArEventAnode(); 
     SLArEventAnode(const SLArCfgAnode& cfg);
     SLArEventAnode(const SLArEventAnode&);
@@ -42,6 +64,15 @@ class SLArEventAnode : public TNamed {
 
     Int_t ApplyZeroSuppression(); 
 
+    inline void SetOnlineZeroSuppression(const bool online) {fOnlineZeroSuppression = online;}
+    inline bool IsOnlineZeroSuppression() const {return fOnlineZeroSuppression;}
+    inline bool IsStagingChargeHits() const {return fOnlineZeroSuppression && fZeroSuppressionThreshold > 0;}
+    inline size_t GetNStagedTicks() const {return fChargeStaging.size();}
+    void StageChargeHit(const SLArCfgAnode::SLArPixIdx& pixId, const SLArEventChargeHit& hit); 
+    Int_t FlushStagedChargeHits(ChargeBacktrackerEval_t bkt_eval = nullptr); 
+    //! Run the pixel front-end on the staged (not zero-suppressed) ticks
+    Int_t ProcessStagedChargeHits(SLArPixelFrontEnd& frontend); 
+
     //bool SortHits(); 
 
     inline void SetID(const int anode_id) {fID = anode_id;}
@@ -54,10 +85,15 @@ class SLArEventAnode : public TNamed {
     UShort_t fLightBacktrackerRecordSize;
     UShort_t fChargeBacktrackerRecordSize;
     UShort_t fZeroSuppressionThreshold;
+    bool fOnlineZeroSuppression; 
     std::map<int, SLArEventMegatile> fMegaTilesMap;
+    ChargeStagingBuffer_t fChargeStaging; //! Online zero-suppression scratch buffer
+
+    static ULong64_t PackStagingKey(const SLArCfgAnode::SLArPixIdx& pixId, const UShort_t tick); 
+    static void UnpackStagingKey(const ULong64_t key, SLArCfgAnode::SLArPixIdx& pixId, UShort_t& tick); 
 
   public:
-    ClassDef(SLArEventAnode, 2)
+    ClassDef(SLArEventAnode, 3)
 };
 
 #endif /* end of include guard SLArEventAnode_HH */
@@ -10,31 +10,68 @@
 
 #include <vector>
 #include <map>
-#include "TObject.h"
+#include <memory>
+#include "Rtypes.h"
 
 typedef std::map<Int_t, UShort_t> BacktrackerCounter_t;
 
-class SLArEventBacktrackerRecord : public TObject {
-  public: 
-    SLArEventBacktrackerRecord(); 
+//! Single (key, counts) entry of a backtracker record
+struct BacktrackerContributor_t {
+  Int_t fKey;
+  UShort_t fCount;
+};
+
+typedef std::vector<BacktrackerContributor_t> BacktrackerOverflow_t;
+
+/**
+ * @brief Backtracker counter with inline storage
+ *
+ * The first kInlineSize contributors are stored inline, which covers
+ * the vast majority of the pixel/SiPM ticks. Additional contributors go
+ * to an overflow buffer taken from a thread-local pool and returned to
+ * it when the record is reset at the end of the event.
+ */
+class SLArEventBacktrackerRecord {
+  public:
+    static constexpr UShort_t kInlineSize = 2;
+
+    SLArEventBacktrackerRecord();
+    SLArEventBacktrackerRecord(const SLArEventBacktrackerRecord&);
+    SLArEventBacktrackerRecord(SLArEventBacktrackerRecord&&) noexcept;
+    SLArEventBacktrackerRecord& operator=(const SLArEventBacktrackerRecord&);
+    SLArEventBacktrackerRecord& operator=(SLArEventBacktrackerRecord&&) noexcept;
+    ~SLArEventBacktrackerRecord();
+
     void Reset();
-    inline BacktrackerCounter_t& GetCounter() {return fCounter;}
-    inline const BacktrackerCounter_t& GetConstCounter() const {return fCounter;}
-    UShort_t  UpdateCounter(const int key, const UShort_t val = 1); 
+    inline UShort_t GetSize() const {return fSize;}
+    inline bool IsEmpty() const {return fSize == 0;}
+    Int_t GetKey(const UShort_t i) const;
+    UShort_t GetCount(const UShort_t i) const;
+    BacktrackerCounter_t GetConstCounter() const;
+    UShort_t  UpdateCounter(const int key, const UShort_t val = 1);
 
   protected:
-    BacktrackerCounter_t fCounter; 
+    UShort_t fSize; //!< Number of contributors
+    Int_t fKey[kInlineSize]; //!< Inline contributor keys
+    UShort_t fCount[kInlineSize]; //!< Inline contributor counts
+    std::unique_ptr<BacktrackerOverflow_t> fOverflow; //! Pooled overflow contributors
 
-  public: 
-    ClassDef(SLArEventBacktrackerRecord, 1)
+  public:
+    ClassDefNV(SLArEventBacktrackerRecord, 2)
 };
 
 
-class SLArEventBacktrackerVector : public TObject {
-  public: 
+/**
+ * @brief Collection of backtracker records for a single hit tick
+ *
+ * On disk the records are stored in a columnar layout (record sizes,
+ * then all keys, then all counts) by a custom streamer.
+ */
+class SLArEventBacktrackerVector {
+  public:
     SLArEventBacktrackerVector();
     SLArEventBacktrackerVector(const UShort_t size);
-    ~SLArEventBacktrackerVector(); 
+    ~SLArEventBacktrackerVector();
 
     inline std::vector<SLArEventBacktrackerRecord>& GetRecords() {return fRecords;}
     inline const std::vector<SLArEventBacktrackerRecord>& GetConstRecords() const {return fRecords;}
@@ -42,13 +79,13 @@ class SLArEventBacktrackerVector : public TObject {
     void InitRecords(const UShort_t size);
     bool IsEmpty() const;
 
-    void Reset(); 
+    void Reset();
 
-  protected: 
+  protected:
     std::vector<SLArEventBacktrackerRecord> fRecords;
 
-  public: 
-    ClassDef(SLArEventBacktrackerVector, 1)
+  public:
+    ClassDefNV(SLArEventBacktrackerVector, 2)
 };
 
 
@@ -10,11 +10,19 @@
 
 #include <iostream>
 #include <map>
+#include <vector>
 #include "TNamed.h"
 
 #include "event/SLArEventHitsCollection.hh"
 #include "event/SLArEventChargeHit.hh"
 
+//! Digitized pixel readout packet
+struct SLArPixelPacket_t {
+  UShort_t fTick = 0;  //!< Trigger time [clock ticks]
+  UShort_t fADC = 0;   //!< Digitized charge [ADC counts]
+  UInt_t   fQTrue = 0; //!< Integrated charge before digitization [electrons]
+};
+
 class SLArEventChargePixel : public SLArEventHitsCollection<SLArEventChargeHit> {
   public: 
     SLArEventChargePixel(); 
@@ -22,10 +30,17 @@ class SLArEventChargePixel : public SLArEventHitsCollection<SLArEventChargeHit>
     SLArEventChargePixel(const SLArEventChargePixel&); 
     ~SLArEventChargePixel() {}
 
+    static constexpr UShort_t kDefaultClockUnit = 50; //!< Default pixel clock unit [ns]
+
+    inline std::vector<SLArPixelPacket_t>& GetPackets() {return fPackets;}
+    inline const std::vector<SLArPixelPacket_t>& GetConstPackets() const {return fPackets;}
+    int ResetHits() override; 
+
   private: 
+    std::vector<SLArPixelPacket_t> fPackets; //!< Front-end emulator output
 
   public: 
-    ClassDef(SLArEventChargePixel, 1)
+    ClassDef(SLArEventChargePixel, 2)
 }; 
 
 
@@ -47,6 +47,7 @@ class SLArEventHitsCollection : public TNamed {
     virtual void PrintHits() const; 
 
     virtual int RegisterHit(const T hit); 
+    int RegisterHits(const UShort_t clock_tick, const UShort_t n); 
     virtual int ResetHits(); 
 
     //virtual bool SortHits(); 
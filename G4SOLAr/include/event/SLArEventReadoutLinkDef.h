@@ -14,17 +14,26 @@
 #pragma link C++ class SLArEventChargeHit++; 
 #pragma link C++ class std::vector<SLArEventChargeHit>++; 
 #pragma link C++ class std::vector<SLArEventPhotonHit>++;
-#pragma link C++ class SLArEventBacktrackerRecord++;
+#pragma link C++ class SLArEventBacktrackerRecord-;
 #pragma link C++ class std::vector<SLArEventBacktrackerRecord>++;
 #pragma link C++ class std::map<Int_t, UShort_t>++;
 #pragma link C++ typedef BacktrackerCounter_t++;
-#pragma link C++ class SLArEventBacktrackerVector++;
+#pragma link C++ class SLArEventBacktrackerVector-;
+// v1 records derived from TObject and wrapped a std::map. In the split event
+// tree they were streamed member-wise, bypassing the custom streamers: the
+// TObject base is skipped and the map is converted by the rule below. Use
+// SOLArAnalysis' check_backtracker_io on a v1 file to check this path.
+#pragma read sourceClass="SLArEventBacktrackerRecord" version="[1]" \
+  source="std::map<Int_t, UShort_t> fCounter" target="fSize" \
+  code="{ for (const auto& c : onfile.fCounter) newObj->UpdateCounter(c.first, c.second); }"
 #pragma link C++ class std::map<UShort_t, SLArEventBacktrackerVector>++;
 #pragma link C++ typedef BacktrackerVectorCollection_t++;
 #pragma link C++ class std::map<UShort_t, UShort_t>++;
 #pragma link C++ typedef HitsCollection_t++;
 #pragma link C++ class SLArEventHitsCollection<SLArEventPhotonHit>++;
 #pragma link C++ class SLArEventHitsCollection<SLArEventChargeHit>++;
+#pragma link C++ struct SLArPixelPacket_t+;
+#pragma link C++ class std::vector<SLArPixelPacket_t>+;
 #pragma link C++ class SLArEventChargePixel++; 
 #pragma link C++ class std::map<int, SLArEventChargePixel>++; 
 #pragma link C++ class SLArEventTile++;
@@ -34,6 +34,7 @@ class SLArEventTile :  public SLArEventHitsCollection<SLArEventPhotonHit>
     inline UShort_t GetChargeBacktrackerRecordSize() const {return fChargeBacktrackerRecordSize;}
     void PrintHits() const; 
     SLArEventChargePixel& RegisterChargeHit(const int&, const SLArEventChargeHit& ); 
+    SLArEventChargePixel& GetOrCreateChargePixel(const int&); 
     int ResetHits(); 
     int SoftResetHits();
 
@@ -64,17 +64,30 @@ class SLArMCEvent : public TObject
     inline std::vector<SLArMCPrimaryInfo>& GetPrimaries() {return fSLArPrimary ;}
     inline SLArMCPrimaryInfo& GetPrimary(int ip) {return fSLArPrimary.at(ip);}
     inline SLArMCPrimaryInfo& GetPrimaryByTrkID(int id) {
-      for (auto &p : fSLArPrimary) {
-        if (p.GetTrackID() == id) return p;
-      }
+      SLArMCPrimaryInfo* p = FindPrimaryByTrkID(id); 
+      if (p) return *p;
 
       printf("SLArMCEvent::GetPrimaryByTrkID WARNING: Unable to find primary wit track id %i returning the first primary in the list\n", 
           id);
       return fSLArPrimary.front();
     }
+    //! Return the index of the primary with the given track ID (-1 if not found)
+    inline int GetPrimaryIdxByTrkID(int id) const {
+      if (id < 0 || static_cast<size_t>(id) >= fPrimaryIdxByTrkID.size()) return -1;
+      return fPrimaryIdxByTrkID[id]; 
+    }
+    //! Return a pointer to the primary with the given track ID (nullptr if not found)
+    inline SLArMCPrimaryInfo* FindPrimaryByTrkID(int id) {
+      if (fPrimaryIdxByTrkID.empty() && !fSLArPrimary.empty()) BuildPrimaryIndex(); 
+      const int idx = GetPrimaryIdxByTrkID(id); 
+      return (idx < 0) ? nullptr : &fSLArPrimary[idx]; 
+    }
     bool  CheckIfPrimary(int trkId) const;
 
     size_t RegisterPrimary(SLArMCPrimaryInfo& p);
+    void  SetPrimaryTrackID(const size_t idx, const int trkId); 
+    //! Rebuild the track ID → primary index (e.g. for events read from file)
+    void  BuildPrimaryIndex(); 
     void  Reset();
 
   private:
@@ -82,6 +95,8 @@ class SLArMCEvent : public TObject
     std::array<double, 3>  fDirection; //!< Event Direction 
     //! Event's primary particles (and associated secondaries)
     std::vector<SLArMCPrimaryInfo> fSLArPrimary;  
+    //! Index of the primary in fSLArPrimary indexed by track ID (transient)
+    std::vector<int> fPrimaryIdxByTrkID; //!
     //! Event data structure of the readout tile system
     std::map<int, SLArEventAnode> fEvAnode;
     //! Event data structure of the super-cell system
@@ -27,6 +27,7 @@ class SLArMCPrimaryInfo : public TNamed
     inline void SetTrackID(const int& id) {fTrkID = id;}
     inline void SetGeneratorLabel(const std::string gen_label) {fGeneratorLabel = gen_label;}
     inline void SetTime(const double& time) {fTime = time;}
+    inline void SetWeight(const double& weight) {fWeight = weight;}
     inline void SetTotalEdep(const float& edep) {fTotalEdep = edep;}
     inline void SetTotalLArEdep(const float& edep) {fTotalLArEdep = edep;}
     inline void SetTotalScintPhotons(const int& nph) {fTotalScintPhotons = nph;}
@@ -40,6 +41,7 @@ class SLArMCPrimaryInfo : public TNamed
     inline TString GetGeneratorLabel() {return fGeneratorLabel;}
     inline TString GetGeneratorLabel() const {return fGeneratorLabel;}
     inline double GetTime() const {return fTime;}
+    inline double GetWeight() const {return fWeight;}
     inline double GetTotalEdep() const {return fTotalEdep;}
     inline double GetTotalLArEdep() const {return fTotalLArEdep;}
     inline int GetID() const {return fID;}
@@ -68,6 +70,7 @@ class SLArMCPrimaryInfo : public TNamed
     TString fGeneratorLabel;
     Double_t fEnergy;
     Double_t fTime;
+    Double_t fWeight; // Primary weight (biased or replayed primaries)
     Double_t fTotalEdep;
     Int_t fTotalScintPhotons;
     Int_t fTotalCerenkovPhotons;
@@ -77,7 +80,7 @@ class SLArMCPrimaryInfo : public TNamed
     std::vector<std::unique_ptr<SLArEventTrajectory>> fTrajectories;
   
   public:
-    ClassDef(SLArMCPrimaryInfo, 3);
+    ClassDef(SLArMCPrimaryInfo, 4);
 };
 
 #endif /* end of include guard SLArMCTRACKINFO_HH */
@@ -0,0 +1,76 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArPixelFrontEnd.hh
+ * @created     Monday Oct 19, 2026 15:02:11 CEST
+ */
+
+#ifndef SLARPIXELFRONTEND_HH
+
+#define SLARPIXELFRONTEND_HH
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "TRandom3.h"
+
+#include "event/SLArEventChargePixel.hh"
+
+/**
+ * @brief Streaming emulator of a self-triggering pixel front-end
+ *
+ * Simplified LArPix-like channel: the charge-sensitive amplifier integrates
+ * the collected electrons until the discriminator (with gaussian noise)
+ * fires. The charge is then integrated for a fixed hold time, digitized by
+ * the ADC and the channel is reset, staying dead for a given number of
+ * clock ticks. Charge reaching the channel during the reset is lost.
+ * A periodic trigger mode, digitizing the integrated charge at fixed
+ * intervals, is also available.
+ *
+ * The tick stream of a channel is processed in one linear pass. Noise is
+ * sampled only on ticks carrying charge, so pure noise triggers are not
+ * emulated.
+ */
+class SLArPixelFrontEnd {
+  public:
+    enum ETriggerMode {kSelfTrigger = 0, kPeriodicTrigger = 1};
+    enum EChannelState {kIdle = 0, kIntegrating = 1, kDead = 2};
+
+    struct Config_t {
+      ETriggerMode fTriggerMode = kSelfTrigger;
+      Float_t  fThreshold = 3800.0; //!< Discriminator threshold [e-]
+      Float_t  fNoiseRMS = 900.0;   //!< Equivalent noise charge [e-]
+      Float_t  fPedestal = 20.0;    //!< ADC pedestal [ADC counts]
+      Float_t  fGain = 250.0;       //!< ADC gain [e-/ADC count]
+      UShort_t fADCBits = 8;        //!< ADC resolution
+      UShort_t fHoldTicks = 20;     //!< Integration time after trigger [clock ticks]
+      UShort_t fDeadTicks = 4;      //!< Digitization and reset dead time [clock ticks]
+      UShort_t fPeriodTicks = 100;  //!< Periodic trigger interval [clock ticks]
+
+      void Print() const;
+    };
+
+    SLArPixelFrontEnd();
+    SLArPixelFrontEnd(const Config_t& cfg);
+    ~SLArPixelFrontEnd() {}
+
+    inline Config_t& GetConfig() {return fConfig;}
+    inline const Config_t& GetConfig() const {return fConfig;}
+    inline void SetConfig(const Config_t& cfg) {fConfig = cfg;}
+    void SetParameter(const std::string& name, const double val);
+    inline void SetSeed(const ULong_t seed) {fRandom.SetSeed(seed);}
+
+    size_t Process(const HitsCollection_t& hits, std::vector<SLArPixelPacket_t>& packets);
+    size_t Process(const std::pair<UShort_t, UShort_t>* ticks, const size_t n,
+        std::vector<SLArPixelPacket_t>& packets);
+    Float_t ToElectrons(const UShort_t adc) const;
+
+  private:
+    Config_t fConfig;
+    TRandom3 fRandom;
+    std::vector<std::pair<UShort_t, UShort_t>> fBuffer; //!< Contiguous copy of the tick stream
+
+    UShort_t Digitize(const Float_t q);
+};
+
+#endif /* end of include guard SLARPIXELFRONTEND_HH */
+
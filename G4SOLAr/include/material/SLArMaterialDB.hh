@@ -0,0 +1,60 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArMaterialDB.hh
+ * @created     Tuesday Oct 20, 2026 10:31:52 CEST
+ */
+
+#ifndef SLARMATERIALDB_HH
+
+#define SLARMATERIALDB_HH
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "G4String.hh"
+#include "G4OpticalSurface.hh"
+#include "rapidjson/document.h"
+
+/**
+ * @brief Indexed, in-memory copy of the material database
+ *
+ * The material database file is parsed once and each material description
+ * is indexed by name, so that building a new material does not require to
+ * read the file again. The service also keeps the optical surfaces created
+ * from the "SurfaceProperties" of the materials, so that every detector
+ * module using a material already present in the G4MaterialTable shares
+ * the same G4OpticalSurface.
+ *
+ * The geometry is built by the master thread only, the instance is
+ * therefore shared.
+ */
+class SLArMaterialDB {
+  public:
+    static SLArMaterialDB* Instance();
+
+    //! Parse and index the given database (no-op if already loaded)
+    void Load(const G4String& db_file);
+    //! Description of the material with the given name (nullptr if missing)
+    const rapidjson::Value* FindMaterial(const G4String& mat_id) const;
+    inline const G4String& GetDBFile() const {return fDBFile;}
+
+    void RegisterSurface(const G4String& mat_name, G4OpticalSurface* surface);
+    G4OpticalSurface* FindSurface(const G4String& mat_name) const;
+
+  private:
+    SLArMaterialDB() = default;
+    ~SLArMaterialDB() {}
+
+    static SLArMaterialDB* fgInstance;
+
+    G4String fDBFile;
+    rapidjson::Document fDocument;
+    //! Material descriptions in file order
+    std::vector<const rapidjson::Value*> fMaterials;
+    std::unordered_map<std::string, const rapidjson::Value*> fIndex;
+    std::map<G4String, G4OpticalSurface*> fSurfaces;
+};
+
+#endif /* end of include guard SLARMATERIALDB_HH */
+
@@ -0,0 +1,38 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArOpAbsorption.hh
+ * @created     Tuesday Oct 20, 2026 09:41:26 CEST
+ */
+
+#ifndef SLAROPABSORPTION_HH
+
+#define SLAROPABSORPTION_HH
+
+#include "G4OpAbsorption.hh"
+#include "physics/SLArOpticalPropertyTable.hh"
+
+/**
+ * @brief Bulk absorption of optical photons with tabulated absorption lengths
+ *
+ * Same as G4OpAbsorption, but the ABSLENGTH of each material is tabulated
+ * at BuildPhysicsTable time (see SLArOpticalPropertyTable) and the mean
+ * free path is a table read instead of a property vector interpolation.
+ */
+class SLArOpAbsorption : public G4OpAbsorption {
+  public:
+    SLArOpAbsorption(const G4String& processName = "OpAbsorption",
+        G4ProcessType type = fOptical);
+    virtual ~SLArOpAbsorption() {}
+
+    virtual void BuildPhysicsTable(const G4ParticleDefinition& particle) override;
+    virtual G4double GetMeanFreePath(const G4Track& track,
+        G4double previousStepSize, G4ForceCondition* condition) override;
+
+    inline const SLArOpticalPropertyTable& GetTable() const {return fTable;}
+
+  private:
+    SLArOpticalPropertyTable fTable;
+};
+
+#endif /* end of include guard SLAROPABSORPTION_HH */
+
@@ -0,0 +1,38 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArOpRayleigh.hh
+ * @created     Tuesday Oct 20, 2026 09:44:02 CEST
+ */
+
+#ifndef SLAROPRAYLEIGH_HH
+
+#define SLAROPRAYLEIGH_HH
+
+#include "G4OpRayleigh.hh"
+#include "physics/SLArOpticalPropertyTable.hh"
+
+/**
+ * @brief Rayleigh scattering of optical photons with tabulated mean free paths
+ *
+ * Same as G4OpRayleigh, but the mean free paths of the process physics
+ * table are tabulated once on uniform energy grids (see
+ * SLArOpticalPropertyTable), so that each step only needs a table read.
+ */
+class SLArOpRayleigh : public G4OpRayleigh {
+  public:
+    SLArOpRayleigh(const G4String& processName = "OpRayleigh",
+        G4ProcessType type = fOptical);
+    virtual ~SLArOpRayleigh() {}
+
+    virtual void BuildPhysicsTable(const G4ParticleDefinition& particle) override;
+    virtual G4double GetMeanFreePath(const G4Track& track,
+        G4double previousStepSize, G4ForceCondition* condition) override;
+
+    inline const SLArOpticalPropertyTable& GetTable() const {return fTable;}
+
+  private:
+    SLArOpticalPropertyTable fTable;
+};
+
+#endif /* end of include guard SLAROPRAYLEIGH_HH */
+
@@ -0,0 +1,83 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArOpticalFastSimModel.hh
+ * @created     Monday Oct 19, 2026 22:41:08 CEST
+ */
+
+#ifndef SLAROPTICALFASTSIMMODEL_HH
+
+#define SLAROPTICALFASTSIMMODEL_HH
+
+#include <unordered_map>
+#include <vector>
+
+#include "G4VFastSimulationModel.hh"
+#include "G4AffineTransform.hh"
+#include "G4MaterialPropertyVector.hh"
+
+class G4LogicalVolume;
+class G4VSolid;
+class SLArOpticalPropertyTable;
+
+/**
+ * @brief Fast transport of the optical photons through the LAr bulk
+ *
+ * The model is attached to a region (see SLArUserRegionInformation) and
+ * applies to the optical photons crossing a homogeneous volume of the region
+ * (typically the TPC LAr volume). Instead of stepping the photon through
+ * each Rayleigh scattering, the model samples analytically the absorption
+ * and Rayleigh path lengths from the material property tables and computes
+ * the distance to the volume walls and to the daughter volumes (anode and
+ * SuperCell arrays) with direct ray-solid intersections. The photon is
+ * either absorbed in the bulk or moved up to the handoff distance from the
+ * first surface on its path, where the full Geant4 tracking takes over to
+ * handle the optical boundary processes and the detection.
+ *
+ * Volumes with replicated or parameterised daughters are left to the full
+ * tracking.
+ */
+class SLArOpticalFastSimModel : public G4VFastSimulationModel {
+  public:
+    SLArOpticalFastSimModel(const G4String& name, G4Region* region);
+    virtual ~SLArOpticalFastSimModel() {}
+
+    virtual G4bool IsApplicable(const G4ParticleDefinition& particle);
+    virtual G4bool ModelTrigger(const G4FastTrack& fastTrack);
+    virtual void DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep);
+
+    inline void SetHandoffDistance(const G4double d) {fHandoffDistance = d;}
+    inline G4double GetHandoffDistance() const {return fHandoffDistance;}
+
+  private:
+    struct Daughter_t {
+      G4AffineTransform fTransform; //!< mother to daughter frame
+      const G4VSolid* fSolid = nullptr;
+    };
+
+    struct VolumeCache_t {
+      G4bool fSupported = false;
+      const G4VSolid* fSolid = nullptr;
+      std::vector<Daughter_t> fDaughters;
+      G4MaterialPropertyVector* fAbsLength = nullptr;
+      G4MaterialPropertyVector* fRayleigh = nullptr;
+      size_t fMaterialIdx = 0;
+    };
+
+    const VolumeCache_t& GetVolumeCache(const G4LogicalVolume* lv);
+    void CheckOpticalProcesses();
+    G4double DistanceToSurface(const VolumeCache_t& vol,
+        const G4ThreeVector& pos, const G4ThreeVector& dir) const;
+    void RayleighScatter(G4ThreeVector& dir, G4ThreeVector& pol) const;
+
+    G4double fHandoffDistance; //!< Distance from surfaces where full tracking resumes
+    G4bool fProcessesChecked;
+    G4bool fAbsorptionOn;
+    G4bool fRayleighOn;
+    //! Tabulated mean free paths of the optical processes (if available)
+    const SLArOpticalPropertyTable* fAbsTable;
+    const SLArOpticalPropertyTable* fRayleighTable;
+    std::unordered_map<const G4LogicalVolume*, VolumeCache_t> fVolumeCache;
+};
+
+#endif /* end of include guard SLAROPTICALFASTSIMMODEL_HH */
+
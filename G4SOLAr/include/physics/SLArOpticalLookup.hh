@@ -0,0 +1,128 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArOpticalLookup.hh
+ * @created     Wednesday Oct 21, 2026 14:20:51 CEST
+ */
+
+#ifndef SLAROPTICALLOOKUP_HH
+
+#define SLAROPTICALLOOKUP_HH
+
+#include <map>
+#include <vector>
+
+#include "physics/SLArVOpticalLookup.hh"
+#include "config/SLArCfgAnode.hh"
+#include "config/SLArCfgBaseSystem.hh"
+
+#include "G4MaterialPropertyVector.hh"
+
+class G4Material;
+class G4Navigator;
+class G4TouchableHistory;
+class G4VPhysicalVolume;
+class SLArReadoutTileSD;
+
+/**
+ * @brief Geometric optical lookup for the hybrid optical mode
+ *
+ * The optical detectors are described as rectangles taken from the
+ * readout configuration: the SuperCells and the anode megatiles. For each
+ * emission and detector the number of candidate photons is sampled from
+ * the solid angle subtended by the detector face at the emission point;
+ * each candidate photon is then given an energy from the emission spectrum
+ * and survives the absorption along the direct path and the sensor
+ * detection efficiency. The hit time adds the emission time, the
+ * scintillation decay and the direct-path propagation time at the LAr
+ * group velocity.
+ *
+ * SuperCell candidates are recorded directly as SLArSuperCellHit. Anode
+ * candidates are traced along the direct path with a dedicated navigator
+ * to the first volume that is not made of LAr: a hit is recorded through
+ * SLArReadoutTileSD only when this is a SiPM active volume (or a SiPM area
+ * of a flat sensor plane), so that the tile layout and the shadowing by
+ * the PCB and the charge pixels are the same as in the full tracking.
+ *
+ * Rayleigh scattering is not modelled, which is the reason why the
+ * photons produced close to the detectors, where the direct light
+ * dominates the time profile, are still fully tracked. Far from the
+ * detectors the scattered light is simply missing: both the light yield
+ * and the arrival-time profile are biased (the late, scattered component
+ * is lost), so the hybrid mode must be validated against the full
+ * tracking for the geometry and near-field distance in use before being
+ * used for physics studies.
+ */
+class SLArOpticalLookup : public SLArVOpticalLookup {
+  public:
+    //! Rectangular optical detector
+    struct Detector_t {
+      G4ThreeVector fCenter;
+      G4ThreeVector fNormal; //!< Pointing towards the LAr volume
+      G4ThreeVector fAxis0;
+      G4ThreeVector fAxis1;
+      G4double fHalfSize0 = 0.0;
+      G4double fHalfSize1 = 0.0;
+      G4int fCellNo = 0;
+      G4int fRowNo = 0;
+      G4int fArrayNo = 0;
+      G4bool fTwoSided = false; //!< Seen from both sides (anode megatiles)
+    };
+
+    SLArOpticalLookup(const G4Material* lar);
+    ~SLArOpticalLookup();
+
+    //! Register the SuperCells of the photon detection system
+    void AddSuperCells(SLArCfgSystemSuperCell& pdsCfg);
+    //! Register the megatiles of the anode readout planes
+    void AddAnodes(std::map<int, SLArCfgAnode>& anodeCfg);
+    //! Set the SuperCell detection efficiency (scaled by the given factor)
+    inline void SetDetectionEfficiency(const G4MaterialPropertyVector* pde,
+        const G4double scale = 1.0) {fEfficiency = pde; fEfficiencyScale = scale;}
+    //! Set the anode SiPM detection efficiency (scaled by the given factor)
+    inline void SetTileDetectionEfficiency(const G4MaterialPropertyVector* pde,
+        const G4double scale = 1.0) {fTileEfficiency = pde; fTileEfficiencyScale = scale;}
+
+    inline size_t GetNumberOfSuperCells() const {return fSuperCell.size();}
+    inline size_t GetNumberOfMegaTiles() const {return fMegaTile.size();}
+
+    G4double GetDistanceToDetectors(const G4ThreeVector& pos) const override;
+    G4bool RegisterPhotons(const G4Track& parent, const G4int n_photons) override;
+    void ProcessEmission(const Emission_t& emission) override;
+
+  private:
+    //! Photon emitted towards a detector that survived the direct path
+    struct Candidate_t {
+      G4double fEnergy = 0.0;
+      G4ThreeVector fOrigin;
+      G4ThreeVector fTarget;
+      G4double fTime = 0.0; //!< Emission time
+    };
+
+    static G4double DistanceToDetector(const Detector_t& det, const G4ThreeVector& pos);
+    static G4double SolidAngle(const Detector_t& det, const G4ThreeVector& pos);
+
+    G4bool SampleCandidate(const Emission_t& emission, const Detector_t& det,
+        const G4MaterialPropertyVector* pde, const G4double pde_scale,
+        Candidate_t& candidate) const;
+    G4double GetArrivalTime(const Candidate_t& candidate, const G4double r) const;
+    //! Find the first non-LAr volume along the direct path to the anode
+    const G4VPhysicalVolume* TraceToAnode(const Candidate_t& candidate,
+        G4ThreeVector& hitPos, G4TouchableHistory*& touchable);
+
+    std::vector<Detector_t> fSuperCell;
+    std::vector<Detector_t> fMegaTile;
+
+    G4String fLArName;
+    const G4MaterialPropertyVector* fAbsLength; //!< LAr absorption length
+    const G4MaterialPropertyVector* fGroupVel;  //!< LAr group velocity
+    const G4MaterialPropertyVector* fEfficiency;
+    G4double fEfficiencyScale;
+    const G4MaterialPropertyVector* fTileEfficiency;
+    G4double fTileEfficiencyScale;
+    G4int fHCID; //!< SuperCell hits collection ID
+    SLArReadoutTileSD* fTileSD;
+    G4Navigator* fNavigator; //!< Navigator for the direct paths to the anodes
+};
+
+#endif /* end of include guard SLAROPTICALLOOKUP_HH */
+
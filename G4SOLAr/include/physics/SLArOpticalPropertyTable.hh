@@ -0,0 +1,97 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArOpticalPropertyTable.hh
+ * @created     Tuesday Oct 20, 2026 09:12:47 CEST
+ */
+
+#ifndef SLAROPTICALPROPERTYTABLE_HH
+
+#define SLAROPTICALPROPERTYTABLE_HH
+
+#include <vector>
+
+#include "globals.hh"
+#include "G4MaterialPropertiesIndex.hh"
+#include "G4MaterialPropertyVector.hh"
+
+class G4PhysicsTable;
+
+/**
+ * @brief Optical property tabulated on uniform energy grids for each material
+ *
+ * The property vector of each material (e.g. ABSLENGTH, RAYLEIGH, RINDEX) is
+ * sampled once on a uniform energy grid spanning the vector range, so that
+ * a lookup only requires a direct index computation and a linear
+ * interpolation between two adjacent nodes. For scintillating materials a
+ * second, finer grid covers the emission band defined by the
+ * SCINTILLATIONCOMPONENT spectra: since almost all the optical photons of
+ * a LAr run are produced in this narrow band, the lookup takes this fast
+ * path first. Outside the vector range the values are clamped to the edges
+ * as done by G4PhysicsVector::Value.
+ */
+class SLArOpticalPropertyTable {
+  public:
+    //! Uniform energy grid with the property values at the nodes
+    struct Grid_t {
+      G4double fEmin = 0.0;
+      G4double fEmax = 0.0;
+      G4double fInvStep = 0.0;
+      std::vector<G4double> fValue;
+
+      void Fill(const G4MaterialPropertyVector* vec,
+          const G4double emin, const G4double emax, const G4int n_bins);
+      inline G4bool Contains(const G4double energy) const {
+        return (fValue.size() > 1 && energy >= fEmin && energy <= fEmax);
+      }
+      inline G4double Value(const G4double energy) const {
+        const G4double x = (energy - fEmin) * fInvStep;
+        size_t i = static_cast<size_t>(x);
+        if (i + 1 >= fValue.size()) i = fValue.size() - 2;
+        return fValue[i] + (x - i)*(fValue[i+1] - fValue[i]);
+      }
+    };
+
+    struct Entry_t {
+      G4bool fValid = false;
+      G4double fLowValue = 0.0;  //!< Value below the vector range
+      G4double fHighValue = 0.0; //!< Value above the vector range
+      Grid_t fBand; //!< Fine grid over the scintillation band
+      Grid_t fFull; //!< Coarse grid over the vector range
+    };
+
+    SLArOpticalPropertyTable(const G4double default_value = DBL_MAX,
+        const G4int n_bins = 256, const G4int n_band_bins = 512);
+    ~SLArOpticalPropertyTable() {}
+
+    //! Tabulate the given property from the material properties tables
+    void Build(const G4MaterialPropertyIndex property);
+    //! Tabulate the vectors of a process physics table (indexed by material)
+    void Build(const G4PhysicsTable* table);
+    inline void SetNumberOfBins(const G4int n_bins, const G4int n_band_bins) {
+      fNBins = n_bins; fNBandBins = n_band_bins;
+    }
+    inline G4bool IsBuilt() const {return fBuilt;}
+
+    //! Property value for the material with the given index at the given energy
+    inline G4double Value(const size_t material_idx, const G4double energy) const {
+      if (material_idx >= fEntry.size()) return fDefault;
+      const Entry_t& entry = fEntry[material_idx];
+      if (entry.fValid == false) return fDefault;
+      if (entry.fBand.Contains(energy)) return entry.fBand.Value(energy);
+      if (energy <= entry.fFull.fEmin) return entry.fLowValue;
+      if (energy >= entry.fFull.fEmax) return entry.fHighValue;
+      return entry.fFull.Value(energy);
+    }
+
+  private:
+    void BuildEntry(const size_t material_idx, const G4MaterialPropertyVector* vec);
+
+    G4double fDefault; //!< Value returned for materials without the property
+    G4int fNBins;
+    G4int fNBandBins;
+    G4bool fBuilt;
+    std::vector<Entry_t> fEntry;
+};
+
+#endif /* end of include guard SLAROPTICALPROPERTYTABLE_HH */
+
@@ -56,10 +56,13 @@
 #include "G4VRestDiscreteProcess.hh"
 #include "G4GenericMessenger.hh"
 #include <fstream>
+#include <vector>
 #include "SLArIonAndScintModel.h"
 #include "SLArIonAndScintLArQL.h"
+#include "SLArVOpticalLookup.hh"
 
 class G4PhysicsTable;
+class G4PhysicsFreeVector;
 class G4Step;
 class G4Track;
 
@@ -192,6 +195,21 @@ class SLArScintillation : public G4VRestDiscreteProcess
   void DisablePhotonGeneration() {fDoGeneratePhotons = false;}
   void EnablePhotonGeneration() {fDoGeneratePhotons = true;}
 
+  void SetOpticalLookup(SLArVOpticalLookup* lookup) {fOpticalLookup = lookup;}
+  // Sets the lookup used in hybrid mode for the photons produced far
+  // from the optical detectors (not owned by the process)
+
+  SLArVOpticalLookup* GetOpticalLookup() const {return fOpticalLookup;}
+
+  void SetHybridMode(const G4bool state) {fHybridMode = state;}
+  // If set, only the photons emitted within fNearFieldDistance of an
+  // optical detector are tracked, the others are handed to the lookup
+
+  G4bool IsHybridMode() const {return fHybridMode;}
+
+  void SetNearFieldDistance(const G4double d) {fNearFieldDistance = d;}
+  G4double GetNearFieldDistance() const {return fNearFieldDistance;}
+
   
   void DumpPhysicsTable() const;
   // Prints the fast and slow scintillation integral tables.
@@ -205,6 +223,25 @@ class SLArScintillation : public G4VRestDiscreteProcess
   G4PhysicsTable* fIntegralTable2;
   G4PhysicsTable* fIntegralTable3;
 
+  // Inverse of a scintillation integral: a guide table on a uniform grid
+  // of the integral points to the first node to check, so that the photon
+  // energy is found in O(1) steps instead of a binary search.
+  struct InverseIntegral_t {
+    std::vector<G4double> fEnergy;
+    std::vector<G4double> fIntegral;
+    std::vector<size_t>   fGuide;
+    G4double fMax = 0.0;
+
+    void Build(const G4PhysicsFreeVector* integral);
+    inline G4bool IsEmpty() const { return fEnergy.size() < 2 || fMax <= 0.0; }
+    G4double GetEnergy(const G4double u) const;
+  };
+  std::vector<InverseIntegral_t> fInverseIntegral[3];
+  // one entry per material for each scintillation component
+
+  static constexpr size_t kPhotonBatch = 64;
+  // number of photons whose kinematics is generated in a single block
+
   G4EmSaturation* fEmSaturation;
   const G4ParticleDefinition* opticalphoton =
     G4OpticalPhoton::OpticalPhotonDefinition();
@@ -218,6 +255,10 @@ class SLArScintillation : public G4VRestDiscreteProcess
   G4bool fTrackSecondariesFirst;
   G4bool fFiniteRiseTime;
   G4bool fDoGeneratePhotons;
+  G4bool fHybridMode;
+
+  G4double fNearFieldDistance;
+  SLArVOpticalLookup* fOpticalLookup;
 
   G4double ScintTrackEDep;
   G4double ScintTrackYield;
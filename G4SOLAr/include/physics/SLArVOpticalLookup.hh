@@ -0,0 +1,56 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArVOpticalLookup.hh
+ * @created     Wednesday Oct 21, 2026 14:02:18 CEST
+ */
+
+#ifndef SLARVOPTICALLOOKUP_HH
+
+#define SLARVOPTICALLOOKUP_HH
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+class G4PhysicsFreeVector;
+class G4Track;
+
+/**
+ * @brief Interface of the optical lookups used in the hybrid optical mode
+ *
+ * In the hybrid optical mode SLArScintillation tracks only the photons
+ * produced close to the optical detectors. The photons produced in the
+ * rest of the volume are not generated as G4Tracks: each scintillation
+ * component of the step is passed to the lookup as a single emission, and
+ * the lookup is responsible for producing the corresponding detector hits.
+ * Since these photons never reach the stacking action, the lookup is also
+ * in charge of their book-keeping (see RegisterPhotons).
+ */
+class SLArVOpticalLookup {
+  public:
+    //! Scintillation photons emitted uniformly along a step
+    struct Emission_t {
+      G4ThreeVector fStart;        //!< Emission segment start
+      G4ThreeVector fDelta;        //!< Emission segment displacement
+      G4double fTime = 0.0;        //!< Global time at the segment start
+      G4double fDeltaTime = 0.0;   //!< Time spent by the particle along the segment
+      G4double fDecayTime = 0.0;   //!< Scintillation decay time of the component
+      G4int fNumPhotons = 0;
+      G4int fParentID = 0;
+      const G4PhysicsFreeVector* fSpectrumIntegral = nullptr; //!< Cumulative emission spectrum
+      G4String fCreatorProcess;
+    };
+
+    virtual ~SLArVOpticalLookup() {}
+
+    //! Distance between the given point and the closest optical detector
+    virtual G4double GetDistanceToDetectors(const G4ThreeVector& pos) const = 0;
+    //! Account for the photons produced by the given track in a step
+    //! before their emissions are processed. If false is returned, the
+    //! photons are dropped and no emission is passed to the lookup.
+    virtual G4bool RegisterPhotons(const G4Track& parent, const G4int n_photons) = 0;
+    //! Produce the detector hits for photons that are not tracked
+    virtual void ProcessEmission(const Emission_t& emission) = 0;
+};
+
+#endif /* end of include guard SLARVOPTICALLOOKUP_HH */
+
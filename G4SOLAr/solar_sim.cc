@@ -26,6 +26,7 @@
 #include "SLArRunAction.hh"
 
 #include "G4GenericBiasingPhysics.hh"
+#include "G4GeometrySampler.hh"
 #include "G4ImportanceBiasing.hh"
 #include "G4VisExecutive.hh"
 #include "G4UIExecutive.hh"
@@ -44,6 +45,8 @@ namespace {
     fprintf(stderr, " \t\t[-g/--geometry geometry_cfg_file]\n");
     fprintf(stderr, " \t\t[-p/--materials material_db_file]\n");
     fprintf(stderr, " \t\t[-b/--bias particle <process_list> bias_factor]\n");
+    fprintf(stderr, " \t\t[-e/--external importance_particle (stage-1 external background mode, \"none\" to disable importance sampling)]\n");
+    fprintf(stderr, " \t\t[-i/--importance_map importance map json file (used with -e)]\n");
     fprintf(stderr, " \t\t[-h/--help print usage]\n");
     exit(0);
   }
@@ -90,14 +93,17 @@ int main(int argc,char** argv)
   G4double bias_factor = 1; 
   G4String physName = "FTFP_BERT_HP";
   std::vector<G4String> bias_process;
+  G4bool   do_external = false; 
+  G4String ext_particle = ""; 
+  G4String importance_map_file = ""; 
 
 #ifdef G4MULTITHREADED
   G4int nThreads = 0;
 #endif
 
   G4long myseed = 345354;
-  const char* short_opts = "m:o:d:l:x:u:t:r:g:p:b:c:h";
-  static struct option long_opts[14] = 
+  const char* short_opts = "m:o:d:l:x:u:t:r:g:p:b:c:e:i:h";
+  static struct option long_opts[16] = 
   {
     {"macro", required_argument, 0, 'm'}, 
     {"output", required_argument, 0, 'o'}, 
@@ -111,6 +117,8 @@ int main(int argc,char** argv)
     {"materials", required_argument, 0, 'p'},
     {"bias", required_argument, 0, 'b'},
     {"cerenkov", required_argument, 0, 'c'},
+    {"external", required_argument, 0, 'e'},
+    {"importance_map", required_argument, 0, 'i'},
     {"help", no_argument, 0, 'h'}, 
     {nullptr, no_argument, nullptr, 0}
   };
@@ -188,6 +196,20 @@ int main(int argc,char** argv)
         do_cerenkov = std::atoi( optarg ); 
         break;
       }
+      case 'e' : 
+      {
+        do_external = true; 
+        ext_particle = optarg; 
+        printf("solar_sim external background mode (importance sampling: %s)\n", 
+            ext_particle.data()); 
+        break;
+      }
+      case 'i' : 
+      {
+        importance_map_file = optarg; 
+        printf("solar_sim importance map: %s\n", importance_map_file.data()); 
+        break;
+      }
 
       case 'h' : 
       {
@@ -246,6 +268,10 @@ int main(int argc,char** argv)
 
   auto analysisManager = SLArAnalysisManager::Instance(); 
   analysisManager->SetSeed( myseed ); 
+  analysisManager->SetExternalMode( do_external ); 
+  if (importance_map_file.empty() == false) {
+    analysisManager->GetImportanceMap().Load( importance_map_file ); 
+  }
   printf("storing seed in analysis manager: %ld - %ld\n", 
       myseed, G4Random::getTheSeed());
 
@@ -254,18 +280,13 @@ int main(int argc,char** argv)
   printf("Creating Phiscs Lists...\n");
   auto physicsList = new SLArPhysicsList(physName, do_cerenkov);
   // External background biasing option
-#ifdef SLAR_EXTERNAL
-#ifndef SLAR_EXTERNAL_PARTICLE
-  printf("solar-sim WARNING: target built with SLAR_EXTERNAL flag but external particle is not specified"); 
-#else
-  const char* ext_particle = SLAR_EXTERNAL_PARTICLE;
-  G4GeometrySampler* mgs = nullptr; 
-  G4bool activate_importance_sampling = true;
-  mgs = new G4GeometrySampler(detector->GetPhysicalWorld(), ext_particle);
-  printf("Built with SLAR_EXTERNAL flag for particle %s\n", ext_particle);
-  if (activate_importance_sampling) physicsList->RegisterPhysics(new G4ImportanceBiasing(mgs));
-#endif
-#endif
+  G4bool activate_importance_sampling = do_external && (ext_particle != "none"); 
+  if (activate_importance_sampling) {
+    G4GeometrySampler* mgs = 
+      new G4GeometrySampler(detector->GetPhysicalWorld(), ext_particle);
+    printf("Importance sampling enabled for particle %s\n", ext_particle.data());
+    physicsList->RegisterPhysics(new G4ImportanceBiasing(mgs));
+  }
 
 
   if ( do_bias ) {
@@ -295,9 +316,7 @@ int main(int argc,char** argv)
     gen->Configure( generator_file ); 
   }
 
-  #ifdef SLAR_EXTERNAL
   if (activate_importance_sampling) detector->CreateImportanceStore(); 
-  #endif
 
   // Initialize visualization
   //
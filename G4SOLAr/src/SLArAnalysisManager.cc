@@ -18,6 +18,7 @@
 #include <sstream>
 
 #include "SLArEventAnode.hh"
+#include "TList.h"
 #include "TObjString.h"
 #include "TParameter.h"
 #include "TVectorD.h"
@@ -55,6 +56,9 @@ SLArAnalysisManager::SLArAnalysisManager(G4bool isMaster)
     fIsMaster(isMaster), fSeed( time(NULL) ), fOutputPath(""),
     fOutputFileName("solarsim_output.root"), 
     fTrajectoryFull( true ),
+    fEnablePixelFrontEnd( false ), fDropRawChargeTicks( false ), 
+    fRootFile(nullptr), fEventTree(nullptr), 
+    fExternalMode( false ), fExternalsTree(nullptr), fPhaseSpaceTree(nullptr), 
     fSuperCellBacktrackerManager(nullptr), 
     fVUVSiPMBacktrackerManager(nullptr), 
     fChargeBacktrackerManager(nullptr), 
@@ -72,9 +76,6 @@ SLArAnalysisManager::SLArAnalysisManager(G4bool isMaster)
   if ( isMaster ) {
     fgMasterInstance = this;
     //fMCEvent = std::make_unique<SLArMCEvent>();
-#ifdef SLAR_EXTERNAL
-    //fExternalRecord = std::make_unique<SLArEventTrajectoryLite>(); 
-#endif // DEBUG
     fAnaMsgr = new SLArAnalysisManagerMsgr();
   }
   fgInstance = this;
@@ -88,9 +89,8 @@ SLArAnalysisManager::~SLArAnalysisManager()
     if (fRootFile->IsOpen()) {
       fRootFile->cd();
       if (fEventTree) fEventTree->Write();
-#ifdef SLAR_EXTERNAL
-      fExternalsTree->Write(); 
-#endif // SLAR_EXTERNAL
+      if (fExternalsTree) fExternalsTree->Write(); 
+      if (fPhaseSpaceTree) fPhaseSpaceTree->Write(); 
       fRootFile->Close(); 
     }
   }
@@ -126,9 +126,8 @@ G4bool SLArAnalysisManager::CreateFileStructure()
 
   printf("MCEvent tree created with AutoFlush set to %lld\n", fEventTree->GetAutoFlush());
 
-#ifdef SLAR_EXTERNAL
-  SetupExternalsTree(); 
-#endif // SLAR_EXTERNAL
+  if (fExternalMode) SetupExternalsTree(); 
+  if (IsRecordingPhaseSpace()) SetupPhaseSpaceTree(); 
 
   return true;
 }
@@ -155,9 +154,24 @@ G4bool SLArAnalysisManager::Save()
 
   WriteSysCfg(); 
 
-#ifdef SLAR_EXTERNAL
-  fExternalsTree->Write();
-#endif // SLAR_EXTERNAL
+  if (fTrackKillingRules.IsActive()) fTrackKillingRules.PrintSummary(); 
+
+  if (fImportanceMap.IsScoring() && !fImportanceMap.GetOutputFile().empty()) {
+    fImportanceMap.ComputeImportances(); 
+    fImportanceMap.Write( fImportanceMap.GetOutputFile() ); 
+  }
+
+  if (fExternalsTree) fExternalsTree->Write();
+  if (fPhaseSpaceTree) {
+    fPhaseSpaceTree->Write(); 
+    // store the scorer aliases, indexed by the scorer id of the records
+    TList scorer_list; 
+    scorer_list.SetOwner( true ); 
+    for (const auto& alias : fPhaseSpaceScorers) {
+      scorer_list.Add( new TObjString(alias.data()) ); 
+    }
+    scorer_list.Write("PhaseSpaceScorers", TObject::kSingleKey); 
+  }
 
   fRootFile->Close();
 
@@ -227,6 +241,64 @@ G4bool SLArAnalysisManager::FillEvTree() {
   return true;
 }
 
+/**
+ * @brief Run the pixel front-end emulator on the charge hits of the event
+ *
+ * The packets are stored in each pixel record. The front-end must see the
+ * raw ticks, so this method has to be called before the zero suppression:
+ * with online zero suppression the tick stream is taken from the staging
+ * buffer of the anode, otherwise from the pixel hits collections. 
+ *
+ * @return number of digitized packets
+ */
+G4int SLArAnalysisManager::ProcessPixelFrontEnd() {
+  G4int n_packets = 0; 
+  for (auto& anode_itr : fMCEvent.GetEventAnode()) {
+    auto& anode = anode_itr.second; 
+    if (anode.IsStagingChargeHits()) {
+      n_packets += anode.ProcessStagedChargeHits( fPixelFrontEnd ); 
+      continue;
+    }
+    for (auto& mt_itr : anode.GetMegaTilesMap()) {
+      for (auto& t_itr : mt_itr.second.GetTileMap()) {
+        for (auto& pix_itr : t_itr.second.GetPixelEvents()) {
+          auto& pixel = pix_itr.second; 
+          pixel.GetPackets().clear(); 
+          n_packets += fPixelFrontEnd.Process( pixel.GetConstHits(), pixel.GetPackets() ); 
+        }
+      }
+    }
+  }
+  return n_packets;
+}
+
+/**
+ * @details Drop the per-tick charge hits once the front-end packets are 
+ * computed and the zero suppression applied. Pixels left without packets 
+ * are removed from the event. 
+ */
+void SLArAnalysisManager::ClearRawChargeTicks() {
+  for (auto& anode_itr : fMCEvent.GetEventAnode()) {
+    for (auto& mt_itr : anode_itr.second.GetMegaTilesMap()) {
+      for (auto& t_itr : mt_itr.second.GetTileMap()) {
+        auto& pix_map = t_itr.second.GetPixelEvents(); 
+        for (auto it_pix = pix_map.begin(); it_pix != pix_map.end(); ) {
+          auto& pixel = it_pix->second; 
+          pixel.GetHits().clear(); 
+          pixel.SetNhits( 0 ); 
+          if (pixel.GetPackets().empty()) {
+            it_pix = pix_map.erase(it_pix); 
+          }
+          else {
+            it_pix++; 
+          }
+        }
+      }
+    }
+  }
+  return;
+}
+
 //template<typename T> 
 //int SLArAnalysisManager::WriteVariable (G4String name, T val) {
   //if (!fRootFile) {
@@ -553,7 +625,6 @@ void SLArAnalysisManager::SetupBacktrackerRecords() {
 
 }
 
-#ifdef SLAR_EXTERNAL
 void SLArAnalysisManager::SetupExternalsTree() {
   fExternalsTree = new TTree("ExternalTree", "Externals reaching LAr interface");
 
@@ -572,5 +643,28 @@ void SLArAnalysisManager::SetupExternalsTree() {
 
   printf("ExternalsTree created with AutoFlush set to %lld\n", fExternalsTree->GetAutoFlush()); 
 }
-#endif // SLAR_EXTERNAL
+
+void SLArAnalysisManager::SetupPhaseSpaceTree() {
+  fPhaseSpaceTree = new TTree("PhaseSpaceTree", "Phase space of particles reaching the external scorers");
+  fPhaseSpaceRecord.SetupBranches( fPhaseSpaceTree ); 
+
+  printf("PhaseSpaceTree created with AutoFlush set to %lld\n", fPhaseSpaceTree->GetAutoFlush()); 
+}
+
+void SLArAnalysisManager::FillPhaseSpaceTree() {
+  if (fPhaseSpaceTree) fPhaseSpaceTree->Fill(); 
+  fPhaseSpaceRecord.Reset(); 
+  return;
+}
+
+/**
+ * @details Register a new phase-space scorer surface. The returned index 
+ * is stored in the phase-space records of the particles stopped at the 
+ * scorer and the aliases are written to the output file. 
+ */
+G4int SLArAnalysisManager::RegisterPhaseSpaceScorer(const G4String alias) {
+  fPhaseSpaceScorers.push_back( alias ); 
+  return fPhaseSpaceScorers.size() - 1; 
+}
+
 
@@ -14,6 +14,7 @@
 #include <G4UIcmdWithABool.hh>
 #include <G4UIcmdWithAString.hh>
 #include <G4UIcmdWithAnInteger.hh>
+#include <G4UIcmdWithADouble.hh>
 #include <G4PhysicalVolumeStore.hh>
 //#include <G4UIcmdWithADouble.hh>
 //#include <G4UIcmdWith3Vector.hh>
@@ -28,14 +29,18 @@ SLArAnalysisManagerMsgr::SLArAnalysisManagerMsgr() :
   fMsgrDir  (nullptr), fConstr_(nullptr),
   fCmdOutputFileName(nullptr),  fCmdOutputPath(nullptr), 
   fCmdWriteCfgFile(nullptr), fCmdPlotXSec(nullptr), 
-  fCmdGeoAnodeDepth(nullptr), 
+  fCmdGeoAnodeDepth(nullptr), fCmdGeoProfile(nullptr), 
   fCmdEnableBacktracker(nullptr),
   fCmdRegisterBacktracker(nullptr), 
-  fCmdSetZeroSuppressionThrs(nullptr)
+  fCmdSetZeroSuppressionThrs(nullptr), fCmdSetZeroSuppressionMode(nullptr),
+  fCmdEnablePixelFrontEnd(nullptr), fCmdDropRawChargeTicks(nullptr), 
+  fCmdSetPixelFrontEndPar(nullptr)
 #ifdef SLAR_GDML
   ,fCmdGDMLFileName(nullptr), fCmdGDMLExport(nullptr),
 #endif
-  fCmdAddExtScorer(nullptr),
+  fCmdAddExtScorer(nullptr), fCmdScoreImportance(nullptr), 
+  fCmdSetImportanceMapOutput(nullptr), fCmdSetMaxImportance(nullptr),
+  fCmdLoadTrackKillingRules(nullptr), fCmdEnablePDECulling(nullptr),
   fGDMLFileName("slar_export.gdml")
 {
   TString UIManagerPath = "/SLAr/manager/";
@@ -92,17 +97,78 @@ SLArAnalysisManagerMsgr::SLArAnalysisManagerMsgr() :
     new G4UIcmdWithAnInteger(UIManagerPath+"setZeroSuppressionThrs", this);
   fCmdSetZeroSuppressionThrs->SetGuidance("Set charge readout zero suppression threshold");
   fCmdSetZeroSuppressionThrs->SetParameterName("threshold", false);
+
+  fCmdSetZeroSuppressionMode = 
+    new G4UIcmdWithAString(UIManagerPath+"setZeroSuppressionMode", this);
+  fCmdSetZeroSuppressionMode->SetGuidance("Set charge readout zero suppression mode");
+  fCmdSetZeroSuppressionMode->SetGuidance("offline: applied at the end of the event on the full hit record (default)");
+  fCmdSetZeroSuppressionMode->SetGuidance("online: hits are staged and only ticks above threshold are recorded");
+  fCmdSetZeroSuppressionMode->SetParameterName("mode", false);
+  fCmdSetZeroSuppressionMode->SetCandidates("offline online");
+
+  fCmdEnablePixelFrontEnd = 
+    new G4UIcmdWithABool(UIManagerPath+"enablePixelFrontEnd", this);
+  fCmdEnablePixelFrontEnd->SetGuidance("Run the pixel front-end emulator at the end of the event");
+  fCmdEnablePixelFrontEnd->SetParameterName("enable", false);
+
+  fCmdDropRawChargeTicks = 
+    new G4UIcmdWithABool(UIManagerPath+"dropRawChargeTicks", this);
+  fCmdDropRawChargeTicks->SetGuidance("Do not store the raw pixel tick maps when the front-end emulator is enabled");
+  fCmdDropRawChargeTicks->SetParameterName("drop", false);
+
+  fCmdSetPixelFrontEndPar = 
+    new G4UIcmdWithAString(UIManagerPath+"setPixelFrontEndPar", this);
+  fCmdSetPixelFrontEndPar->SetGuidance("Set pixel front-end emulator parameter [name] [value]");
+  fCmdSetPixelFrontEndPar->SetGuidance("threshold, noise, pedestal, gain, adc_bits, hold_ticks, dead_ticks, period_ticks, trigger_mode");
+  fCmdSetPixelFrontEndPar->SetParameterName("name value", false);
   
   fCmdGeoAnodeDepth = 
     new G4UIcmdWithAnInteger(UIGeometryPath+"setAnodeVisDepth", this);
   fCmdGeoAnodeDepth->SetGuidance("Set visualization depth for SoLAr anode");
   fCmdGeoAnodeDepth->SetParameterName("depth", false);
 
+  fCmdGeoProfile = 
+    new G4UIcmdWithAString(UIGeometryPath+"profile", this);
+  fCmdGeoProfile->SetGuidance("Profile the navigation cost of the geometry with probe rays");
+  fCmdGeoProfile->SetGuidance("Specify [n_rays] [output json file (default geometry_profile.json)]");
+  fCmdGeoProfile->SetParameterName("n_rays output", false);
+  fCmdGeoProfile->AvailableForStates(G4State_Idle);
+  fCmdGeoProfile->SetToBeBroadcasted(false);
+
   fCmdAddExtScorer = 
     new G4UIcmdWithAString(UIManagerPath+"addExtScorer", this);
-  fCmdAddExtScorer->SetGuidance("Add external scorer volume (only for EXT mode)");
+  fCmdAddExtScorer->SetGuidance("Add external scorer volume recording the phase space of the incoming particles");
   fCmdAddExtScorer->SetParameterName("scorer_pv:alias", false);
   fCmdAddExtScorer->SetGuidance("Specfiy physical volume to be used as ext scorer [pv_name]:[alias]");
+
+  fCmdScoreImportance = 
+    new G4UIcmdWithAString(UIManagerPath+"scoreImportance", this);
+  fCmdScoreImportance->SetGuidance("Score the population of the given particle in each geometry cell (importance pilot run)");
+  fCmdScoreImportance->SetParameterName("particle", false);
+
+  fCmdSetImportanceMapOutput = 
+    new G4UIcmdWithAString(UIManagerPath+"setImportanceMapOutput", this);
+  fCmdSetImportanceMapOutput->SetGuidance("Set the json file where the importance map derived from the pilot run is written");
+  fCmdSetImportanceMapOutput->SetParameterName("file", false);
+
+  fCmdSetMaxImportance = 
+    new G4UIcmdWithADouble(UIManagerPath+"setMaxImportance", this);
+  fCmdSetMaxImportance->SetGuidance("Set the maximum importance assigned to a geometry cell");
+  fCmdSetMaxImportance->SetParameterName("max_importance", false);
+  fCmdSetMaxImportance->SetRange("max_importance >= 1");
+
+  fCmdLoadTrackKillingRules = 
+    new G4UIcmdWithAString(UIManagerPath+"loadTrackKillingRules", this);
+  fCmdLoadTrackKillingRules->SetGuidance("Load russian roulette and track killing rules from json file");
+  fCmdLoadTrackKillingRules->SetParameterName("file", false);
+
+  fCmdEnablePDECulling = 
+    new G4UIcmdWithABool(UIManagerPath+"enablePDECulling", this);
+  fCmdEnablePDECulling->SetGuidance("Apply the maximum photo-detection efficiency as survival probability at photon creation");
+  fCmdEnablePDECulling->SetGuidance("The sensor efficiency tables are rescaled accordingly (to be set before /run/initialize)");
+  fCmdEnablePDECulling->SetParameterName("enable", false);
+  fCmdEnablePDECulling->AvailableForStates(G4State_PreInit);
+  fCmdEnablePDECulling->SetToBeBroadcasted(false);
   
 #ifdef SLAR_GDML
   fCmdGDMLFileName = 
@@ -128,11 +194,21 @@ SLArAnalysisManagerMsgr::~SLArAnalysisManagerMsgr()
   if (fCmdWriteCfgFile       ) delete fCmdWriteCfgFile       ; 
   if (fCmdPlotXSec           ) delete fCmdPlotXSec           ; 
   if (fCmdGeoAnodeDepth      ) delete fCmdGeoAnodeDepth      ; 
+  if (fCmdGeoProfile         ) delete fCmdGeoProfile         ; 
   if (fCmdStoreFullTrajectory) delete fCmdStoreFullTrajectory;
   if (fCmdEnableBacktracker  ) delete fCmdEnableBacktracker  ;
   if (fCmdRegisterBacktracker) delete fCmdRegisterBacktracker;
   if (fCmdSetZeroSuppressionThrs) delete fCmdSetZeroSuppressionThrs;
+  if (fCmdSetZeroSuppressionMode) delete fCmdSetZeroSuppressionMode;
+  if (fCmdEnablePixelFrontEnd   ) delete fCmdEnablePixelFrontEnd   ;
+  if (fCmdDropRawChargeTicks    ) delete fCmdDropRawChargeTicks    ;
+  if (fCmdSetPixelFrontEndPar   ) delete fCmdSetPixelFrontEndPar   ;
   if (fCmdAddExtScorer       ) delete fCmdAddExtScorer       ; 
+  if (fCmdScoreImportance    ) delete fCmdScoreImportance    ; 
+  if (fCmdSetImportanceMapOutput) delete fCmdSetImportanceMapOutput;
+  if (fCmdSetMaxImportance   ) delete fCmdSetMaxImportance   ; 
+  if (fCmdLoadTrackKillingRules) delete fCmdLoadTrackKillingRules;
+  if (fCmdEnablePDECulling   ) delete fCmdEnablePDECulling   ;
 #ifdef SLAR_DGML
   if (fCmdGDMLFileName  ) delete fCmdGDMLFileName  ;
   if (fCmdGDMLExport    ) delete fCmdGDMLExport    ;
@@ -187,6 +263,13 @@ void SLArAnalysisManagerMsgr::SetNewValue
   else if (cmd == fCmdGeoAnodeDepth) {
     fConstr_->SetAnodeVisAttributes( std::atoi(newVal) ); 
   }
+  else if (cmd == fCmdGeoProfile) {
+    std::stringstream input(newVal); 
+    G4int n_rays = 0; 
+    std::string output = "geometry_profile.json"; 
+    input >> n_rays >> output; 
+    fConstr_->ProfileGeometry(n_rays, output); 
+  }
   else if (cmd == fCmdStoreFullTrajectory) {
     SLArAnaMgr->SetStoreTrajectoryFull( G4UIcmdWithABool::GetNewBoolValue(newVal) );
   }
@@ -240,6 +323,62 @@ void SLArAnalysisManagerMsgr::SetNewValue
       anode_itr.second.SetZeroSuppressionThreshold( thrs ); 
     }
   }
+
+  else if (cmd == fCmdSetZeroSuppressionMode) {
+    const bool online = (newVal == "online"); 
+    for (auto& anode_itr : SLArAnaMgr->GetEvent().GetEventAnode()) {
+      anode_itr.second.SetOnlineZeroSuppression( online ); 
+    }
+  }
+
+  else if (cmd == fCmdScoreImportance) {
+    SLArAnaMgr->GetImportanceMap().EnableScoring( newVal ); 
+  }
+
+  else if (cmd == fCmdSetImportanceMapOutput) {
+    SLArAnaMgr->GetImportanceMap().SetOutputFile( newVal ); 
+  }
+
+  else if (cmd == fCmdSetMaxImportance) {
+    SLArAnaMgr->GetImportanceMap().SetMaxImportance( 
+        G4UIcmdWithADouble::GetNewDoubleValue(newVal) ); 
+  }
+
+  else if (cmd == fCmdLoadTrackKillingRules) {
+    try {
+      SLArAnaMgr->GetTrackKillingRules().Load( newVal ); 
+    }
+    catch (const std::exception& e) {
+      G4cerr << e.what() << G4endl;
+    }
+  }
+
+  else if (cmd == fCmdEnablePDECulling) {
+    auto construction = 
+      (SLArDetectorConstruction*)G4RunManager::GetRunManager()->GetUserDetectorConstruction();
+    construction->SetEarlyPDECulling( G4UIcmdWithABool::GetNewBoolValue(newVal) ); 
+  }
+
+  else if (cmd == fCmdEnablePixelFrontEnd) {
+    SLArAnaMgr->EnablePixelFrontEnd( G4UIcmdWithABool::GetNewBoolValue(newVal) ); 
+  }
+
+  else if (cmd == fCmdDropRawChargeTicks) {
+    SLArAnaMgr->SetDropRawChargeTicks( G4UIcmdWithABool::GetNewBoolValue(newVal) ); 
+  }
+
+  else if (cmd == fCmdSetPixelFrontEndPar) {
+    std::stringstream input(newVal); 
+    std::string par_name; 
+    double par_val = 0; 
+    input >> par_name >> par_val; 
+    try {
+      SLArAnaMgr->GetPixelFrontEnd().SetParameter(par_name, par_val); 
+    }
+    catch (const std::invalid_argument& e) {
+      G4cerr << e.what() << G4endl;
+    }
+  }
 #ifdef SLAR_GDML
   else if (cmd == fCmdGDMLFileName) {
     fGDMLFileName = newVal; 
@@ -62,20 +62,20 @@ SLArBacktracker::SLArBacktracker() : fName("backtracker")
 SLArBacktracker::SLArBacktracker(const G4String name) : fName(name)
 {}
 
-void SLArBacktrackerTrkID::Eval(SLArEventGenericHit* hit, SLArEventBacktrackerRecord* rec) {
-  rec->UpdateCounter(hit->GetProducerTrkID());
+void SLArBacktrackerTrkID::Eval(SLArEventGenericHit* hit, SLArEventBacktrackerRecord* rec, const UShort_t w) {
+  rec->UpdateCounter(hit->GetProducerTrkID(), w);
 }
 
-void SLArBacktrackerAncestorID::Eval(SLArEventGenericHit* hit, SLArEventBacktrackerRecord* rec) {
+void SLArBacktrackerAncestorID::Eval(SLArEventGenericHit* hit, SLArEventBacktrackerRecord* rec, const UShort_t w) {
   auto ev_action = (SLArEventAction*)G4RunManager::GetRunManager()->GetUserEventAction();
   int ancestor = ev_action->FindAncestorID(hit->GetPrimaryProducerTrkID()); 
-  rec->UpdateCounter(ancestor);
+  rec->UpdateCounter(ancestor, w);
 }
 
-void SLArBacktrackerOpticalProcess::Eval(SLArEventGenericHit* hit, SLArEventBacktrackerRecord* rec) {
+void SLArBacktrackerOpticalProcess::Eval(SLArEventGenericHit* hit, SLArEventBacktrackerRecord* rec, const UShort_t w) {
   if (dynamic_cast<SLArEventPhotonHit*>(hit)) {
     auto ph_hit = dynamic_cast<SLArEventPhotonHit*>(hit);
-    rec->UpdateCounter(ph_hit->GetProcess()); 
+    rec->UpdateCounter(ph_hit->GetProcess(), w); 
   }
   return;
 }
@@ -12,6 +12,7 @@
 #include <SLArBulkVertexGenerator.hh>
 #include <SLArBoxSurfaceVertexGenerator.hh>
 #include <SLArAnalysisManager.hh>
+#include <SLArUserPrimaryInformation.hh>
 
 namespace gen {
 void SLArBaseGenerator::ConfigureVertexGenerator(const rapidjson::Value& config) {
@@ -122,6 +123,7 @@ void SLArBaseGenerator::RegisterPrimaries(const G4Event* anEvent, const G4int fi
           particle->GetPx(), particle->GetPy(), particle->GetPz(), 
           particle->GetKineticEnergy());
       tc_primary.SetTime(anEvent->GetPrimaryVertex(i)->GetT0()); 
+      tc_primary.SetWeight(particle->GetWeight()); 
       tc_primary.SetGeneratorLabel( fLabel.data() ); 
 
 #ifdef SLAR_DEBUG
@@ -129,7 +131,11 @@ void SLArBaseGenerator::RegisterPrimaries(const G4Event* anEvent, const G4int fi
       tc_primary.PrintParticle(); 
       //getchar();
 #endif
-      SLArAnaMgr->GetEvent().RegisterPrimary( tc_primary );
+      const size_t n_primaries = SLArAnaMgr->GetEvent().RegisterPrimary( tc_primary );
+      // link the G4PrimaryParticle to its record for the track association
+      if (particle->GetUserInformation() == nullptr) {
+        particle->SetUserInformation( new SLArUserPrimaryInformation(n_primaries-1) ); 
+      }
     }
   }
 
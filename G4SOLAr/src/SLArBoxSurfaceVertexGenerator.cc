@@ -26,8 +26,18 @@ SLArBoxSurfaceVertexGenerator::SLArBoxSurfaceVertexGenerator(const SLArBoxSurfac
   fRandomSeed = origin.fRandomSeed; 
   fNoDaughters = origin.fNoDaughters; 
 
+  fFixFace = origin.fFixFace; 
+  fVtxFace = origin.fVtxFace; 
+
   fSolid = origin.fSolid; 
   fBulkInverseRotation = origin.fBulkInverseRotation; 
+  fSurface = origin.fSurface; 
+  fBoxCenter = origin.fBoxCenter; 
+  fBoxDim = origin.fBoxDim; 
+  for (int i=0; i<6; i++) {
+    fFaceArea[i] = origin.fFaceArea[i]; 
+    fFaceCDF[i] = origin.fFaceCDF[i]; 
+  }
   fCounter = origin.fCounter; 
 
 }
@@ -41,6 +51,7 @@ void SLArBoxSurfaceVertexGenerator::SetBoxLogicalVolume(const G4LogicalVolume *
 {
   fSolid = logvol_->GetSolid();
   fLogVol = logvol_;
+  ComputeFaceCDF(); 
   std::clog << "[log] SLArBoxSurfaceVertexGenerator::SetBoxLogicalVolume: solid=" << fSolid << "\n";
 }
 
@@ -103,123 +114,73 @@ void SLArBoxSurfaceVertexGenerator::SetNoDaughters(bool no_daughters_)
   fNoDaughters = no_daughters_;
 }
 
+/**
+ * @details Compute the bounding box of the solid and the cumulative 
+ * probability of sampling each face (proportional to its area). This is 
+ * done once when the volume is set, so that ShootVertex() only needs a 
+ * lookup in a six-entry table. 
+ */
+void SLArBoxSurfaceVertexGenerator::ComputeFaceCDF() {
+  G4ThreeVector lo; 
+  G4ThreeVector hi;
+  fSolid->BoundingLimits(lo, hi);
+
+  for (int i=0; i<3; i++) fBoxDim[i] = fabs(hi[i] - lo[i]); 
+  fBoxCenter = 0.5*(lo + hi); 
+
+  fSurface = 0.0; 
+  for (int i=0; i<6; i++) {
+    const int k = i / 2; // axis normal to the face 
+    fFaceArea[i] = fBoxDim[(k+1)%3] * fBoxDim[(k+2)%3]; 
+    fSurface += fFaceArea[i]; 
+    fFaceCDF[i] = fSurface; 
+  }
+  for (int i=0; i<6; i++) fFaceCDF[i] /= fSurface; 
+  fFaceCDF[5] = 1.0; 
+
+  return;
+}
+
 G4double SLArBoxSurfaceVertexGenerator::GetSurfaceGenerator() const {
   if (fFixFace == false) {
-    return geo::get_bounding_volume_surface(fSolid); 
-    //if (dynamic_cast<const G4Box*>(fSolid)) {
-      //const auto box = (G4Box*)fSolid;
-      //return box->GetSurfaceArea(); 
-    //}
-    //else {
-      //printf("SLArBoxSurfaceVertexGenerator WARNING: "); 
-      //printf("GetSurfaceGenerator() is only implemented for G4Box solids. "); 
-      //printf("Feel free to work on your solid's implementation and let me know!\n");
-      //printf("Using a box approximation.\n");
-
-      //G4ThreeVector lo; 
-      //G4ThreeVector hi;
-      //G4ThreeVector dim; 
-      //fSolid->BoundingLimits(lo, hi);
-
-      //for (int i=0; i<3; i++) dim[i] = fabs(hi[i] - lo[i]); 
-
-      //G4double half_area = dim[0]*dim[1] + dim[0]*dim[2] + dim[1]*dim[2];
-
-      //return 2*half_area; 
-    //}
+    return fSurface; 
   }
   else {
-    if (dynamic_cast<const G4Box*>(fSolid)) {
-      const auto box = (G4Box*)fSolid;
-      if (fVtxFace == geo::kXplus || fVtxFace == geo::kXminus) {
-        return box->GetYHalfLength()*box->GetZHalfLength()*4;
-      }
-      else if (fVtxFace == geo::kYplus || fVtxFace == geo::kYminus) {
-        return box->GetYHalfLength()*box->GetZHalfLength()*4;
-      }
-      else if (fVtxFace == geo::kZplus || fVtxFace == geo::kZminus) {
-        return box->GetYHalfLength()*box->GetXHalfLength()*4;
-      }
-      else {
-        return 0.;
-      }
-    }
-    else {
+    if (dynamic_cast<const G4Box*>(fSolid) == nullptr) {
       printf("SLArBoxSurfaceVertexGenerator WARNING: "); 
-      printf("GetSurfaceGenerator() is only implemented for G4Box solids. "); 
-      printf("Feel free to work on your solid's implementation and let me know!\n"); 
-      return 0; 
+      printf("GetSurfaceGenerator() is only exact for G4Box solids. "); 
+      printf("Using the bounding box face.\n"); 
     }
-
+    return fFaceArea[fVtxFace]; 
   }
 }
+
+G4ThreeVector SLArBoxSurfaceVertexGenerator::GetVertexFaceNormal() const {
+  return fBulkInverseRotation( geo::BoxFaceNormal[fVtxFace] ); 
+}
  
 void SLArBoxSurfaceVertexGenerator::ShootVertex(G4ThreeVector & vertex_)
 {
-  // sample a random vertex inside the volume given by fVolumeName
-  G4ThreeVector lo; 
-  G4ThreeVector hi;
-  G4ThreeVector dim; 
-  std::vector<G4ThreeVector> axis = 
-  {G4ThreeVector(1, 0, 0), G4ThreeVector(0, 1, 0), G4ThreeVector(0, 0, 1)}; 
-  fSolid->BoundingLimits(lo, hi);
-
-  for (int i=0; i<3; i++) dim[i] = fabs(hi[i] - lo[i]); 
-
   if (fFixFace == false) {
-    G4double total_area = 2*(dim.x()*dim.y() + dim.x()*dim.z() + dim.y()*dim.z()); 
-    std::map<geo::EBoxFace, G4double> area_fraction; 
-
-    for (int i=0; i<6; i++) {
-      geo::EBoxFace kFace = geo::EBoxFace(i); 
-      G4double area = 1; 
-      for (int  j=0; j < 3; j++) {
-        if (geo::BoxFaceNormal[kFace].dot(axis[j]) == 0) area *= dim[j]; 
-      }
-
-      area_fraction.insert( std::make_pair(kFace, area / total_area)); 
-    }
-
-    G4double face_sample = G4UniformRand(); 
-    G4double face_prob = 0.; 
-    G4int iface = -1;
-    //printf("face_sample = %g\n", face_sample);
-    while (face_sample > face_prob) {
-      iface++;
-      face_prob += area_fraction[(geo::EBoxFace)iface]; 
-    }
-
+    const G4double face_sample = G4UniformRand(); 
+    int iface = 0; 
+    while (iface < 5 && face_sample > fFaceCDF[iface]) iface++; 
     fVtxFace = (geo::EBoxFace)iface;
   }
 
-  //printf("vertex generator face is: %i\n", fVtxFace);
-  //G4cout << "face normal is: " << BoxFaceNormal[fVtxFace] << G4endl;
-  G4ThreeVector face_axis(0, 0, 0); 
-  for (int j=0; j<3; j++) {
-    if (axis[j].dot(geo::BoxFaceNormal[fVtxFace]) != 0) {
-      face_axis = axis[j]; 
-      break;
-    }
-  }
+  // faces come in (+, -) pairs along x, y and z
+  const int k = fVtxFace / 2; 
+  const G4double side = (fVtxFace % 2 == 0) ? 0.5 : -0.5; 
 
-  G4ThreeVector face_center_local = 
-    -0.5*dim.dot(geo::BoxFaceNormal[fVtxFace])*face_axis;
-  //G4cout << "face_center_local: " << face_center_local << G4endl; 
-  G4ThreeVector local_displacement(0, 0, 0); 
+  G4ThreeVector localVertex = fBoxCenter; 
   for (int j=0; j<3; j++) {
-    double rnd = G4UniformRand() - 0.5; 
-    local_displacement[j] += 
-    geo::BoxFaceNormal[fVtxFace].cross( axis[j] ).mag()*rnd*dim[j];
+    if (j == k) localVertex[j] += side*fBoxDim[j]; 
+    else localVertex[j] += (G4UniformRand() - 0.5)*fBoxDim[j]; 
   }
-  //G4cout << "local_displacement: " << local_displacement << G4endl;
 
-  G4ThreeVector localVertex = face_center_local + local_displacement;
   G4ThreeVector finalVertex = fBulkInverseRotation(localVertex) + fBulkTranslation;
 
   vertex_.set(finalVertex.x(), finalVertex.y(), finalVertex.z()); 
-  //G4cout << "vertex = " << vertex_ << G4endl;
-  //getchar(); 
-  axis.clear();
   fCounter++;
 }
 
@@ -4,9 +4,13 @@
  * @created     : giovedì giu 23, 2022 15:34:13 CEST
  */
 
+#include <chrono>
+#include <algorithm>
+
 #include "SLArBulkVertexGenerator.hh"
 #include "G4PhysicalVolumeStore.hh"
 #include "G4RandomTools.hh"
+#include "G4VSolid.hh"
 
 namespace gen {
 SLArBulkVertexGenerator::SLArBulkVertexGenerator()
@@ -27,6 +31,17 @@ SLArBulkVertexGenerator::SLArBulkVertexGenerator(const SLArBulkVertexGenerator&
   fSolid = origin.fSolid; 
   fBulkInverseRotation = origin.fBulkInverseRotation; 
   fCounter = origin.fCounter; 
+
+  fLo = origin.fLo; 
+  fHi = origin.fHi; 
+  fSamplingMode = origin.fSamplingMode; 
+  fAcceptance = origin.fAcceptance; 
+  fVoxelAcceptance = origin.fVoxelAcceptance; 
+  fVoxelThreshold = origin.fVoxelThreshold; 
+  fVoxelTargetCount = origin.fVoxelTargetCount; 
+  fAcceptanceSamples = origin.fAcceptanceSamples; 
+  fVoxelSize = origin.fVoxelSize; 
+  fVoxels = origin.fVoxels; 
 }
 
 SLArBulkVertexGenerator::~SLArBulkVertexGenerator()
@@ -104,62 +119,283 @@ void SLArBulkVertexGenerator::SetNoDaughters(bool no_daughters_)
 {
   fNoDaughters = no_daughters_;
 }
- 
-void SLArBulkVertexGenerator::ShootVertex(G4ThreeVector & vertex_)
+
+void SLArBulkVertexGenerator::SetFiducialFraction(double fvf)
 {
+  fFVFraction = fvf; 
+  if (fSolid) BuildSampler(); 
+}
 
-  // sample a random vertex inside the volume given by fVolumeName
+/**
+ * @details Cache the (fiducial) sampling box of the solid and estimate the 
+ * acceptance of a plain bounding-box rejection sampling. When the acceptance 
+ * falls below fVoxelThreshold (thin layers, boolean shells...) an inside-map 
+ * of the solid is built once on a regular grid and vertexes are then 
+ * sampled voxel-by-voxel. 
+ * The configuration-time probes use a private engine seeded with fRandomSeed, 
+ * so that the Geant4 random sequence is not affected by the sampler setup.
+ */
+void SLArBulkVertexGenerator::BuildSampler()
+{
   G4ThreeVector lo; 
   G4ThreeVector hi;
   fSolid->BoundingLimits(lo, hi);
 
-  //printf("lo: [%.1f, %.1f, %.1f]\nhi: [%.1f, %.1f, %.1f]\n", 
-      //lo.x(), lo.y(), lo.z(), hi.x(), hi.y(), hi.z());
-
   double delta = 0.; 
   if (fFVFraction < 1.0) {
-    delta = ComputeDeltaX(lo, hi); 
-    //printf("delta = %g\n", delta);
+    delta = ComputeDeltaX(lo, hi, fFVFraction); 
+  }
+  const G4ThreeVector shift(0.5*delta, 0.5*delta, 0.5*delta); 
+  fLo = lo + shift; 
+  fHi = hi - shift; 
+
+  std::mt19937_64 rng(fRandomSeed); 
+  fAcceptance = EstimateAcceptance(rng); 
+
+  fVoxels.clear(); 
+  fSamplingMode = kBoxRejection; 
+  fVoxelAcceptance = fAcceptance; 
+  if (fAcceptance < fVoxelThreshold) {
+    BuildVoxelMap(rng); 
+    if (fVoxels.empty() == false) fSamplingMode = kVoxelized; 
+  }
+
+  std::clog << "[log] SLArBulkVertexGenerator::BuildSampler: " << fSolid->GetName() 
+    << " box acceptance=" << fAcceptance; 
+  if (fSamplingMode == kVoxelized) {
+    std::clog << " - voxelized sampling with " << fVoxels.size() 
+      << " voxels (acceptance=" << fVoxelAcceptance << ")"; 
+  }
+  std::clog << "\n";
+  return;
+}
+
+double SLArBulkVertexGenerator::EstimateAcceptance(std::mt19937_64& rng) const
+{
+  std::uniform_real_distribution<double> flat(0., 1.); 
+  const G4ThreeVector dim = fHi - fLo; 
+
+  size_t n_inside = 0; 
+  for (size_t i=0; i<fAcceptanceSamples; i++) {
+    G4ThreeVector p(
+        fLo.x() + flat(rng)*dim.x(), 
+        fLo.y() + flat(rng)*dim.y(), 
+        fLo.z() + flat(rng)*dim.z()); 
+    if (fSolid->Inside(p) != kOutside) n_inside++; 
   }
 
+  return n_inside / static_cast<double>(fAcceptanceSamples); 
+}
+
+/**
+ * @details The sampling box is divided in about fVoxelTargetCount cubic-like 
+ * voxels. A voxel is discarded only when the isotropic safety from its centre 
+ * is larger than its half diagonal, i.e. when it cannot intersect the solid. 
+ * Since safeties are underestimates of the actual distance the map is 
+ * conservative and the sampling stays uniform. Voxels whose centre is deep 
+ * enough inside the solid are flagged as fully contained and do not need 
+ * any further Inside() check. 
+ */
+void SLArBulkVertexGenerator::BuildVoxelMap(std::mt19937_64& rng)
+{
+  const G4ThreeVector dim = fHi - fLo; 
+  const double box_volume = dim.x()*dim.y()*dim.z(); 
+  if (box_volume <= 0. || fVoxelTargetCount == 0) return; 
+
+  const double side = std::cbrt(box_volume / fVoxelTargetCount); 
+  G4int nbins[3] = {1, 1, 1}; 
+  for (int i=0; i<3; i++) {
+    nbins[i] = std::clamp(static_cast<G4int>(std::ceil(dim[i] / side)), 1, 2000); 
+    fVoxelSize[i] = dim[i] / nbins[i]; 
+  }
+  const double half_diag = 0.5*fVoxelSize.mag(); 
+
+  for (G4int ix = 0; ix < nbins[0]; ix++) {
+    for (G4int iy = 0; iy < nbins[1]; iy++) {
+      for (G4int iz = 0; iz < nbins[2]; iz++) {
+        BulkVoxel_t voxel; 
+        voxel.fLow.set(
+            fLo.x() + ix*fVoxelSize.x(), 
+            fLo.y() + iy*fVoxelSize.y(), 
+            fLo.z() + iz*fVoxelSize.z()); 
+        const G4ThreeVector center = voxel.fLow + 0.5*fVoxelSize; 
+
+        const EInside in = fSolid->Inside(center); 
+        if (in == kOutside) {
+          if (fSolid->DistanceToIn(center) > half_diag) continue;
+        }
+        else if (in == kInside) {
+          voxel.fFullyInside = (fSolid->DistanceToOut(center) > half_diag); 
+        }
+        fVoxels.push_back( voxel ); 
+      }
+    }
+  }
+
+  if (fVoxels.empty()) return;
+
+  // estimate the acceptance of the voxelized sampling
+  std::uniform_real_distribution<double> flat(0., 1.); 
+  size_t n_inside = 0; 
+  for (size_t i=0; i<fAcceptanceSamples; i++) {
+    const auto& voxel = fVoxels[ 
+      std::min(fVoxels.size()-1, static_cast<size_t>(flat(rng)*fVoxels.size())) ]; 
+    if (voxel.fFullyInside) {n_inside++; continue;}
+    G4ThreeVector p(
+        voxel.fLow.x() + flat(rng)*fVoxelSize.x(), 
+        voxel.fLow.y() + flat(rng)*fVoxelSize.y(), 
+        voxel.fLow.z() + flat(rng)*fVoxelSize.z()); 
+    if (fSolid->Inside(p) != kOutside) n_inside++; 
+  }
+  fVoxelAcceptance = n_inside / static_cast<double>(fAcceptanceSamples); 
+
+  return;
+}
+
+void SLArBulkVertexGenerator::ShootLocalVertex(G4ThreeVector& localVertex, G4int& ntries)
+{
+  const G4int maxtries = 100000; 
+  ntries = 0; 
+
+  if (fSamplingMode == kVoxelized) {
+    const size_t nvoxels = fVoxels.size(); 
+    do {
+      ++ntries; 
+      const auto& voxel = fVoxels[ 
+        std::min(nvoxels-1, static_cast<size_t>(G4UniformRand()*nvoxels)) ]; 
+      localVertex.set(
+          voxel.fLow.x() + G4UniformRand()*fVoxelSize.x(),
+          voxel.fLow.y() + G4UniformRand()*fVoxelSize.y(),
+          voxel.fLow.z() + G4UniformRand()*fVoxelSize.z()); 
+      if (voxel.fFullyInside) return;
+    } while (fSolid->Inside(localVertex) == kOutside && ntries < maxtries);
+  }
+  else {
+    const G4ThreeVector dim = fHi - fLo; 
+    do {
+      ++ntries; 
+      localVertex.set(
+          fLo.x() + G4UniformRand()*dim.x(),
+          fLo.y() + G4UniformRand()*dim.y(),
+          fLo.z() + G4UniformRand()*dim.z());
+    } while (fSolid->Inside(localVertex) == kOutside && ntries < maxtries);
+  }
+
+  return;
+}
+ 
+void SLArBulkVertexGenerator::ShootVertex(G4ThreeVector & vertex_)
+{
+  // sample a random vertex inside the volume given by fVolumeName
   G4ThreeVector localVertex;
-  G4int maxtries=100000, itry=1;
-  do {
-    localVertex.set(
-        lo.x() + 0.5*delta + G4UniformRand()*(hi.x()-lo.x()-delta),
-        lo.y() + 0.5*delta + G4UniformRand()*(hi.y()-lo.y()-delta),
-        lo.z() + 0.5*delta + G4UniformRand()*(hi.z()-lo.z()-delta));
-  } while (!fSolid->Inside(localVertex) && ++itry < maxtries);
+  G4int ntries = 0; 
+  ShootLocalVertex(localVertex, ntries); 
 
   G4ThreeVector vtx = fBulkInverseRotation(localVertex) + fBulkTranslation;
   vertex_.set(vtx.x(), vtx.y(), vtx.z()); 
   fCounter++;
 }
 
+/**
+ * @details Shoot n_vertices with the active sampler and report the 
+ * generation rate together with a two-sample chi2 test of the vertex 
+ * occupancy of a coarse 4x4x4 grid against a reference sample obtained with 
+ * plain bounding-box rejection (independent engine). 
+ */
+void SLArBulkVertexGenerator::PrintSamplerReport(const size_t n_vertices)
+{
+  if (n_vertices == 0) return;
+
+  const int ncells = 4; 
+  const G4ThreeVector dim = fHi - fLo; 
+  auto cell_index = [&](const G4ThreeVector& p) {
+    int idx = 0; 
+    for (int i=0; i<3; i++) {
+      int ii = (dim[i] > 0) ? static_cast<int>( (p[i] - fLo[i]) / dim[i] * ncells ) : 0; 
+      idx = idx*ncells + std::clamp(ii, 0, ncells-1); 
+    }
+    return idx;
+  };
+
+  std::vector<double> observed(ncells*ncells*ncells, 0.); 
+  std::vector<double> reference(ncells*ncells*ncells, 0.); 
+
+  size_t total_tries = 0; 
+  G4ThreeVector localVertex; 
+  G4int ntries = 0; 
+  const auto t_start = std::chrono::steady_clock::now(); 
+  for (size_t i=0; i<n_vertices; i++) {
+    ShootLocalVertex(localVertex, ntries); 
+    total_tries += ntries; 
+    observed[cell_index(localVertex)] += 1; 
+  }
+  const auto t_end = std::chrono::steady_clock::now(); 
+  const double elapsed = std::chrono::duration<double>(t_end - t_start).count(); 
+
+  std::mt19937_64 rng(fRandomSeed + 1); 
+  std::uniform_real_distribution<double> flat(0., 1.); 
+  const size_t n_probes = std::min(
+      static_cast<size_t>(n_vertices / std::max(fAcceptance, 1e-4)), 100*n_vertices); 
+  double n_reference = 0.; 
+  for (size_t i=0; i<n_probes; i++) {
+    G4ThreeVector p(
+        fLo.x() + flat(rng)*dim.x(), 
+        fLo.y() + flat(rng)*dim.y(), 
+        fLo.z() + flat(rng)*dim.z()); 
+    if (fSolid->Inside(p) != kOutside) {
+      reference[cell_index(p)] += 1; 
+      n_reference += 1;
+    }
+  }
+
+  double chi2 = 0.; 
+  int ndf = -1; 
+  const double n_observed = n_vertices; 
+  for (size_t i=0; i<observed.size(); i++) {
+    const double& o = observed[i]; 
+    const double& r = reference[i]; 
+    if (o + r == 0) continue; 
+    if (n_reference == 0) break;
+    const double diff = o/n_observed - r/n_reference; 
+    chi2 += diff*diff / (o/(n_observed*n_observed) + r/(n_reference*n_reference)); 
+    ndf++; 
+  }
+
+  printf("SLArBulkVertexGenerator sampler report (%s):\n", fSolid->GetName().data()); 
+  printf("sampling mode: %s\n", fSamplingMode == kVoxelized ? "voxelized" : "box rejection"); 
+  printf("box acceptance: %g - sampler acceptance: %g\n", 
+      fAcceptance, n_vertices / static_cast<double>(total_tries)); 
+  printf("generated %lu vertexes in %g s: %g vertexes/s\n", 
+      n_vertices, elapsed, elapsed > 0 ? n_vertices / elapsed : 0.); 
+  printf("uniformity: chi2/ndf = %g/%i (reference sample: %g vertexes)\n\n", 
+      chi2, ndf, n_reference); 
+  return;
+}
+
+/**
+ * @details Compute the shrinking δ of the bounding box sides such that
+ * (A-δ)(B-δ)(C-δ) = f·ABC. The l.h.s. is monotonic in [0, min(A,B,C)], 
+ * so the root is found by bisection. 
+ */
 double SLArBulkVertexGenerator::ComputeDeltaX(
-    G4ThreeVector& lo, G4ThreeVector& hi, double fiducialf) {
-  if (fiducialf == 0) fiducialf = fFVFraction; 
+    const G4ThreeVector& lo, const G4ThreeVector& hi, double fiducialf) {
+  if (fiducialf <= 0) fiducialf = fFVFraction; 
+  if (fiducialf >= 1.0) return 0.;
 
-  double deltax = 0.; 
   double A = hi.x() - lo.x(); 
   double B = hi.y() - lo.y(); 
   double C = hi.z() - lo.z(); 
 
-  //printf("A: %g, B: %g, C: %g, f: %g\n", A, B, C, fiducialf);
-
-  double a = 1.0; 
-  double b = -1.0*(A+B+C); 
-  double c = (A*B + A*C + B*C); 
-  double d = -1.0*(A*B*C)*(1-fiducialf); 
-
-  double D0 = b*b - 3*a*c; 
-  double D1 = 2*b*b*b -9*a*b*c +27*a*a*d; 
-  double DD = std::cbrt(0.5*(D1 + std::sqrt(D1*D1 -4*D0*D0*D0)));
-
-  deltax = - (b + DD + D0/DD) / (3*a); 
-  //printf("deltax: %g\n", deltax); 
+  const double target = fiducialf*A*B*C; 
+  double x_lo = 0.; 
+  double x_hi = std::min({A, B, C}); 
+  for (int i=0; i<100 && (x_hi - x_lo) > 1e-3*fTolerance; i++) {
+    const double x = 0.5*(x_lo + x_hi); 
+    if ( (A-x)*(B-x)*(C-x) > target ) x_lo = x; 
+    else x_hi = x; 
+  }
 
-  return deltax; 
+  return 0.5*(x_lo + x_hi); 
 }
 
 void SLArBulkVertexGenerator::Config(const G4String& volumeName) {
@@ -173,6 +409,7 @@ void SLArBulkVertexGenerator::Config(const G4String& volumeName) {
   SetBulkLogicalVolume(volume->GetLogicalVolume()); 
   SetSolidTranslation(volume->GetTranslation()); 
   SetSolidRotation(volume->GetRotation()); 
+  BuildSampler(); 
   return;
 }
 
@@ -187,7 +424,17 @@ void SLArBulkVertexGenerator::Config(const rapidjson::Value& cfg) {
   if (cfg.HasMember("avoid_daughters")) {
     fNoDaughters = cfg["avoid_daughters"].GetBool();
   }
+  if (cfg.HasMember("voxel_threshold")) {
+    fVoxelThreshold = cfg["voxel_threshold"].GetDouble(); 
+  }
+  if (cfg.HasMember("voxel_count")) {
+    fVoxelTargetCount = cfg["voxel_count"].GetUint(); 
+  }
   Config(volName);
+
+  if (cfg.HasMember("sampler_report")) {
+    PrintSamplerReport( cfg["sampler_report"].GetUint() ); 
+  }
 }
 
 const rapidjson::Document SLArBulkVertexGenerator::ExportConfig() const {
@@ -204,6 +451,10 @@ const rapidjson::Document SLArBulkVertexGenerator::ExportConfig() const {
   vtx_info.AddMember("fiducial_volume_fraction", fFVFraction, vtx_info.GetAllocator()); 
   vtx_info.AddMember("cubic_volume", GetCubicVolumeGenerator(), vtx_info.GetAllocator()); 
   vtx_info.AddMember("mass", GetMassVolumeGenerator(), vtx_info.GetAllocator()); 
+  vtx_info.AddMember("sampling_mode", 
+      rapidjson::StringRef(fSamplingMode == kVoxelized ? "voxelized" : "box_rejection"), 
+      vtx_info.GetAllocator()); 
+  vtx_info.AddMember("box_acceptance", fAcceptance, vtx_info.GetAllocator()); 
   return vtx_info;
 }
 }
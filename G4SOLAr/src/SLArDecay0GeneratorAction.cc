@@ -5,6 +5,7 @@
  */
 
 #include "SLArDecay0GeneratorAction.hh"
+#include "SLArBulkVertexGenerator.hh"
 #include "SLArAnalysisManager.hh"
 
 // Standard library:
@@ -29,6 +30,8 @@
 #include <G4Alpha.hh>
 #include <G4SystemOfUnits.hh>
 #include <G4RunManager.hh>
+#include <G4Poisson.hh>
+#include <Randomize.hh>
 
 // This project:
 #include "SLArDecay0GeneratorMessenger.hh"
@@ -101,6 +104,20 @@ namespace bxdecay0_g4{
     return;
   }
 
+  void SLArDecay0GeneratorAction::PileUpConfig_t::print(std::ostream & out_, const std::string & indent_) const
+  {
+    out_ << indent_ << "Pile-up mode: \n";
+    out_ << indent_ << "|-- Enabled : " << std::boolalpha << enabled << "\n";
+    if (enabled) {
+      out_ << indent_ << "|-- Activity : " << activity / (CLHEP::becquerel/CLHEP::kg) << " Bq/kg\n";
+      out_ << indent_ << "|-- Mass : " << mass / CLHEP::kg << " kg\n";
+      out_ << indent_ << "|-- Time window : [" << time_offset / CLHEP::ms << ", " 
+        << (time_offset + time_window) / CLHEP::ms << "] ms\n";
+    }
+    out_ << indent_ << "`-- Expected decays per event : " << mean_decays << "\n";
+    return;
+  }
+
   bool SLArDecay0GeneratorAction::Decay0Config_t::is_valid_base() const
   {
     if (decay_category != "background" and decay_category != "dbd") {
@@ -425,6 +442,7 @@ namespace bxdecay0_g4{
     out_ << "Vertex generator : " << (fVtxGen ? "yes" : "no") << "\n";
     out_ << "Messenger : " << (_messenger_ ? "yes" : "no") << "\n";
     fConfig.print(out_);
+    fPileUp.print(out_);
     out_ << "Configuration has changed : " << std::boolalpha << _config_has_changed_ << "\n";
     out_ << "PIMPL : " << (_pimpl_ ? "yes" : "no") << "\n";
     if (_pimpl_ and _pimpl_->pdecay0) {
@@ -722,14 +740,24 @@ namespace bxdecay0_g4{
     if (IsTrace()) std::cerr << "[trace] bxdecay0_g4::SLArDecay0GeneratorAction::GeneratePrimaries: Entering..." << '\n';
     bxdecay0::event gendecay;
 
-    for (int iev = 0; iev < fConfig.n_decays; iev++) {
+    G4int n_decays = fConfig.n_decays; 
+    if (fPileUp.enabled) {
+      n_decays = G4Poisson( fPileUp.mean_decays ); 
+      if (IsInfo()) std::cerr << "[info] bxdecay0_g4::SLArDecay0GeneratorAction::GeneratePrimaries: pile-up of " << n_decays << " " << fConfig.nuclide << " decays\n";
+    }
+
+    for (int iev = 0; iev < n_decays; iev++) {
 
       //printf("Setting gendecay time to %g\n", _decaytime_);
       _pimpl_->get_decay0().shoot(_pimpl_->get_prng(), gendecay);
       double event_time = 0.0 * CLHEP::second;
       //Force event reference time to be zero (even if the generator tells something else):
+      double decay_time = _decaytime_; 
+      if (fPileUp.enabled) {
+        decay_time = (fPileUp.time_offset + G4UniformRand()*fPileUp.time_window) / CLHEP::second; 
+      }
 
-      gendecay.set_time(_decaytime_); 
+      gendecay.set_time(decay_time); 
       if (gendecay.has_time()) {
         event_time = gendecay.get_time() * CLHEP::second;
       }
@@ -821,10 +849,46 @@ namespace bxdecay0_g4{
       fVtxGen = std::make_unique<SLArPointVertexGenerator>();
     }
 
+    if (config.HasMember("pileup")) {
+      ConfigurePileUp( config["pileup"] ); 
+    }
+
     SetConfiguration(fConfig); 
     return;
   }
 
+  void SLArDecay0GeneratorAction::ConfigurePileUp(const rapidjson::Value& config) {
+    if (!config.HasMember("activity")) {
+      throw std::invalid_argument("decay0 pile-up requires \"activity\" field.\n"); 
+    }
+    if (!config.HasMember("time_window")) {
+      throw std::invalid_argument("decay0 pile-up requires \"time_window\" field.\n"); 
+    }
+
+    fPileUp.activity = unit::ParseJsonVal( config["activity"] ); 
+    fPileUp.time_window = unit::ParseJsonVal( config["time_window"] ); 
+    if (config.HasMember("time_offset")) {
+      fPileUp.time_offset = unit::ParseJsonVal( config["time_offset"] ); 
+    }
+
+    if (config.HasMember("mass")) {
+      fPileUp.mass = unit::ParseJsonVal( config["mass"] ); 
+    }
+    else {
+      auto bulk_gen = dynamic_cast<SLArBulkVertexGenerator*>(fVtxGen.get()); 
+      if (bulk_gen == nullptr) {
+        throw std::invalid_argument("decay0 pile-up requires a bulk vertex generator or an explicit \"mass\" field.\n"); 
+      }
+      fPileUp.mass = bulk_gen->GetMassVolumeGenerator() * bulk_gen->GetFiducialFraction(); 
+    }
+
+    fPileUp.mean_decays = fPileUp.activity * fPileUp.mass * fPileUp.time_window; 
+    fPileUp.enabled = true; 
+
+    if (IsInfo()) fPileUp.print(std::cerr, "[info] "); 
+    return;
+  }
+
   G4String SLArDecay0GeneratorAction::WriteConfig() const {
     G4String config_str = "";
 
@@ -838,6 +902,15 @@ namespace bxdecay0_g4{
     d.AddMember("type" , rapidjson::StringRef(gen_type.data()), d.GetAllocator()); 
     d.AddMember("label", rapidjson::StringRef(fLabel.data()), d.GetAllocator()); 
     d.AddMember("nuclide", rapidjson::StringRef(fConfig.nuclide.data()), d.GetAllocator()); 
+    if (fPileUp.enabled) {
+      rapidjson::Value jpileup(rapidjson::kObjectType); 
+      jpileup.AddMember("activity_Bq_kg", fPileUp.activity / (CLHEP::becquerel/CLHEP::kg), d.GetAllocator()); 
+      jpileup.AddMember("mass_kg", fPileUp.mass / CLHEP::kg, d.GetAllocator()); 
+      jpileup.AddMember("time_window_ns", fPileUp.time_window / CLHEP::ns, d.GetAllocator()); 
+      jpileup.AddMember("time_offset_ns", fPileUp.time_offset / CLHEP::ns, d.GetAllocator()); 
+      jpileup.AddMember("mean_decays", fPileUp.mean_decays, d.GetAllocator()); 
+      d.AddMember("pileup", jpileup, d.GetAllocator()); 
+    }
 
     const rapidjson::Document vtx_json = fVtxGen->ExportConfig(); 
     rapidjson::Value vtx_config;
@@ -12,6 +12,7 @@
 
 #include "SLArRunAction.hh"
 #include "SLArDetectorConstruction.hh"
+#include "SLArGeometryProfiler.hh"
 
 #include "detector/SLArBaseDetModule.hh"
 #include "detector/TPC/SLArDetTPC.hh"
@@ -24,6 +25,9 @@
 #include "detector/SuperCell/SLArDetSuperCellArray.hh"
 #include "detector/SuperCell/SLArSuperCellSD.hh"
 
+#include "physics/SLArOpticalFastSimModel.hh"
+#include "physics/SLArOpticalLookup.hh"
+
 #include "config/SLArCfgAnode.hh"
 #include "config/SLArCfgBaseSystem.hh"
 #include "config/SLArCfgReadoutTile.hh"
@@ -32,6 +36,7 @@
 #include "G4SubtractionSolid.hh"
 #include "G4LogicalBorderSurface.hh"
 #include "G4LogicalSkinSurface.hh"
+#include "G4OpticalSurface.hh"
 #include "G4Box.hh"
 #include "G4LogicalVolume.hh"
 #include "G4ThreeVector.hh"
@@ -42,6 +47,7 @@
 
 #include "G4SDManager.hh"
 #include "G4PhysicalVolumeStore.hh"
+#include "G4RegionStore.hh"
 #include "G4VSensitiveDetector.hh"
 #include "G4MultiFunctionalDetector.hh"
 #include "G4RunManager.hh"
@@ -53,6 +59,13 @@
 #include "G4UnitsTable.hh"
 
 #include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+
+#include "TROOT.h"
+#include "TH1.h"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -71,7 +84,9 @@ SLArDetectorConstruction::SLArDetectorConstruction(
    fSuperCell(nullptr),
    fWorldLog(nullptr), 
    fWorldPhys(nullptr), 
-   fCavernPhys(nullptr)
+   fCavernPhys(nullptr), 
+   fEarlyPDECulling(false), 
+   fPhotonSurvivalProb(1.0)
 { 
   fGeometryCfgFile = geometry_cfg_file; 
   fMaterialDBFile  = material_db_file; 
@@ -182,6 +197,17 @@ void SLArDetectorConstruction::Init() {
     G4cout << "SLArDetectorConstruction::Init Pix DONE" << G4endl;
   }
 
+  //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+  // Parse region definitions
+  if (d.HasMember("Regions")) {
+    assert(d["Regions"].IsArray()); 
+    for (const auto &jregion : d["Regions"].GetArray()) {
+      auto region_info = new SLArUserRegionInformation(); 
+      region_info->Configure(jregion); 
+      fRegionInfo.push_back( region_info ); 
+    }
+  }
+
   std::fclose(geo_cfg_file);
 }
 
@@ -503,13 +529,41 @@ G4VPhysicalVolume* SLArDetectorConstruction::Construct()
   visAttributes->SetColor(0.25,0.54,0.79, 0.0);
   fWorldLog->SetVisAttributes(visAttributes);
 
+  // 5. Create the regions with their own cuts and step limits
+  ConstructRegions(); 
+
+  // 6. Move the sensor detection efficiency to the photon creation
+  if (fEarlyPDECulling) ApplyEarlyPDECulling(); 
+
   
   SLArAnalysisManager::Instance()->CreateEventStructure();
+  SLArAnalysisManager::Instance()->GetTrackKillingRules().SetTarget(
+      G4ThreeVector(fDetector->GetGeoPar("det_pos_x"), 
+        fDetector->GetGeoPar("det_pos_y"), 
+        fDetector->GetGeoPar("det_pos_z")), 
+      0.5*G4ThreeVector(fDetector->GetGeoPar("det_x"), 
+        fDetector->GetGeoPar("det_y"), 
+        fDetector->GetGeoPar("det_z")) ); 
 
   //always return the physical World
   return fWorldPhys;
 }
 
+/**
+ * @details Create the G4Region objects declared in the "Regions" section 
+ * of the geometry configuration. Each region gets its own production cuts
+ * and user limits, while the region information is used by the stacking 
+ * action to drop the optical photons produced where optical physics is 
+ * disabled. 
+ */
+void SLArDetectorConstruction::ConstructRegions() {
+  for (auto &region_info : fRegionInfo) {
+    region_info->BuildRegion(); 
+    region_info->Print(); 
+  }
+  return;
+}
+
 /**
  * @details Create Sensitive Detector objects for the readout systems 
  * (SLArDetectorConstruction::fReadoutTile, SLArDetectorConstruction::fSuperCell), 
@@ -524,8 +578,10 @@ void SLArDetectorConstruction::ConstructSDandField()
   G4SDManager* SDman = G4SDManager::GetSDMpointer();
   G4String SDname;
 
-#ifndef SLAR_EXTERNAL
+  // in external background mode only the scorers are sensitive
   auto anaMngr = SLArAnalysisManager::Instance(); 
+  if (anaMngr->IsExternalMode()) return;
+
   if (anaMngr->GetPhysicsBiasingMap().size() > 0) {
     for (const auto &biasing : anaMngr->GetPhysicsBiasingMap() ) {
       auto xsecBias = new SLArCrossSectionBiasing(biasing.first, "biasing_"+biasing.first); 
@@ -538,11 +594,16 @@ void SLArDetectorConstruction::ConstructSDandField()
 
   //Set ReadoutTile SD
   if (fReadoutTile) {
-    G4VSensitiveDetector* sipmSD
+    SLArReadoutTileSD* sipmSD
       = new SLArReadoutTileSD(SDname="/tile/sipm");
     SDman->AddNewDetector(sipmSD);
     SetSensitiveDetector(
         fReadoutTile->GetSiPMActive()->GetModLV(), sipmSD );
+    for (const auto& anode : fAnodes) {
+      if (anode.second->IsFlatSensorPlane() == false) continue;
+      SetSensitiveDetector(anode.second->GetSensorPlane()->GetModLV(), sipmSD); 
+      sipmSD->RegisterFlatAnode(anode.first, anode.second->GetFlatSensorLayout()); 
+    }
   }
 
   //Set SuperCell SD
@@ -564,8 +625,16 @@ void SLArDetectorConstruction::ConstructSDandField()
     iTPC++; 
   }
 
-#endif
+  // Attach the fast optical transport to the regions requesting it
+  for (const auto& region_info : fRegionInfo) {
+    if (region_info->IsOpticalFastSimEnabled() == false) continue;
+    auto region = G4RegionStore::GetInstance()->GetRegion(region_info->GetName(), false); 
+    auto fast_model = new SLArOpticalFastSimModel(
+        "OpticalFastSim_"+region_info->GetName(), region); 
+    fast_model->SetHandoffDistance( region_info->GetOpticalHandoffDistance() ); 
+  }
 
+  return;
 }
 
 void SLArDetectorConstruction::AddExternalScorer(const G4String phys_volume_name, const G4String alias)
@@ -573,15 +642,16 @@ void SLArDetectorConstruction::AddExternalScorer(const G4String phys_volume_name
   // sensitive detectors 
   G4SDManager* SDman = G4SDManager::GetSDMpointer();
   G4String SDname;
-#ifdef SLAR_EXTERNAL
   auto external_scorer_pv = G4PhysicalVolumeStore::GetInstance()->GetVolume(phys_volume_name); 
   if (external_scorer_pv) {
     G4String ext_scorer_name = "/Ext/scorer/" + alias;
     printf("SLArDetectorConstruction::AddExternalScorer(): "); 
     printf("Making %s a scorer volume (%s)\n", phys_volume_name.data(), ext_scorer_name.data()); 
 
+    const G4int scorer_id = 
+      SLArAnalysisManager::Instance()->RegisterPhaseSpaceScorer( alias ); 
     auto ext_scorer_sd = 
-      new SLArExtScorerSD(ext_scorer_name); 
+      new SLArExtScorerSD(ext_scorer_name, scorer_id); 
     SDman->AddNewDetector(ext_scorer_sd); 
     SetSensitiveDetector(external_scorer_pv->GetLogicalVolume(), ext_scorer_sd); 
     auto runAction = (SLArRunAction*)G4RunManager::GetRunManager()->GetUserRunAction();
@@ -592,10 +662,6 @@ void SLArDetectorConstruction::AddExternalScorer(const G4String phys_volume_name
     printf("SLArDetectorConstruction::AddExternalScorer(): ERROR "); 
     printf("Unable to fond physical volume %s in physical volume store\n", phys_volume_name.data()); 
   }
-#else
-  G4cout << "SLArDetectorConstruction::AddExternalScorer WARNING: " << G4endl;
-  G4cout << "This method is active only when solar_sim is compiled with SLAR_EXTERNAL option, and this is not the case." << G4endl;
-#endif
 
   return;
 }
@@ -715,8 +781,13 @@ void SLArDetectorConstruction::BuildAndPlaceAnode() {
     auto anode_id = anode_.first; 
     anode->BuildMaterial(fMaterialDBFile); 
     printf("---- Building anode volume\n");
-    anode->BuildAnodeAssembly( 
-        fReadoutMegaTile.find(anode->GetTileAssemblyModel())->second );
+    auto megatile = fReadoutMegaTile.find(anode->GetTileAssemblyModel())->second; 
+    if (anode->IsFlatSensorPlane()) {
+      anode->BuildFlatAnodeAssembly( megatile, fReadoutTile ); 
+    }
+    else {
+      anode->BuildAnodeAssembly( megatile );
+    }
     auto pos = anode->GetPosition(); 
     auto rot = anode->GetRotation();
 
@@ -737,6 +808,112 @@ void SLArDetectorConstruction::BuildAndPlaceAnode() {
   ConstructAnodeMap(); 
 }
 
+/**
+ * @details Collect the optical surfaces of the photon sensors (anode SiPMs
+ * and SuperCell coating) and find the maximum detection efficiency p over
+ * all the sensors and wavelengths. The EFFICIENCY tables are then rescaled 
+ * by 1/p, while p is used by the stacking action as survival probability 
+ * of the optical photons at their creation, primary optical photons 
+ * included (see SLArStackingAction::ClassifyNewTrack): each photon reaching a sensor
+ * is detected with the same overall probability, but only a fraction p of
+ * the photons is tracked. 
+ */
+void SLArDetectorConstruction::ApplyEarlyPDECulling() {
+  if (fPhotonSurvivalProb < 1.0) return; // already applied
+
+  std::vector<G4MaterialPropertyVector*> efficiency; 
+  std::vector<G4LogicalSkinSurface*> skins; 
+  if (fReadoutTile) skins.push_back( fReadoutTile->GetSiPMLgSkin() ); 
+  if (fSuperCell) skins.push_back( fSuperCell->GetSiPMLgSkin() ); 
+
+  G4double max_pde = 0.0; 
+  for (const auto& skin : skins) {
+    if (skin == nullptr) continue;
+    auto surface = dynamic_cast<G4OpticalSurface*>(skin->GetSurfaceProperty()); 
+    if (surface == nullptr || surface->GetMaterialPropertiesTable() == nullptr) continue;
+    auto pde = surface->GetMaterialPropertiesTable()->GetProperty(kEFFICIENCY); 
+    if (pde == nullptr) continue;
+    // surfaces sharing the same optical surface are rescaled only once
+    if (std::find(efficiency.begin(), efficiency.end(), pde) != efficiency.end()) continue;
+    efficiency.push_back( pde ); 
+    max_pde = std::max(max_pde, pde->GetMaxValue()); 
+  }
+
+  if (max_pde <= 0.0 || max_pde >= 1.0) {
+    printf("SLArDetectorConstruction::ApplyEarlyPDECulling: max PDE = %g, no culling applied\n", 
+        max_pde);
+    return;
+  }
+
+  for (auto& pde : efficiency) pde->ScaleVector(1.0, 1.0/max_pde); 
+  fPhotonSurvivalProb = max_pde; 
+  printf("SLArDetectorConstruction::ApplyEarlyPDECulling: photon survival probability %g\n", 
+      fPhotonSurvivalProb);
+  return;
+}
+
+/**
+ * @details Probe rays are started in the LAr target volume, where most of 
+ * the tracking takes place. See SLArGeometryProfiler. 
+ */
+void SLArDetectorConstruction::ProfileGeometry(const G4int n_rays, const G4String& output) {
+  if (n_rays <= 0) {
+    printf("SLArDetectorConstruction::ProfileGeometry WARNING: invalid number of rays (%i)\n", n_rays); 
+    return;
+  }
+  SLArGeometryProfiler profiler(fWorldPhys); 
+  profiler.SetSamplingBox(
+      G4ThreeVector(fDetector->GetGeoPar("det_pos_x"), 
+        fDetector->GetGeoPar("det_pos_y"), 
+        fDetector->GetGeoPar("det_pos_z")), 
+      0.5*G4ThreeVector(fDetector->GetGeoPar("det_x"), 
+        fDetector->GetGeoPar("det_y"), 
+        fDetector->GetGeoPar("det_z")) ); 
+  profiler.Run(n_rays); 
+  profiler.Print(); 
+  profiler.Write(output); 
+  return;
+}
+
+/**
+ * @details The lookup is built from the readout configuration registered 
+ * in the analysis manager and from the optical properties of the LAr 
+ * target. The SuperCell and anode SiPM detection efficiencies are taken 
+ * from the corresponding optical surfaces, undoing the rescaling of the early PDE culling since 
+ * the photons handled by the lookup are not culled at creation. 
+ */
+SLArOpticalLookup* SLArDetectorConstruction::BuildOpticalLookup() const {
+  auto lookup = new SLArOpticalLookup( fDetector->GetModLV()->GetMaterial() ); 
+
+  auto ana_mgr = SLArAnalysisManager::Instance(); 
+  lookup->AddSuperCells( ana_mgr->GetPDSCfg() ); 
+  lookup->AddAnodes( ana_mgr->GetAnodeCfg() ); 
+
+  if (fSuperCell && fSuperCell->GetSiPMLgSkin()) {
+    auto surface = dynamic_cast<G4OpticalSurface*>(
+        fSuperCell->GetSiPMLgSkin()->GetSurfaceProperty()); 
+    if (surface && surface->GetMaterialPropertiesTable()) {
+      lookup->SetDetectionEfficiency( 
+          surface->GetMaterialPropertiesTable()->GetProperty(kEFFICIENCY), 
+          fPhotonSurvivalProb ); 
+    }
+  }
+
+  if (fReadoutTile && fReadoutTile->GetSiPMLgSkin()) {
+    auto surface = dynamic_cast<G4OpticalSurface*>(
+        fReadoutTile->GetSiPMLgSkin()->GetSurfaceProperty()); 
+    if (surface && surface->GetMaterialPropertiesTable()) {
+      lookup->SetTileDetectionEfficiency( 
+          surface->GetMaterialPropertiesTable()->GetProperty(kEFFICIENCY), 
+          fPhotonSurvivalProb ); 
+    }
+  }
+
+  printf("SLArDetectorConstruction::BuildOpticalLookup: %lu SuperCells and %lu megatiles registered\n", 
+      lookup->GetNumberOfSuperCells(), lookup->GetNumberOfMegaTiles()); 
+  return lookup;
+}
+
 void SLArDetectorConstruction::SetAnodeVisAttributes(const int depth) {
   fReadoutTile->SetVisAttributes(depth); 
   for (auto& mt : fReadoutMegaTile) {
@@ -746,10 +923,19 @@ void SLArDetectorConstruction::SetAnodeVisAttributes(const int depth) {
   return;
 }
 
+/**
+ * @details The readout maps of each anode (megatile, tile and pixel 
+ * TH2Poly) only depend on the anode configuration and on the readout tile
+ * geometry, which is only read at this stage. The maps of the different 
+ * anodes are therefore built concurrently on a small pool of threads, 
+ * each anode being handled by a single task so that the bin indices are 
+ * the same as in a serial build. 
+ */
 void SLArDetectorConstruction::ConstructAnodeMap() {
   printf("SLArDetectorConstruction::ConstructAnodeMap()\n");
   auto ana_mgr = SLArAnalysisManager::Instance(); 
 
+  std::vector<SLArCfgAnode*> anodes; 
   for (auto &anodeCfg_ : ana_mgr->GetAnodeCfg()) {
     auto& anodeCfg = anodeCfg_.second; 
     // access the first megatile to extract the map of the tiles 
@@ -764,55 +950,109 @@ void SLArDetectorConstruction::ConstructAnodeMap() {
     if (n_megatiles == 0) {
       printf("SLArDetectorConstruction::ConstructAnodeMap WARNING: Anode %i has no megatiles registered.\n", 
         anodeCfg.GetIdx()); 
-      return;
+      continue;
     }
-    
-    printf("getting front megatile\n"); 
-    SLArCfgMegaTile& mtileCfg = anodeCfg.GetMap().front(); 
-
-    printf("creating TH2Poly for a megatile...\n"); 
-    auto hMapMegaTile = anodeCfg.BuildPolyBinHist();
-    printf("mapMegaTile\n");
-    auto hMapTile     = mtileCfg.BuildPolyBinHist(
-        SLArCfgAssembly<SLArCfgReadoutTile>::ESubModuleReferenceFrame::kRelative); 
-    printf("mapTile\n");
-    G4RotationMatrix* mtile_rot = new G4RotationMatrix(
-        mtileCfg.GetPhi(), 
-        mtileCfg.GetTheta(), 
-        mtileCfg.GetPsi());
-    G4RotationMatrix* mtile_rot_inv = new G4RotationMatrix(*mtile_rot); 
-    mtile_rot_inv->invert(); // FIXME: Why do I need to use the inverse rotation????? 
-
-    auto hMapPixel = fReadoutTile->BuildTileChgPixelMap(
-        G4ThreeVector(anodeCfg.GetAxis0().x(), anodeCfg.GetAxis0().y(), anodeCfg.GetAxis0().z()), 
-        G4ThreeVector(anodeCfg.GetAxis1().x(), anodeCfg.GetAxis1().y(), anodeCfg.GetAxis1().z()), 
-        nullptr, mtile_rot_inv);
-    printf("mapPixel\n");
-
-    anodeCfg.RegisterMap(0, hMapMegaTile); 
-    anodeCfg.RegisterMap(1, hMapTile); 
-    anodeCfg.RegisterMap(2, hMapPixel); 
-
-    delete mtile_rot;
-    delete mtile_rot_inv; 
+    anodes.push_back( &anodeCfg ); 
+  }
+  if (anodes.empty()) return;
+
+  // the maps are owned by the anode configuration: keep them out of gDirectory
+  ROOT::EnableThreadSafety(); 
+  const Bool_t add_directory = TH1::AddDirectoryStatus(); 
+  TH1::AddDirectory(false); 
+
+  std::atomic<size_t> next_anode(0); 
+  auto worker = [&]() {
+    for (size_t i = next_anode++; i < anodes.size(); i = next_anode++) {
+      BuildAnodeMap( *anodes[i] ); 
+    }
+  }; 
+  const size_t n_workers = std::min<size_t>( anodes.size(), 
+      std::max(1u, std::thread::hardware_concurrency()) ); 
+  std::vector<std::future<void>> pool; 
+  for (size_t i = 0; i < n_workers; i++) {
+    pool.push_back( std::async(std::launch::async, worker) ); 
   }
 
+  std::exception_ptr error = nullptr; 
+  for (auto& task : pool) {
+    try { task.get(); }
+    catch (...) { if (!error) error = std::current_exception(); }
+  }
+  TH1::AddDirectory(add_directory); 
+  if (error) std::rethrow_exception(error); 
+
   printf("SLArDetectorConstruction::ConstructAnodeMap() DONE \n");
   return; 
 }
 
+void SLArDetectorConstruction::BuildAnodeMap(SLArCfgAnode& anodeCfg) {
+  SLArCfgMegaTile& mtileCfg = anodeCfg.GetMap().front(); 
+
+  auto hMapMegaTile = anodeCfg.BuildPolyBinHist();
+  auto hMapTile     = mtileCfg.BuildPolyBinHist(
+      SLArCfgAssembly<SLArCfgReadoutTile>::ESubModuleReferenceFrame::kRelative); 
+  G4RotationMatrix* mtile_rot = new G4RotationMatrix(
+      mtileCfg.GetPhi(), 
+      mtileCfg.GetTheta(), 
+      mtileCfg.GetPsi());
+  G4RotationMatrix* mtile_rot_inv = new G4RotationMatrix(*mtile_rot); 
+  mtile_rot_inv->invert(); // FIXME: Why do I need to use the inverse rotation????? 
+
+  auto hMapPixel = fReadoutTile->BuildTileChgPixelMap(
+      G4ThreeVector(anodeCfg.GetAxis0().x(), anodeCfg.GetAxis0().y(), anodeCfg.GetAxis0().z()), 
+      G4ThreeVector(anodeCfg.GetAxis1().x(), anodeCfg.GetAxis1().y(), anodeCfg.GetAxis1().z()), 
+      nullptr, mtile_rot_inv);
+  printf("%s: megatile, tile and pixel maps built\n", anodeCfg.GetName());
+
+  anodeCfg.RegisterMap(0, hMapMegaTile); 
+  anodeCfg.RegisterMap(1, hMapTile); 
+  anodeCfg.RegisterMap(2, hMapPixel); 
+
+  delete mtile_rot;
+  delete mtile_rot_inv; 
+  return;
+}
+
 G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
 
   printf("World volume ------------------------------------\n");
   G4IStore *istore = G4IStore::GetInstance();
   istore->SetWorldVolume(); 
 
+  // importances from the map produced by a pilot run override the default ones. 
+  // The cells are added from the outside in, so that the cells missing from 
+  // the map (never reached in the pilot run) can inherit the importance of 
+  // their mother volume instead of falling back to the default. 
+  const auto& imp_map = SLArAnalysisManager::Instance()->GetImportanceMap(); 
+  std::map<const G4LogicalVolume*, G4double> lv_importance; 
+  auto add_cell = [istore, &imp_map, &lv_importance](const G4double default_imp, const G4GeometryCell& cell) {
+    const auto& pv = cell.GetPhysicalVolume(); 
+    G4double cell_imp = default_imp; 
+    if (imp_map.HasCell(pv.GetName(), cell.GetReplicaNumber())) {
+      cell_imp = imp_map.GetImportance(pv.GetName(), cell.GetReplicaNumber(), default_imp); 
+      printf("%s (rep nr. %i): importance %g from importance map\n", 
+          pv.GetName().data(), cell.GetReplicaNumber(), cell_imp); 
+    }
+    else if (imp_map.IsLoaded()) {
+      const auto mother = lv_importance.find( pv.GetMotherLogical() ); 
+      if (mother != lv_importance.end()) {
+        cell_imp = std::max(default_imp, mother->second); 
+        printf("%s (rep nr. %i): importance %g from mother volume\n", 
+            pv.GetName().data(), cell.GetReplicaNumber(), cell_imp); 
+      }
+    }
+    // replicas of the same volume: keep the most important one 
+    auto& lv_imp = lv_importance[pv.GetLogicalVolume()]; 
+    lv_imp = std::max(lv_imp, cell_imp); 
+    istore->AddImportanceGeometryCell(cell_imp, cell); 
+  }; 
+
   G4double imp =1;
-  istore->AddImportanceGeometryCell(1, *fWorldPhys);
+  add_cell(1, G4GeometryCell(*fWorldPhys, 0));
   printf("\nCavern ----------------------------------------\n");
   printf("fCavern PV ptr: %p\n", static_cast<void*>(fCavernPhys));
-  istore->AddImportanceGeometryCell(
-      1, *fCavernPhys, fCavernPhys->GetCopyNo()); 
+  add_cell(1, G4GeometryCell(*fCavernPhys, fCavernPhys->GetCopyNo())); 
   size_t n_cavern_layers = fCavernPhys->GetLogicalVolume()->GetNoDaughters(); 
   for (int i = 0; i<n_cavern_layers; i++) {
     auto vol = fCavernPhys->GetLogicalVolume()->GetDaughter(i);
@@ -821,14 +1061,13 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
       printf("Adding %s to istore with importance %g (rep nr. %i, %p)\n", 
           cell.GetPhysicalVolume().GetName().data(), 
           imp, cell.GetReplicaNumber(), static_cast<void*>(vol) );
-      istore->AddImportanceGeometryCell(imp, cell); 
+      add_cell(imp, cell); 
     }
   }
 
   printf("\nCryostat ----------------------------------------\n");
   printf("fCryostat PV ptr: %p\n", static_cast<void*>(fCryostat->GetModPV())); 
-  istore->AddImportanceGeometryCell(
-      1, *(fCryostat->GetModPV()), fCryostat->GetModPV()->GetCopyNo());
+  add_cell(1, G4GeometryCell(*(fCryostat->GetModPV()), fCryostat->GetModPV()->GetCopyNo()));
 
   printf("Support structure\n");
   for (const auto &face_ : fCryostat->GetCryostatSupportStructure() ) {
@@ -838,7 +1077,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
       printf("SUPPORT FACE: Adding %s (rp nr %i) to istore with importance %g\n",
           cell.GetPhysicalVolume().GetName().data(),
           cell.GetReplicaNumber(), imp);              
-      istore->AddImportanceGeometryCell(imp, cell); 
+      add_cell(imp, cell); 
     }
     
     const auto pv = face->GetModLV()->GetDaughter(0); 
@@ -859,7 +1098,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
             vol_row->GetName().data(), imp, vol_row->GetCopyNo(), 
             static_cast<void*>(vol_row) );
 
-        istore->AddImportanceGeometryCell(imp, cell); 
+        add_cell(imp, cell); 
       }
     }
 
@@ -874,7 +1113,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
             vol_unit->GetName().data(), 
             vol_unit->GetLogicalVolume()->GetName().data(), 
             imp, iunit, static_cast<void*>(vol_unit));
-        istore->AddImportanceGeometryCell(imp, cell); 
+        add_cell(imp, cell); 
       }
 
     } // waffle row 
@@ -888,7 +1127,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
         printf("PATCH MODULE: Adding %s (rp nr %i) to istore with importance %g\n",
             cell.GetPhysicalVolume().GetName().data(), 
             cell.GetReplicaNumber(), imp);              
-        istore->AddImportanceGeometryCell(imp, cell);  
+        add_cell(imp, cell);  
 
         const auto ppv_patch = (G4PVParameterised*)lv_patch->GetDaughter(0); 
         
@@ -903,7 +1142,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
                   cell.GetPhysicalVolume().GetName().data(),
                   cell.GetReplicaNumber(), imp);              
 
-              istore->AddImportanceGeometryCell(imp, cell);  
+              add_cell(imp, cell);  
 
               for (int k=0; k<unit_lv->GetNoDaughters(); k++) {
                 const auto component_pv = unit_lv->GetDaughter(k); 
@@ -913,7 +1152,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
                       cell.GetPhysicalVolume().GetName().data(),
                       cell.GetReplicaNumber(), imp);              
 
-                  istore->AddImportanceGeometryCell(imp, cell);  
+                  add_cell(imp, cell);  
                 }
               }
             }
@@ -933,7 +1172,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
       printf("EDGE MODULE: Adding %s (rp nr %i) to istore with importance %g\n",
           cell.GetPhysicalVolume().GetName().data(),
           cell.GetReplicaNumber(), imp);              
-      istore->AddImportanceGeometryCell(imp, cell); 
+      add_cell(imp, cell); 
 
       const auto repl = get_plane_replication_data(static_cast<G4PVParameterised*>(edge_ppv)); 
       for (int k=0; k<repl.fNreplica; k++) {
@@ -942,7 +1181,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
           printf("EDGE UNIT: Adding %s (rp nr %i) to istore with importance %g\n",
               cell.GetPhysicalVolume().GetName().data(),
               cell.GetReplicaNumber(), imp);              
-          istore->AddImportanceGeometryCell(imp, cell); 
+          add_cell(imp, cell); 
         }
       }
     }
@@ -961,7 +1200,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
       printf("Adding %s to istore with importance %g (rep nr. %i, %p)\n", 
           cell.GetPhysicalVolume().GetName().data(), 
           imp, cell.GetReplicaNumber(), static_cast<void*>(vol) );
-      istore->AddImportanceGeometryCell(imp, cell); 
+      add_cell(imp, cell); 
     }
   }
 
@@ -975,7 +1214,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
       printf("Adding %s to istore with importance %g (rep nr. %i, %p)\n", 
           cell.GetPhysicalVolume().GetName().data(), 
           imp, cell.GetReplicaNumber(), static_cast<void*>(vol) );
-      istore->AddImportanceGeometryCell(imp, cell); 
+      add_cell(imp, cell); 
     }
   }
 
@@ -987,22 +1226,21 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
       const auto vol = layer.second->fModule->GetModPV();
       G4cout << "Going to assign importance: " << imp << ", to volume: " 
              << vol->GetName() << " rep nr: " << vol->GetCopyNo() << G4endl;
-      istore->AddImportanceGeometryCell(imp, *vol, vol->GetCopyNo());
+      add_cell(imp, G4GeometryCell(*vol, vol->GetCopyNo()));
   }
 
   // the remaining part pf the geometry (rest) gets the same
   // importance as the innermost cryostat layer
   //
   printf("\nActive volume -----------------------------------\n");
-  istore->AddImportanceGeometryCell(
-      imp,*fDetector->GetModPV(), fDetector->GetModPV()->GetCopyNo());
+  add_cell(imp, G4GeometryCell(*fDetector->GetModPV(), fDetector->GetModPV()->GetCopyNo()));
   for (int i=0; i<fDetector->GetModLV()->GetNoDaughters(); i++) {
     auto vol = fDetector->GetModLV()->GetDaughter(i); 
     auto cell = G4GeometryCell(*vol, vol->GetCopyNo()); 
     if (istore->IsKnown(cell) == false) {
       printf("Adding %s (replica nr %i) to istore with importance %g\n", 
           cell.GetPhysicalVolume().GetName().data(), cell.GetReplicaNumber(), imp);
-      istore->AddImportanceGeometryCell(imp, cell); 
+      add_cell(imp, cell); 
     }
   }
 
@@ -1018,7 +1256,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
       if (istore->IsKnown(cell) == false) {
         printf("Adding %s (replica nr %i) to istore with importance %g\n", 
             cell.GetPhysicalVolume().GetName().data(), cell.GetReplicaNumber(), imp);
-        istore->AddImportanceGeometryCell(imp, cell); 
+        add_cell(imp, cell); 
       }
 
       auto fc_repl = get_plane_replication_data((G4PVParameterised*)field_cage_vol); 
@@ -1028,7 +1266,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
           printf("Adding %s with Replica nr %i\n", 
               cell.GetPhysicalVolume().GetName().data(), i);
 
-          istore->AddImportanceGeometryCell(imp, cell); 
+          add_cell(imp, cell); 
         }
       }
 
@@ -1038,7 +1276,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
         if (istore->IsKnown(cell) == false) {
           printf("Adding %s (rp nr %i) to istore with importance %g\n", 
               vol->GetName().data(), vol->GetCopyNo(), imp);
-          istore->AddImportanceGeometryCell(imp, cell); 
+          add_cell(imp, cell); 
         }
       }
     }
@@ -1052,6 +1290,15 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
     }
     printf("\nAnode -----------------------------------------\n");
     auto anode_vol = anode->GetModLV()->GetDaughter(0); 
+    if (anode->IsFlatSensorPlane()) {
+      auto cell = G4GeometryCell(*anode_vol, anode_vol->GetCopyNo()); 
+      if (istore->IsKnown(cell) == false) {
+        printf("Adding %s to istore with importance %g\n", 
+            anode_vol->GetName().data(), imp);
+        add_cell(imp, cell); 
+      }
+      continue;
+    }
     auto mt_row = anode->GetTileAssemblyRow(); 
     auto mt_row_vol = mt_row->GetModLV()->GetDaughter(0); 
     for (int i=0; i<anode_vol->GetLogicalVolume()->GetNoDaughters(); i++) {
@@ -1062,7 +1309,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
         if (istore->IsKnown(cell) == false) {
           printf("Adding %s (rp nr %i) to istore with importance %g\n",
               vol->GetName().data(), j, imp);
-          istore->AddImportanceGeometryCell(imp, cell);
+          add_cell(imp, cell);
         }
 
         auto vol_mt = vol->GetLogicalVolume()->GetDaughter(0); 
@@ -1073,7 +1320,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
             printf("MT MODULE: Adding %s (rp nr %i) to istore with importance %g\n",
                 cell.GetPhysicalVolume().GetName().data(), 
                 cell.GetReplicaNumber(), imp);              
-            istore->AddImportanceGeometryCell(imp, cell); 
+            add_cell(imp, cell); 
           }
         }
       }
@@ -1098,7 +1345,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
       printf("TILE ROW: Adding %s (rp nr %i) to istore with importance %g\n",
           cell.GetPhysicalVolume().GetName().data(), 
           cell.GetReplicaNumber(), imp);              
-      istore->AddImportanceGeometryCell(imp, cell); 
+      add_cell(imp, cell); 
     }
   }
 
@@ -1108,21 +1355,21 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
       printf("TILE MODULE: Adding %s (rp nr %i) to istore with importance %g\n",
           cell.GetPhysicalVolume().GetName().data(), 
           cell.GetReplicaNumber(), imp);              
-      istore->AddImportanceGeometryCell(imp, cell); 
+      add_cell(imp, cell); 
     }
     cell = G4GeometryCell(*base_vol, base_vol->GetCopyNo()); 
     if (istore->IsKnown(cell) == false) {
       printf("TILE MODULE: Adding %s (rp nr %i) to istore with importance %g\n",
           cell.GetPhysicalVolume().GetName().data(), 
           cell.GetReplicaNumber(), imp);              
-      istore->AddImportanceGeometryCell(imp, cell); 
+      add_cell(imp, cell); 
     }
     cell = G4GeometryCell(*sensor_vol, sensor_vol->GetCopyNo()); 
     if (istore->IsKnown(cell) == false) {
       printf("TILE MODULE: Adding %s (rp nr %i) to istore with importance %g\n",
           cell.GetPhysicalVolume().GetName().data(), 
           cell.GetReplicaNumber(), imp);              
-      istore->AddImportanceGeometryCell(imp, cell); 
+      add_cell(imp, cell); 
     }
   }
 
@@ -1135,7 +1382,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
       printf("CELL ROW: Adding %s (rp nr %i) to istore with importance %g\n",
           cell.GetPhysicalVolume().GetName().data(), 
           cell.GetReplicaNumber(), imp);              
-      istore->AddImportanceGeometryCell(imp, cell); 
+      add_cell(imp, cell); 
     }
   }
 
@@ -1149,7 +1396,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
         printf("CELL MODULE: Adding %s (rp nr %i) to istore with importance %g\n",
             cell.GetPhysicalVolume().GetName().data(), 
             cell.GetReplicaNumber(), imp);              
-        istore->AddImportanceGeometryCell(imp, cell); 
+        add_cell(imp, cell); 
       }
 
       if (vol->GetLogicalVolume()->GetNoDaughters() > 0) {
@@ -1160,7 +1407,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
             printf("CELL SUBVOLUME: Adding %s (rp nr %i) to istore with importance %g\n",
                 cell.GetPhysicalVolume().GetName().data(), 
                 cell.GetReplicaNumber(), imp);              
-            istore->AddImportanceGeometryCell(imp, cell); 
+            add_cell(imp, cell); 
           }
         }
 
@@ -1179,7 +1426,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
     if (istore->IsKnown(cell) == false) {
       printf("Adding %s (rp nr %i) to istore with importance %g\n",
           cell.GetPhysicalVolume().GetName().data(), cell.GetReplicaNumber(), imp);
-      istore->AddImportanceGeometryCell(imp, cell); 
+      add_cell(imp, cell); 
     }
 
     auto row_vol = (G4PVParameterised*)pdsplane->GetModLV()->GetDaughter(0); 
@@ -1190,7 +1437,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
       if (istore->IsKnown(cell) == false) {
         printf("SC ROW: Adding %s (rp nr %i) to istore with importance %g\n",
             cell.GetPhysicalVolume().GetName().data(), cell.GetReplicaNumber(), imp);
-        istore->AddImportanceGeometryCell(imp, cell); 
+        add_cell(imp, cell); 
       }
 
       auto sc_vol = row_vol->GetLogicalVolume()->GetDaughter(0); 
@@ -1204,7 +1451,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
           printf("SC MODULE: Adding %s (rp nr %i) to istore with importance %g\n",
               cell.GetPhysicalVolume().GetName().data(), 
               cell.GetReplicaNumber(), imp); 
-          istore->AddImportanceGeometryCell(imp, cell); 
+          add_cell(imp, cell); 
         }
       }
     }
@@ -1216,7 +1463,7 @@ G4VIStore* SLArDetectorConstruction::CreateImportanceStore() {
         printf("SC OBJECT: Adding %s (rp nr %i) to istore with importance %g\n",
             cell.GetPhysicalVolume().GetName().data(), 
             cell.GetReplicaNumber(), imp); 
-        istore->AddImportanceGeometryCell(imp, cell); 
+        add_cell(imp, cell); 
       }
     }
     
@@ -26,7 +26,9 @@
 #include <G4UnitsTable.hh>
 
 #include "G4ios.hh"
+#include "Randomize.hh"
 #include <cstdio>
+#include <algorithm>
 
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -81,7 +83,6 @@ void SLArEventAction::BeginOfEventAction(const G4Event*)
     }
   }
 
-  #ifdef SLAR_EXTERNAL
   if (fExtScorerHCollID.empty()) {
     auto& ext_scorer_list = detConstruction->GetVecExtScorerPV();
     for (const auto& scorer_pv : ext_scorer_list) {
@@ -95,7 +96,6 @@ void SLArEventAction::BeginOfEventAction(const G4Event*)
       }
     }
   }
-  #endif // DEBUG
 
 #ifdef SLAR_DEBUG
     G4cout << "SLArEventAction::BeginOfEventAction():" << G4endl;
@@ -165,31 +165,56 @@ void SLArEventAction::EndOfEventAction(const G4Event* event)
       primary.SetTotalScintPhotons( nph ); 
     }
 
-#ifndef SLAR_EXTERNAL
-    //RecordEventLAr( event );
+    if (SLArAnaMgr->IsExternalMode() == false) {
+      //RecordEventLAr( event );
 
-    if ( !SLArAnaMgr->GetAnodeCfg().empty() ) {
-      RecordEventReadoutTile ( event, verbose );
-    }
+      if ( !SLArAnaMgr->GetAnodeCfg().empty() ) {
+        RecordEventReadoutTile ( event, verbose );
+      }
 
-    if (verbose > 1) printf("Recording SuperCell hits...\n");
-    RecordEventSuperCell( event, verbose );
-    if (verbose > 1) printf("DONE\n");
+      if (verbose > 1) printf("Recording SuperCell hits...\n");
+      RecordEventSuperCell( event, verbose );
+      if (verbose > 1) printf("DONE\n");
      
-    // apply zero suppression to charge signal
-    for (auto &evAnode : slar_event.GetEventAnode()) {
-      short thrs = evAnode.second.GetZeroSuppressionThreshold(); 
-      if (thrs > 0) {
-        evAnode.second.ApplyZeroSuppression();
+      // apply zero suppression to charge signal
+      auto bkt_charge = SLArAnaMgr->GetBacktrackerManager( backtracker::kCharge ); 
+      auto bkt_eval = [bkt_charge](const SLArEventChargeHit& hit, const UShort_t n, 
+          SLArEventBacktrackerVector& records) {
+        if (bkt_charge == nullptr || bkt_charge->IsNull()) return;
+        SLArEventChargeHit bkt_hit(hit); 
+        for (size_t ib = 0; ib < bkt_charge->GetBacktrackers().size(); ib++) {
+          bkt_charge->GetBacktrackers().at(ib)->Eval(&bkt_hit, &records.GetRecords().at(ib), n);
+        }
+      };
+
+      // emulate the pixel front-end on the raw (not zero-suppressed) ticks
+      if (SLArAnaMgr->IsPixelFrontEndEnabled()) {
+        SLArAnaMgr->GetPixelFrontEnd().SetSeed( 
+            CLHEP::RandFlat::shootInt( static_cast<long>(1e9) ) + 1 ); 
+        G4int n_packets = SLArAnaMgr->ProcessPixelFrontEnd(); 
+        if (verbose > 1) printf("Pixel front-end: %i packets\n", n_packets);
+      }
+
+      for (auto &evAnode : slar_event.GetEventAnode()) {
+        if (evAnode.second.IsStagingChargeHits()) {
+          evAnode.second.FlushStagedChargeHits( bkt_eval ); 
+        }
+        else if (evAnode.second.GetZeroSuppressionThreshold() > 0) {
+          evAnode.second.ApplyZeroSuppression();
+        }
+      }
+
+      if (SLArAnaMgr->IsPixelFrontEndEnabled() && SLArAnaMgr->DropRawChargeTicks()) {
+        SLArAnaMgr->ClearRawChargeTicks(); 
       }
     }
-    #else
+
     G4int ext_scorer_hits = RecordEventExtScorer( event, verbose ); 
 
-    for (auto &primary : primaries) {
-      if (ext_scorer_hits == 0) primary.GetTrajectories().clear(); 
+    // in external mode keep only the trajectories of the events reaching the scorers
+    if (SLArAnaMgr->IsExternalMode() && ext_scorer_hits == 0) {
+      for (auto &primary : primaries) primary.GetTrajectories().clear(); 
     }
-#endif 
     
     SLArAnaMgr->FillEvTree();
 
@@ -216,7 +241,7 @@ void SLArEventAction::EndOfEventAction(const G4Event* event)
       }
     }
 
-    fParentIDMap.clear(); 
+    fAncestorIDs.clear(); 
     fExtraProcessInfo.clear(); 
 
     SLArAnaMgr->GetEvent().Reset();
@@ -447,8 +472,8 @@ G4int SLArEventAction::RecordEventExtScorer(const G4Event* ev, const G4int& verb
   if (fExtScorerHCollID.empty()) return 0;
 
   G4int n_hits = 0; 
-#ifdef SLAR_EXTERNAL
   auto anaMngr = SLArAnalysisManager::Instance(); 
+  auto externals_tree = anaMngr->GetExternalsTree(); 
   for (const auto& id : fExtScorerHCollID) {
     SLArExtHitsCollection* hHC1 = static_cast<SLArExtHitsCollection*>(hce->GetHC(id)); 
     if (verbose > 1) printf("SLArExtHitsCollection hce[%i] = %p\n", id, static_cast<void*>(hHC1)); 
@@ -463,6 +488,24 @@ G4int SLArEventAction::RecordEventExtScorer(const G4Event* ev, const G4int& verb
       SLArExtHit* scorer_hit = (*hHC1)[i];   
       //printf("recording scorer hit:\n"); 
       //scorer_hit->Print(); 
+      auto& ps_record = anaMngr->GetPhaseSpaceRecord(); 
+      ps_record.fEvNumber = ev->GetEventID(); 
+      ps_record.fPDGCode = scorer_hit->fPDGCode; 
+      ps_record.fScorerID = scorer_hit->fScorerID; 
+      ps_record.fX = scorer_hit->fEntryVertex[0]; 
+      ps_record.fY = scorer_hit->fEntryVertex[1]; 
+      ps_record.fZ = scorer_hit->fEntryVertex[2]; 
+      ps_record.fUx = scorer_hit->fEntryDir[0]; 
+      ps_record.fUy = scorer_hit->fEntryDir[1]; 
+      ps_record.fUz = scorer_hit->fEntryDir[2]; 
+      ps_record.fEnergy = scorer_hit->fEntryEnergy; 
+      ps_record.fTime = scorer_hit->fEntryTime; 
+      ps_record.fWeight = scorer_hit->fEntryWeight; 
+      anaMngr->FillPhaseSpaceTree(); 
+      n_hits++; 
+
+      if (externals_tree == nullptr) continue;
+
       auto& ext_record = anaMngr->GetExternalRecord();
       ext_record.Reset(); 
       ext_record.SetEvNumber( ev->GetEventID() ); 
@@ -478,18 +521,29 @@ G4int SLArEventAction::RecordEventExtScorer(const G4Event* ev, const G4int& verb
       ext_record.SetOriginVol( scorer_hit->fOriginVol ); 
       ext_record.SetOriginVertex( scorer_hit->fOriginVertex ); 
 
-      anaMngr->GetExternalsTree()->Fill(); 
-      n_hits++; 
+      externals_tree->Fill(); 
     }
   }
 
-#endif
-
   return n_hits;
 }
 
+/**
+ * @details Tracks are always classified after their parent, so the primary 
+ * ancestor of a new track is inherited from its parent when the track is 
+ * registered. Primary tracks (trk_id == p_id) are their own ancestor. 
+ */
 void SLArEventAction::RegisterNewTrackPID(int trk_id, int p_id) {
-  fParentIDMap.insert( std::make_pair(trk_id, p_id) ); 
+  if (trk_id < 0) return;
+  if (static_cast<size_t>(trk_id) >= fAncestorIDs.size()) {
+    fAncestorIDs.resize( std::max<size_t>(2*fAncestorIDs.size(), trk_id+1), -1 ); 
+  }
+
+  int ancestor = p_id; 
+  if (trk_id != p_id && p_id >= 0 && static_cast<size_t>(p_id) < fAncestorIDs.size()) {
+    if (fAncestorIDs[p_id] >= 0) ancestor = fAncestorIDs[p_id]; 
+  }
+  fAncestorIDs[trk_id] = ancestor; 
   return;
 }
 
@@ -508,49 +562,14 @@ void SLArEventAction::RegisterNewProcessExtraInfo(const TrackIdHelpInfo_t& trkHe
 
 
 int SLArEventAction::FindAncestorID(int trkid) {
-  int primary = -1; 
-  int pid = trkid; 
-
-  SLArAnalysisManager* anaMngr = SLArAnalysisManager::Instance(); 
-  auto& primaries = anaMngr->GetEvent().GetPrimaries(); 
-  bool caught = false; 
-//#ifdef SLAR_DEBUG
-  //printf("SLArEventAction::FindAncestorID() Lookging for primary parent of %i among\n", trkid);
-  //for (const auto& _pid : fParentIDMap) {
-    //printf("%i - PID: %i\n", _pid.first, _pid.second); 
-  //}
-
-  //printf("\nList of primaries: \n");
-  //for (const SLArMCPrimaryInfo& p : primaries) {
-    //printf("%s - PID: %i\n", p.GetParticleName().Data(), p.GetTrackID());
-  //}
-//#endif
-
-  while ( !caught ) {
-    pid = fParentIDMap[trkid];
+  if (trkid < 0 || static_cast<size_t>(trkid) >= fAncestorIDs.size()) {
 #ifdef SLAR_DEBUG
-    printf("local parent id: %i\n", pid);
+    printf("SLArEventAction::FindAncestorID() WARNING: track %i was not registered\n", trkid);
 #endif
-
-    for (const auto& p : primaries) {
-      if (pid == p.GetTrackID()) {
-        primary = pid; 
-        caught = true;
-      }
-    }
-
-    trkid = pid; 
-//#ifdef SLAR_DEBUG
-    //getchar(); 
-//#endif
+    return -1;
   }
 
-//#ifdef SLAR_DEBUG
-    //printf("Caught! returning %i\n", primary);
-    ////getchar(); 
-//#endif
-
-  return primary; 
+  return fAncestorIDs[trkid]; 
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -19,7 +19,6 @@
 #include <rapidjson/prettywriter.h>
 
 #include <TFile.h>
-#include <TRandom3.h>
 
 #include "G4RandomTools.hh"
 #include "G4Poisson.hh"
@@ -32,7 +31,6 @@ SLArExternalGeneratorAction::SLArExternalGeneratorAction(const G4String label)
   : SLArBaseGenerator(label)
 {
   fParticleGun = std::make_unique<G4ParticleGun>(); 
-  fRandomEngine = std::make_unique<TRandom3>( G4Random::getTheSeed() ); 
 }
 
 SLArExternalGeneratorAction::~SLArExternalGeneratorAction()
@@ -100,27 +98,25 @@ void SLArExternalGeneratorAction::GeneratePrimaries(G4Event* ev)
   printf("SLArExternalGeneratorAction::GeneratePrimaries\n");
 #endif
   
+  auto surface_vtx_gen = dynamic_cast<SLArBoxSurfaceVertexGenerator*>(fVtxGen.get()); 
+  const G4bool cosine_law = (fConfig.angular_distribution == "cosine"); 
+
   for (size_t iev = 0; iev < fConfig.n_particles; iev++) {
     G4ThreeVector vtx_pos(0, 0, 0); 
     fVtxGen->ShootVertex(vtx_pos);
 
-    //printf("Energy spectrum pointer: %p\n", fEnergySpectrum.get());
-    //printf("Energy spectrum from %s\n", fEnergySpectrum->GetName());
-    G4double energy = fEnergySpectrum->GetRandom( fRandomEngine.get() ); 
-
-
-    G4ThreeVector dir = SampleRandomDirection(); 
+    G4double energy = fConfig.ext_particle_energy; 
+    if (fEnergySampler.IsEmpty() == false) energy = fEnergySampler.Sample(); 
 
-    if (dynamic_cast<SLArBoxSurfaceVertexGenerator*>(fVtxGen.get())) {
-      auto face = static_cast<SLArBoxSurfaceVertexGenerator*>(fVtxGen.get())->GetVertexFace(); 
-      const auto& face_normal = geo::BoxFaceNormal[face]; 
-      //printf("SLArExternalGeneratorAction: vtx face is %i\n", face);
-      //printf("SLArExternalGeneratorAction: face normal is [%.1f, %.1f, %.1f]\n", 
-      //face_normal.x(), face_normal.y(), face_normal.z()); 
-
-      while ( dir.dot(face_normal) < 0 ) {
-        dir = SampleRandomDirection(); 
-      }
+    G4ThreeVector dir; 
+    if (surface_vtx_gen) {
+      // inward direction from the vertex face
+      const auto face_normal = surface_vtx_gen->GetVertexFaceNormal(); 
+      dir = (cosine_law) ? 
+        SampleCosineDirection(face_normal) : SampleHemisphereDirection(face_normal); 
+    }
+    else {
+      dir = SampleRandomDirection(); 
     }
 
     //G4cout << "Momentum direction is: " << dir << G4endl; 
@@ -155,17 +151,30 @@ void SLArExternalGeneratorAction::Configure(const rapidjson::Value& config) {
     if (config.HasMember("energy_spectrum_key")) {
       fConfig.ext_spectrum_key = config["energy_spectrum_key"].GetString(); 
     }
+  } else if (config.HasMember("energy_distribution")) {
+    fEnergySampler.Configure( config["energy_distribution"] ); 
   } else if (config.HasMember("energy")) {
     fConfig.ext_particle_energy = unit::ParseJsonVal( config["energy"] ); 
   } else {
     fConfig.ext_particle_energy = 1.0; 
   }
 
+  if (config.HasMember("angular_distribution")) {
+    fConfig.angular_distribution = config["angular_distribution"].GetString(); 
+    if (fConfig.angular_distribution != "cosine" && 
+        fConfig.angular_distribution != "isotropic") {
+      char err_msg[200]; 
+      sprintf(err_msg, "SLArExternalGeneratorAction::Configure ERROR\nUnknown angular distribution %s (use \"cosine\" or \"isotropic\").\n", 
+          fConfig.angular_distribution.data()); 
+      throw std::invalid_argument(err_msg);
+    }
+  }
+
   if (config.HasMember("vertex_gen")) {
     ConfigureVertexGenerator( config["vertex_gen"] ); 
   }
 
-  if (fConfig.ext_spectrum_path) {
+  if (fConfig.ext_spectrum_path.empty() == false) {
     TFile input_file(fConfig.ext_spectrum_path); 
     if (input_file.IsOpen() == false) {
       char err_msg[200]; 
@@ -173,16 +182,18 @@ void SLArExternalGeneratorAction::Configure(const rapidjson::Value& config) {
       throw std::runtime_error(err_msg);
     }
     TH1D* h = input_file.Get<TH1D>(fConfig.ext_spectrum_key); 
-    h->SetDirectory( nullptr ); 
-    input_file.Close(); 
-
-    fEnergySpectrum = std::make_unique<TH1D>( *h ); 
-    if (!fEnergySpectrum) {
+    if (!h) {
       char err_msg[200]; 
       sprintf(err_msg,"SLArExternalGeneratorAction::SourceExternalConfig ERROR\nCannot read key %s from external background file %s.\n", 
           fConfig.ext_spectrum_key.data(), fConfig.ext_spectrum_path.data() ); 
       throw std::runtime_error( err_msg ); 
     }
+    h->SetDirectory( nullptr ); 
+    input_file.Close(); 
+
+    fEnergySpectrum = std::make_unique<TH1D>( *h ); 
+    fEnergySampler.BuildFromHistogram( fEnergySpectrum.get() ); 
+    delete h; 
   }
 
   return;
@@ -201,12 +212,15 @@ G4String SLArExternalGeneratorAction::WriteConfig() const {
   d.AddMember("label", rapidjson::StringRef(fLabel.data()), d.GetAllocator()); 
   d.AddMember("particle", rapidjson::StringRef(fConfig.ext_primary_particle.data()), d.GetAllocator()); 
   d.AddMember("n_particles", fConfig.n_particles, d.GetAllocator()); 
-  if (fConfig.ext_spectrum_path.empty()) {
-    d.AddMember("energy", rapidjson::StringRef(fEnergySpectrum->GetName()), d.GetAllocator()); 
+  if (fConfig.ext_spectrum_path.empty() && fEnergySampler.IsEmpty()) {
+    d.AddMember("energy", fConfig.ext_particle_energy, d.GetAllocator()); 
+  } else if (fConfig.ext_spectrum_path.empty()) {
+    d.AddMember("energy_distribution", fEnergySampler.ExportConfig(d.GetAllocator()), d.GetAllocator()); 
   } else {
     d.AddMember("energy_spectrum_key", rapidjson::StringRef(fConfig.ext_spectrum_key.data()), d.GetAllocator());
     d.AddMember("energy_spectrum_file", rapidjson::StringRef(fConfig.ext_spectrum_path.data()), d.GetAllocator());
   }
+  d.AddMember("angular_distribution", rapidjson::StringRef(fConfig.angular_distribution.data()), d.GetAllocator()); 
   const rapidjson::Document vtx_json = fVtxGen->ExportConfig(); 
   rapidjson::Value vtx_config;
   vtx_config.CopyFrom(vtx_json, d.GetAllocator()); 
@@ -0,0 +1,176 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArGeometryProfiler.cc
+ * @created     Tuesday Oct 20, 2026 12:18:52 CEST
+ */
+
+#include <cstdio>
+#include <chrono>
+#include <algorithm>
+
+#include "rapidjson/document.h"
+#include "rapidjson/filewritestream.h"
+#include "rapidjson/prettywriter.h"
+
+#include "SLArGeometryProfiler.hh"
+#include "SLArRandomExtra.hh"
+
+#include "G4Navigator.hh"
+#include "G4GeometryManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4SmartVoxelHeader.hh"
+#include "Randomize.hh"
+
+SLArGeometryProfiler::SLArGeometryProfiler(G4VPhysicalVolume* world)
+  : fWorld(world), fBoxCenter(0, 0, 0), fBoxHalfSize(0, 0, 0),
+    fMaxStepsPerRay(100000), fNRays(0), fNSteps(0), fTotalTime(0.0)
+{}
+
+/**
+ * @details Record the static description of the volume and of its
+ * daughters. A logical volume is scanned again only if reached along a
+ * deeper path, so that the reported depth and number of parameterised
+ * levels are the maximum over its placements.
+ */
+void SLArGeometryProfiler::ScanVolumeTree(const G4LogicalVolume* lv,
+    const G4int depth, const G4int param_levels)
+{
+  auto it = fStats.find(lv);
+  if (it != fStats.end() &&
+      depth <= it->second.fDepth && param_levels <= it->second.fParamLevels) return;
+
+  auto& stats = fStats[lv];
+  stats.fName = lv->GetName();
+  stats.fNDaughters = lv->GetNoDaughters();
+  stats.fSmartless = lv->GetSmartless();
+  stats.fDepth = std::max(stats.fDepth, depth);
+  stats.fParamLevels = std::max(stats.fParamLevels, param_levels);
+  auto voxels = lv->GetVoxelHeader();
+  stats.fNVoxelSlices = (voxels) ? voxels->GetNoSlices() : 0;
+
+  for (size_t i = 0; i < lv->GetNoDaughters(); i++) {
+    const auto pv = lv->GetDaughter(i);
+    const G4bool is_param = pv->IsReplicated() || pv->IsParameterised();
+    if (is_param) stats.fParamDaughters = true;
+    ScanVolumeTree(pv->GetLogicalVolume(), depth+1, param_levels + (is_param ? 1 : 0));
+  }
+  // a parameterisation nested in another one
+  stats.fDeepHierarchy = stats.fParamDaughters && stats.fParamLevels > 0;
+  return;
+}
+
+void SLArGeometryProfiler::Run(const G4int n_rays) {
+  auto geo_manager = G4GeometryManager::GetInstance();
+  const G4bool was_closed = geo_manager->IsGeometryClosed();
+  // voxelise the geometry as done at the start of a run
+  if (was_closed == false) geo_manager->CloseGeometry(true);
+
+  ScanVolumeTree(fWorld->GetLogicalVolume(), 0, 0);
+
+  G4Navigator navigator;
+  navigator.SetWorldVolume(fWorld);
+
+  typedef std::chrono::steady_clock clock_t;
+  for (G4int iray = 0; iray < n_rays; iray++) {
+    G4ThreeVector pos(
+        fBoxCenter.x() + fBoxHalfSize.x()*(2*G4UniformRand() - 1),
+        fBoxCenter.y() + fBoxHalfSize.y()*(2*G4UniformRand() - 1),
+        fBoxCenter.z() + fBoxHalfSize.z()*(2*G4UniformRand() - 1));
+    const G4ThreeVector dir = SampleRandomDirection();
+
+    auto t0 = clock_t::now();
+    G4VPhysicalVolume* pv = navigator.LocateGlobalPointAndSetup(pos, &dir, false, false);
+    G4double dt = std::chrono::duration<G4double>(clock_t::now() - t0).count();
+
+    for (G4int istep = 0; istep < fMaxStepsPerRay && pv != nullptr; istep++) {
+      G4double safety = 0.0;
+      t0 = clock_t::now();
+      const G4double step = navigator.ComputeStep(pos, dir, kInfinity, safety);
+      dt += std::chrono::duration<G4double>(clock_t::now() - t0).count();
+
+      auto& stats = fStats[pv->GetLogicalVolume()];
+      stats.fSteps++;
+      fNSteps++;
+      if (step == kInfinity) {
+        stats.fNavTime += dt; fTotalTime += dt;
+        break;
+      }
+
+      pos += step*dir;
+      t0 = clock_t::now();
+      navigator.SetGeometricallyLimitedStep();
+      const auto next_pv = navigator.LocateGlobalPointAndSetup(pos, &dir, true, false);
+      dt += std::chrono::duration<G4double>(clock_t::now() - t0).count();
+      stats.fNavTime += dt; fTotalTime += dt;
+      dt = 0.0;
+      pv = next_pv;
+    }
+  }
+  fNRays += n_rays;
+
+  if (was_closed == false) geo_manager->OpenGeometry();
+  return;
+}
+
+void SLArGeometryProfiler::Print() const {
+  std::vector<const VolumeStats_t*> sorted;
+  for (const auto& itr : fStats) sorted.push_back( &itr.second );
+  std::sort(sorted.begin(), sorted.end(),
+      [](const VolumeStats_t* a, const VolumeStats_t* b) {return a->fNavTime > b->fNavTime;});
+
+  printf("SLArGeometryProfiler: %i rays, %ld steps, %g s in navigation\n",
+      fNRays, fNSteps, fTotalTime);
+  printf("%-32s %10s %10s %8s %9s %8s %6s %6s\n", "logical volume", "steps", "time [ms]",
+      "time %", "daughters", "slices", "depth", "flag");
+  for (const auto& stats : sorted) {
+    if (stats->fSteps == 0) continue;
+    printf("%-32s %10ld %10.3f %8.2f %9i %8i %6i %6s\n", stats->fName.data(),
+        stats->fSteps, stats->fNavTime*1e3,
+        (fTotalTime > 0) ? 100*stats->fNavTime/fTotalTime : 0.0,
+        stats->fNDaughters, stats->fNVoxelSlices, stats->fDepth,
+        stats->fDeepHierarchy ? "DEEP" : "");
+  }
+  return;
+}
+
+G4bool SLArGeometryProfiler::Write(const G4String& file_path) const {
+  FILE* prof_file = std::fopen(file_path, "w");
+  if (prof_file == nullptr) {
+    printf("SLArGeometryProfiler::Write ERROR: cannot open %s\n", file_path.data());
+    return false;
+  }
+
+  rapidjson::Document d;
+  d.SetObject();
+  d.AddMember("rays", fNRays, d.GetAllocator());
+  d.AddMember("steps", static_cast<int64_t>(fNSteps), d.GetAllocator());
+  d.AddMember("navigation_time_s", fTotalTime, d.GetAllocator());
+  rapidjson::Value jvolumes(rapidjson::kArrayType);
+  for (const auto& itr : fStats) {
+    const auto& stats = itr.second;
+    rapidjson::Value jvol(rapidjson::kObjectType);
+    jvol.AddMember("name", rapidjson::StringRef(stats.fName.data()), d.GetAllocator());
+    jvol.AddMember("steps", static_cast<int64_t>(stats.fSteps), d.GetAllocator());
+    jvol.AddMember("navigation_time_s", stats.fNavTime, d.GetAllocator());
+    jvol.AddMember("daughters", stats.fNDaughters, d.GetAllocator());
+    jvol.AddMember("param_daughters", stats.fParamDaughters, d.GetAllocator());
+    jvol.AddMember("smartless", stats.fSmartless, d.GetAllocator());
+    jvol.AddMember("voxel_slices", stats.fNVoxelSlices, d.GetAllocator());
+    jvol.AddMember("depth", stats.fDepth, d.GetAllocator());
+    jvol.AddMember("param_levels", stats.fParamLevels, d.GetAllocator());
+    jvol.AddMember("deep_hierarchy", stats.fDeepHierarchy, d.GetAllocator());
+    jvolumes.PushBack(jvol, d.GetAllocator());
+  }
+  d.AddMember("volumes", jvolumes, d.GetAllocator());
+
+  char writeBuffer[65536];
+  rapidjson::FileWriteStream os(prof_file, writeBuffer, sizeof(writeBuffer));
+  rapidjson::PrettyWriter<rapidjson::FileWriteStream> writer(os);
+  d.Accept(writer);
+  std::fclose(prof_file);
+
+  printf("SLArGeometryProfiler: %lu volumes written to %s\n", fStats.size(), file_path.data());
+  return true;
+}
+
@@ -0,0 +1,163 @@
+/**
+ * @author      : Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        : SLArImportanceMap.cc
+ * @created     : Monday Oct 19, 2026 19:31:52 CEST
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <stdexcept>
+
+#include "rapidjson/document.h"
+#include "rapidjson/filereadstream.h"
+#include "rapidjson/filewritestream.h"
+#include "rapidjson/prettywriter.h"
+
+#include "G4VPhysicalVolume.hh"
+#include "SLArImportanceMap.hh"
+
+SLArImportanceMap::SLArImportanceMap()
+  : fIsLoaded(false), fIsScoring(false), fParticleName(""),
+    fMaxImportance(1024), fOutputFile("")
+{}
+
+G4bool SLArImportanceMap::Load(const G4String& file_path) {
+  FILE* imp_file = std::fopen(file_path, "r");
+  if (imp_file == nullptr) {
+    char err_msg[200];
+    sprintf(err_msg, "SLArImportanceMap::Load ERROR: cannot open importance map file %s\n",
+        file_path.data());
+    throw std::runtime_error(err_msg);
+  }
+  char readBuffer[65536];
+  rapidjson::FileReadStream is(imp_file, readBuffer, sizeof(readBuffer));
+
+  rapidjson::Document d;
+  d.ParseStream<rapidjson::kParseCommentsFlag>(is);
+  std::fclose(imp_file);
+
+  if (!d.IsObject() || !d.HasMember("cells") || !d["cells"].IsArray()) {
+    char err_msg[200];
+    sprintf(err_msg, "SLArImportanceMap::Load ERROR: %s is not a valid importance map\n",
+        file_path.data());
+    throw std::invalid_argument(err_msg);
+  }
+
+  for (const auto& jcell : d["cells"].GetArray()) {
+    const G4String pv_name = jcell["volume"].GetString();
+    const G4int replica = jcell.HasMember("replica") ? jcell["replica"].GetInt() : 0;
+    const G4double imp = jcell["importance"].GetDouble();
+    if (imp <= 0) {
+      printf("SLArImportanceMap::Load WARNING: skipping cell %s[%i] with importance %g\n",
+          pv_name.data(), replica, imp);
+      continue;
+    }
+    SetImportance(pv_name, replica, imp);
+  }
+
+  fIsLoaded = true;
+  printf("SLArImportanceMap: loaded %lu cells from %s\n", fCells.size(), file_path.data());
+  return true;
+}
+
+G4bool SLArImportanceMap::Write(const G4String& file_path) const {
+  FILE* imp_file = std::fopen(file_path, "w");
+  if (imp_file == nullptr) {
+    printf("SLArImportanceMap::Write ERROR: cannot open %s\n", file_path.data());
+    return false;
+  }
+
+  rapidjson::Document d;
+  d.SetObject();
+  d.AddMember("particle", rapidjson::StringRef(fParticleName.data()), d.GetAllocator());
+  d.AddMember("max_importance", fMaxImportance, d.GetAllocator());
+  rapidjson::Value jcells(rapidjson::kArrayType);
+  for (const auto& cell : fCells) {
+    rapidjson::Value jcell(rapidjson::kObjectType);
+    jcell.AddMember("volume", rapidjson::StringRef(cell.first.first.data()), d.GetAllocator());
+    jcell.AddMember("replica", cell.first.second, d.GetAllocator());
+    jcell.AddMember("importance", cell.second.fImportance, d.GetAllocator());
+    jcell.AddMember("population", cell.second.fPopulation, d.GetAllocator());
+    jcell.AddMember("entries", cell.second.fEntries, d.GetAllocator());
+    jcells.PushBack(jcell, d.GetAllocator());
+  }
+  d.AddMember("cells", jcells, d.GetAllocator());
+
+  char writeBuffer[65536];
+  rapidjson::FileWriteStream os(imp_file, writeBuffer, sizeof(writeBuffer));
+  rapidjson::PrettyWriter<rapidjson::FileWriteStream> writer(os);
+  d.Accept(writer);
+  std::fclose(imp_file);
+
+  printf("SLArImportanceMap: %lu cells written to %s\n", fCells.size(), file_path.data());
+  return true;
+}
+
+G4double SLArImportanceMap::GetImportance(
+    const G4String& pv_name, const G4int replica, const G4double default_imp) const
+{
+  const auto cell = fCells.find( CellKey_t(pv_name, replica) );
+  if (cell == fCells.end()) return default_imp;
+  return cell->second.fImportance;
+}
+
+void SLArImportanceMap::EnableScoring(const G4String& particle_name) {
+  fParticleName = particle_name;
+  fIsScoring = true;
+  for (auto& cell : fCells) {
+    cell.second.fPopulation = 0.0;
+    cell.second.fEntries = 0;
+  }
+  return;
+}
+
+void SLArImportanceMap::ScoreEntry(
+    const G4VPhysicalVolume* pv, const G4int replica, const G4double weight)
+{
+  const auto cache_key = std::make_pair(pv, replica);
+  auto cached = fCellCache.find( cache_key );
+  CellData_t* cell = nullptr;
+  if (cached == fCellCache.end()) {
+    cell = &fCells[CellKey_t(pv->GetName(), replica)];
+    fCellCache.insert( std::make_pair(cache_key, cell) );
+  }
+  else {
+    cell = cached->second;
+  }
+
+  cell->fPopulation += weight;
+  cell->fEntries++;
+  return;
+}
+
+/**
+ * @details The importance of each scored cell is the population of the most
+ * populated cell divided by the cell population, rounded to the closest
+ * power of two and limited to [1, fMaxImportance]. Cells not reached in the
+ * pilot run keep their previous importance, while cells that were never
+ * reached are not part of the map and take the importance of their mother
+ * volume when the map is used.
+ */
+void SLArImportanceMap::ComputeImportances() {
+  G4double max_population = 0.0;
+  for (const auto& cell : fCells) {
+    if (cell.second.fPopulation > max_population) max_population = cell.second.fPopulation;
+  }
+  if (max_population <= 0) {
+    printf("SLArImportanceMap::ComputeImportances WARNING: no %s scored in the pilot run\n",
+        fParticleName.data());
+    return;
+  }
+
+  for (auto& cell : fCells) {
+    auto& data = cell.second;
+    if (data.fPopulation <= 0) continue;
+    G4double imp = std::pow(2.0, std::round(std::log2(max_population / data.fPopulation)));
+    if (imp < 1.0) imp = 1.0;
+    else if (imp > fMaxImportance) imp = fMaxImportance;
+    data.fImportance = imp;
+  }
+
+  return;
+}
+
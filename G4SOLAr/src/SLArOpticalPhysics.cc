@@ -50,6 +50,7 @@ SLArOpticalPhysics::SLArOpticalPhysics(G4bool abs_toggle, G4bool cerenkov_toggle
 
   fAbsorptionOn              = abs_toggle;
   fCerenkovOn                = cerenkov_toggle;
+  fTabulatedOn               = false;
 
 }
 
@@ -63,6 +64,7 @@ void SLArOpticalPhysics::ConstructParticle()
 }
 
 #include "G4ProcessManager.hh"
+#include "G4FastSimulationHelper.hh"
 
 void SLArOpticalPhysics::ConstructProcess()
 {
@@ -79,8 +81,15 @@ void SLArOpticalPhysics::ConstructProcess()
     fCerenkovProcess->SetMaxNumPhotonsPerStep(300);
     fCerenkovProcess->SetTrackSecondariesFirst(true);
   }
-  fAbsorptionProcess      = new G4OpAbsorption();
-  fRayleighScattering     = new G4OpRayleigh();
+  if (fTabulatedOn) {
+    // mean free paths tabulated at BuildPhysicsTable time
+    fAbsorptionProcess    = new SLArOpAbsorption();
+    fRayleighScattering   = new SLArOpRayleigh();
+  }
+  else {
+    fAbsorptionProcess    = new G4OpAbsorption();
+    fRayleighScattering   = new G4OpRayleigh();
+  }
   fMieHGScatteringProcess = new G4OpMieHG();
   fBoundaryProcess        = new G4OpBoundaryProcess();
 
@@ -101,6 +110,9 @@ void SLArOpticalPhysics::ConstructProcess()
 
   pManager->AddDiscreteProcess(fBoundaryProcess);
 
+  // fast optical transport in the regions where a model is attached
+  G4FastSimulationHelper::ActivateFastSimulation(pManager);
+
   //fWLSProcess->UseTimeProfile("delta");
   //fWLSProcess->UseTimeProfile("exponential");
 
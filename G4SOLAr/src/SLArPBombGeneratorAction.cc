@@ -64,8 +64,14 @@ void SLArPBombGeneratorAction::GeneratePrimaries(G4Event* anEvent)
     else {
       dir.set(fBombConfig.direction.x(), fBombConfig.direction.y(), fBombConfig.direction.z());
     }
+    if (fCosThetaSampler.IsEmpty() == false) {
+      dir = SampleDirectionAroundAxis(fBombConfig.direction.unit(), fCosThetaSampler.Sample()); 
+    }
+    G4double energy = fBombConfig.particle_energy; 
+    if (fEnergySampler.IsEmpty() == false) energy = fEnergySampler.Sample(); 
+
     particle->SetMomentumDirection( dir ); 
-    particle->SetKineticEnergy( fBombConfig.particle_energy ); 
+    particle->SetKineticEnergy( energy ); 
 
     if (fParticleDefinition == G4OpticalPhoton::OpticalPhotonDefinition()) {
       G4ThreeVector polarization = SampleRandomDirection();
@@ -92,6 +98,9 @@ void SLArPBombGeneratorAction::Configure(const rapidjson::Value& config) {
   if (config.HasMember("energy")) {
     fBombConfig.particle_energy = unit::ParseJsonVal( config["energy"] ); 
   }
+  if (config.HasMember("energy_distribution")) {
+    fEnergySampler.Configure( config["energy_distribution"] ); 
+  }
   if (config.HasMember("n_particles")) {
     fBombConfig.n_particles = config["n_particles"].GetInt();
   }
@@ -116,6 +125,13 @@ void SLArPBombGeneratorAction::Configure(const rapidjson::Value& config) {
       fBombConfig.direction.set(dir[0], dir[1], dir[2]); 
     }
   }
+  if (config.HasMember("cos_theta_distribution")) {
+    fCosThetaSampler.Configure( config["cos_theta_distribution"] ); 
+    if (fCosThetaSampler.GetMin() < -1 || fCosThetaSampler.GetMax() > 1) {
+      throw std::invalid_argument("pbomb gen: cos_theta_distribution must be defined in [-1, 1]\n"); 
+    }
+    if (fBombConfig.direction.mag2() == 0) fBombConfig.direction.set(0, 0, 1); 
+  }
   if (config.HasMember("vertex_gen")) {
     ConfigureVertexGenerator( config["vertex_gen"] ); 
   }
@@ -140,7 +156,12 @@ G4String SLArPBombGeneratorAction::WriteConfig() const {
   d.AddMember("type" , rapidjson::StringRef(gen_type.data()), d.GetAllocator()); 
   d.AddMember("label", rapidjson::StringRef(fLabel.data()), d.GetAllocator()); 
   d.AddMember("particle", rapidjson::StringRef(particle_name.data()), d.GetAllocator()); 
-  d.AddMember("energy", fBombConfig.particle_energy, d.GetAllocator()); 
+  if (fEnergySampler.IsEmpty()) {
+    d.AddMember("energy", fBombConfig.particle_energy, d.GetAllocator()); 
+  }
+  else {
+    d.AddMember("energy_distribution", fEnergySampler.ExportConfig(d.GetAllocator()), d.GetAllocator()); 
+  }
 
   if (fBombConfig.direction_mode == EDirectionMode::kFixedDir) {
     d.AddMember("direction_mode", rapidjson::StringRef("fixed"), d.GetAllocator()); 
@@ -154,6 +175,9 @@ G4String SLArPBombGeneratorAction::WriteConfig() const {
   else if (fBombConfig.direction_mode == EDirectionMode::kRandomDir) {
     d.AddMember("direction_mode", rapidjson::StringRef("isotropic"), d.GetAllocator()); 
   }
+  if (fCosThetaSampler.IsEmpty() == false) {
+    d.AddMember("cos_theta_distribution", fCosThetaSampler.ExportConfig(d.GetAllocator()), d.GetAllocator()); 
+  }
 
   const rapidjson::Document vtx_json = fVtxGen->ExportConfig(); 
   rapidjson::Value vtx_config;
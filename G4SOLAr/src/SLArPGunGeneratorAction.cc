@@ -53,10 +53,16 @@ void SLArPGunGeneratorAction::GeneratePrimaries(G4Event* anEvent)
       G4ThreeVector random_dir = SampleRandomDirection(); 
       p.set(random_dir.x(), random_dir.y(), random_dir.z()); 
     }
+    if (fCosThetaSampler.IsEmpty() == false) {
+      p = SampleDirectionAroundAxis(fGunConfig.direction.unit(), fCosThetaSampler.Sample()); 
+    }
+    G4double energy = fGunConfig.particle_energy; 
+    if (fEnergySampler.IsEmpty() == false) energy = fEnergySampler.Sample(); 
+
     fVtxGen->ShootVertex( vtx ); 
     fParticleGun->SetParticlePosition( vtx ); 
     fParticleGun->SetParticleMomentumDirection( p );
-    fParticleGun->SetParticleEnergy( fGunConfig.particle_energy ); 
+    fParticleGun->SetParticleEnergy( energy ); 
     fParticleGun->GeneratePrimaryVertex(anEvent);
   }
 }
@@ -76,6 +82,9 @@ void SLArPGunGeneratorAction::Configure(const rapidjson::Value& config) {
   if (config.HasMember("energy")) {
     fGunConfig.particle_energy = unit::ParseJsonVal( config["energy"] ); 
   }
+  if (config.HasMember("energy_distribution")) {
+    fEnergySampler.Configure( config["energy_distribution"] ); 
+  }
   if (config.HasMember("n_particles")) {
     fGunConfig.n_particles = config["n_particles"].GetInt();
   }
@@ -100,6 +109,12 @@ void SLArPGunGeneratorAction::Configure(const rapidjson::Value& config) {
       fGunConfig.direction.set(dir[0], dir[1], dir[2]); 
     }
   }
+  if (config.HasMember("cos_theta_distribution")) {
+    fCosThetaSampler.Configure( config["cos_theta_distribution"] ); 
+    if (fCosThetaSampler.GetMin() < -1 || fCosThetaSampler.GetMax() > 1) {
+      throw std::invalid_argument("pgun gen: cos_theta_distribution must be defined in [-1, 1]\n"); 
+    }
+  }
   if (config.HasMember("vertex_gen")) {
     ConfigureVertexGenerator( config["vertex_gen"] ); 
   }
@@ -123,7 +138,12 @@ G4String SLArPGunGeneratorAction::WriteConfig() const {
   d.AddMember("type" , rapidjson::StringRef(gen_type.data()), d.GetAllocator()); 
   d.AddMember("label", rapidjson::StringRef(fLabel.data()), d.GetAllocator()); 
   d.AddMember("particle", rapidjson::StringRef(fGunConfig.particle_name.data()), d.GetAllocator()); 
-  d.AddMember("energy", fGunConfig.particle_energy, d.GetAllocator()); 
+  if (fEnergySampler.IsEmpty()) {
+    d.AddMember("energy", fGunConfig.particle_energy, d.GetAllocator()); 
+  }
+  else {
+    d.AddMember("energy_distribution", fEnergySampler.ExportConfig(d.GetAllocator()), d.GetAllocator()); 
+  }
   if (fGunConfig.direction_mode == EDirectionMode::kFixedDir) {
     d.AddMember("direction_mode", rapidjson::StringRef("fixed"), d.GetAllocator()); 
     rapidjson::Value jdir; 
@@ -136,6 +156,9 @@ G4String SLArPGunGeneratorAction::WriteConfig() const {
   else if (fGunConfig.direction_mode == EDirectionMode::kRandomDir) {
     d.AddMember("direction_mode", rapidjson::StringRef("isotropic"), d.GetAllocator()); 
   }
+  if (fCosThetaSampler.IsEmpty() == false) {
+    d.AddMember("cos_theta_distribution", fCosThetaSampler.ExportConfig(d.GetAllocator()), d.GetAllocator()); 
+  }
 
   const rapidjson::Document vtx_json = fVtxGen->ExportConfig(); 
   rapidjson::Value vtx_config;
@@ -0,0 +1,261 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArPhaseSpaceGeneratorAction.cc
+ * @created     Monday Oct 19, 2026 18:52:31 CEST
+ */
+
+#include <SLArPhaseSpaceGeneratorAction.hh>
+
+#include <cstdio>
+#include <algorithm>
+#include <stdexcept>
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/prettywriter.h>
+
+#include <TFile.h>
+#include <TTree.h>
+
+#include <G4Event.hh>
+#include <G4PrimaryVertex.hh>
+#include <G4PrimaryParticle.hh>
+#include <G4ParticleTable.hh>
+#include <G4IonTable.hh>
+
+namespace gen {
+
+SLArPhaseSpaceGeneratorAction::SLArPhaseSpaceGeneratorAction(const G4String label)
+  : SLArBaseGenerator(label), fCursor(0), fPass(0), fSplit(0)
+{}
+
+SLArPhaseSpaceGeneratorAction::~SLArPhaseSpaceGeneratorAction()
+{}
+
+void SLArPhaseSpaceGeneratorAction::Configure(const rapidjson::Value& config) {
+  if (config.HasMember("phase_space_file")) {
+    fConfig.file_path = config["phase_space_file"].GetString();
+  } else {
+    throw std::invalid_argument("phasespace gen missing mandatory \"phase_space_file\" field.\n");
+  }
+
+  if (config.HasMember("tree_key")) {
+    fConfig.tree_key = config["tree_key"].GetString();
+  }
+  if (config.HasMember("reuse_factor")) {
+    fConfig.reuse_factor = config["reuse_factor"].GetInt();
+  }
+  if (config.HasMember("splitting_factor")) {
+    fConfig.splitting_factor = config["splitting_factor"].GetInt();
+  }
+  if (config.HasMember("group_by_event")) {
+    fConfig.group_by_event = config["group_by_event"].GetBool();
+  }
+  if (config.HasMember("n_particles")) {
+    fConfig.n_particles = config["n_particles"].GetInt();
+  }
+  if (config.HasMember("keep_time")) {
+    fConfig.keep_time = config["keep_time"].GetBool();
+  }
+  if (config.HasMember("pdg_filter")) {
+    for (const auto& pdg : config["pdg_filter"].GetArray()) {
+      fConfig.pdg_filter.push_back( pdg.GetInt() );
+    }
+  }
+  if (config.HasMember("scorer_filter")) {
+    for (const auto& scorer : config["scorer_filter"].GetArray()) {
+      fConfig.scorer_filter.push_back( scorer.GetInt() );
+    }
+  }
+
+  if (fConfig.reuse_factor < 1 || fConfig.splitting_factor < 1 || fConfig.n_particles < 1) {
+    char err_msg[200];
+    sprintf(err_msg, "SLArPhaseSpaceGeneratorAction::Configure ERROR\nreuse_factor, splitting_factor and n_particles must be positive.\n");
+    throw std::invalid_argument(err_msg);
+  }
+
+  LoadPhaseSpace();
+
+  return;
+}
+
+G4bool SLArPhaseSpaceGeneratorAction::AcceptRecord(const SLArPhaseSpaceRecord_t& rec) const {
+  const auto& pdgs = fConfig.pdg_filter;
+  const auto& scorers = fConfig.scorer_filter;
+  if (!pdgs.empty() && std::find(pdgs.begin(), pdgs.end(), rec.fPDGCode) == pdgs.end()) {
+    return false;
+  }
+  if (!scorers.empty() && std::find(scorers.begin(), scorers.end(), rec.fScorerID) == scorers.end()) {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @details Read the whole phase-space tree in memory. The records are
+ * written in event order during the first stage, so the stage-1 events
+ * are identified by the changes of the event number.
+ */
+void SLArPhaseSpaceGeneratorAction::LoadPhaseSpace() {
+  TFile input_file(fConfig.file_path);
+  if (input_file.IsOpen() == false) {
+    char err_msg[200];
+    sprintf(err_msg, "SLArPhaseSpaceGeneratorAction::LoadPhaseSpace ERROR\nCannot open phase-space file %s.\n",
+        fConfig.file_path.data());
+    throw std::runtime_error(err_msg);
+  }
+  TTree* tree = input_file.Get<TTree>(fConfig.tree_key);
+  if (tree == nullptr) {
+    char err_msg[200];
+    sprintf(err_msg, "SLArPhaseSpaceGeneratorAction::LoadPhaseSpace ERROR\nCannot read key %s from phase-space file %s.\n",
+        fConfig.tree_key.data(), fConfig.file_path.data());
+    throw std::runtime_error(err_msg);
+  }
+
+  SLArPhaseSpaceRecord_t rec;
+  rec.SetBranchAddresses( tree );
+
+  fRecords.clear();
+  fGroupOffset.clear();
+  fRecords.reserve( tree->GetEntries() );
+  Int_t last_event = -1;
+  for (Long64_t i = 0; i < tree->GetEntries(); i++) {
+    tree->GetEntry(i);
+    if (AcceptRecord(rec) == false) continue;
+    if (fGroupOffset.empty() || rec.fEvNumber != last_event) {
+      fGroupOffset.push_back( fRecords.size() );
+      last_event = rec.fEvNumber;
+    }
+    fRecords.push_back( rec );
+  }
+  input_file.Close();
+
+  if (fRecords.empty()) {
+    char err_msg[200];
+    sprintf(err_msg, "SLArPhaseSpaceGeneratorAction::LoadPhaseSpace ERROR\nNo phase-space record selected from %s.\n",
+        fConfig.file_path.data());
+    throw std::runtime_error(err_msg);
+  }
+
+  fCursor = 0;
+  fPass = 0;
+  fSplit = 0;
+
+  printf("[gen] %s: loaded %lu phase-space records from %lu stage-1 events\n",
+      fLabel.data(), fRecords.size(), fGroupOffset.size());
+  printf("[gen] %s: reuse factor %i, splitting factor %i\n",
+      fLabel.data(), fConfig.reuse_factor, fConfig.splitting_factor);
+  return;
+}
+
+G4ParticleDefinition* SLArPhaseSpaceGeneratorAction::FindParticle(const G4int pdg) const {
+  G4ParticleDefinition* particle_def = G4ParticleTable::GetParticleTable()->FindParticle( pdg );
+  if (particle_def == nullptr && pdg > 1000000000) {
+    particle_def = G4IonTable::GetIonTable()->GetIon( pdg );
+  }
+  return particle_def;
+}
+
+void SLArPhaseSpaceGeneratorAction::AddPrimaries(G4Event* ev, const SLArPhaseSpaceRecord_t& rec) const {
+  G4ParticleDefinition* particle_def = FindParticle( rec.fPDGCode );
+  if (particle_def == nullptr) {
+    printf("SLArPhaseSpaceGeneratorAction::AddPrimaries WARNING: unknown particle %i, skipping record\n",
+        rec.fPDGCode);
+    return;
+  }
+
+  const G4ThreeVector pos(rec.fX, rec.fY, rec.fZ);
+  const G4ThreeVector dir = G4ThreeVector(rec.fUx, rec.fUy, rec.fUz).unit();
+  const G4double time = (fConfig.keep_time) ? rec.fTime : 0.0;
+  const G4double weight =
+    rec.fWeight / static_cast<G4double>(fConfig.reuse_factor * fConfig.splitting_factor);
+
+  auto particle = new G4PrimaryParticle( particle_def );
+  particle->SetKineticEnergy( rec.fEnergy );
+  particle->SetMomentumDirection( dir );
+  particle->SetWeight( weight );
+
+  auto vertex = new G4PrimaryVertex(pos, time);
+  vertex->SetPrimary( particle );
+  ev->AddPrimaryVertex( vertex );
+  return;
+}
+
+void SLArPhaseSpaceGeneratorAction::GeneratePrimaries(G4Event* ev)
+{
+  const size_t n_units = (fConfig.group_by_event) ? fGroupOffset.size() : fRecords.size();
+
+  // wrap around only once all the copies of the last unit are generated
+  if (fSplit == 0 && fCursor >= n_units) {
+    fCursor = 0;
+    fPass++;
+    if (fPass == fConfig.reuse_factor) {
+      printf("SLArPhaseSpaceGeneratorAction::GeneratePrimaries WARNING: ");
+      printf("phase-space file replayed more than %i times, primary weights are overestimated\n",
+          fConfig.reuse_factor);
+    }
+  }
+
+  // replay the current unit, the cursor moves on after the last copy
+  size_t next = fCursor;
+  if (fConfig.group_by_event) {
+    const size_t first = fGroupOffset[fCursor];
+    const size_t last = (fCursor + 1 < fGroupOffset.size()) ?
+      fGroupOffset[fCursor+1] : fRecords.size();
+    for (size_t i = first; i < last; i++) AddPrimaries(ev, fRecords[i]);
+    next = fCursor + 1;
+  }
+  else {
+    for (G4int i = 0; i < fConfig.n_particles && next < fRecords.size(); i++) {
+      AddPrimaries(ev, fRecords[next]);
+      next++;
+    }
+  }
+
+  fSplit++;
+  if (fSplit == fConfig.splitting_factor) {
+    fSplit = 0;
+    fCursor = next;
+  }
+
+  return;
+}
+
+G4String SLArPhaseSpaceGeneratorAction::WriteConfig() const {
+  G4String config_str = "";
+
+  rapidjson::Document d;
+  d.SetObject();
+  rapidjson::StringBuffer buffer;
+  rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+  G4String gen_type = GetGeneratorType();
+
+  d.AddMember("type" , rapidjson::StringRef(gen_type.data()), d.GetAllocator());
+  d.AddMember("label", rapidjson::StringRef(fLabel.data()), d.GetAllocator());
+  d.AddMember("phase_space_file", rapidjson::StringRef(fConfig.file_path.data()), d.GetAllocator());
+  d.AddMember("tree_key", rapidjson::StringRef(fConfig.tree_key.data()), d.GetAllocator());
+  d.AddMember("reuse_factor", fConfig.reuse_factor, d.GetAllocator());
+  d.AddMember("splitting_factor", fConfig.splitting_factor, d.GetAllocator());
+  d.AddMember("group_by_event", fConfig.group_by_event, d.GetAllocator());
+  if (fConfig.group_by_event == false) {
+    d.AddMember("n_particles", fConfig.n_particles, d.GetAllocator());
+  }
+  d.AddMember("keep_time", fConfig.keep_time, d.GetAllocator());
+  if (!fConfig.pdg_filter.empty()) {
+    rapidjson::Value jpdg(rapidjson::kArrayType);
+    for (const auto& pdg : fConfig.pdg_filter) jpdg.PushBack(pdg, d.GetAllocator());
+    d.AddMember("pdg_filter", jpdg, d.GetAllocator());
+  }
+  if (!fConfig.scorer_filter.empty()) {
+    rapidjson::Value jscorer(rapidjson::kArrayType);
+    for (const auto& scorer : fConfig.scorer_filter) jscorer.PushBack(scorer, d.GetAllocator());
+    d.AddMember("scorer_filter", jscorer, d.GetAllocator());
+  }
+  d.AddMember("n_records", static_cast<uint64_t>(fRecords.size()), d.GetAllocator());
+
+  d.Accept(writer);
+  config_str = buffer.GetString();
+  return config_str;
+}
+
+}
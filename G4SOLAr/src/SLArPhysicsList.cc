@@ -67,6 +67,10 @@
 #include "G4RadioactiveDecayPhysics.hh"
 
 #include "G4UnitsTable.hh"
+#include "G4RegionStore.hh"
+#include "G4Threading.hh"
+
+#include "SLArUserRegionInformation.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -109,6 +113,7 @@ SLArPhysicsList::SLArPhysicsList(G4String physName, G4bool do_cerenkov) :
 
   fAbsorptionOn = true;
   fCerenkovOn = do_cerenkov;
+  fTabulatedOpticalOn = false;
   fOpticalPhysics = new SLArOpticalPhysics(fAbsorptionOn, fCerenkovOn); 
 
   RegisterPhysics(new SLArExtraPhysics());
@@ -266,11 +271,20 @@ void SLArPhysicsList::SetAbsorption(G4bool toggle)
   RemoveFromPhysicsList("Optical");
   fPhysicsVector->
     push_back(fOpticalPhysics = new SLArOpticalPhysics(toggle));
+  fOpticalPhysics->SetTabulatedProperties(fTabulatedOpticalOn);
   fOpticalPhysics->ConstructProcess();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void SLArPhysicsList::SetTabulatedOptical(G4bool toggle)
+{
+  fTabulatedOpticalOn = toggle;
+  fOpticalPhysics->SetTabulatedProperties(toggle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void SLArPhysicsList::SetCuts()
 {
   if (verboseLevel >0) {
@@ -285,15 +299,33 @@ void SLArPhysicsList::SetCuts()
   SetCutValue(fCutForElectron, "e-");
   SetCutValue(fCutForPositron, "e+");
 
+  ApplyRegionCuts();
+
   if (verboseLevel>0) DumpCutValuesTable();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+// resolve the cuts of the configured regions that do not list all the 
+// particles against the global cuts set above
+void SLArPhysicsList::ApplyRegionCuts()
+{
+  if (G4Threading::IsMasterThread() == false) return;
+
+  for (auto& region : *G4RegionStore::GetInstance()) {
+    auto region_info = 
+      dynamic_cast<SLArUserRegionInformation*>(region->GetUserInformation());
+    if (region_info) region_info->ApplyProductionCuts( region );
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void SLArPhysicsList::SetCutForGamma(G4double cut)
 {
   fCutForGamma = cut;
   SetParticleCuts(fCutForGamma, G4Gamma::Gamma());
+  ApplyRegionCuts();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -302,6 +334,7 @@ void SLArPhysicsList::SetCutForElectron(G4double cut)
 {
   fCutForElectron = cut;
   SetParticleCuts(fCutForElectron, G4Electron::Electron());
+  ApplyRegionCuts();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -310,6 +343,7 @@ void SLArPhysicsList::SetCutForPositron(G4double cut)
 {
   fCutForPositron = cut;
   SetParticleCuts(fCutForPositron, G4Positron::Positron());
+  ApplyRegionCuts();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -59,6 +59,13 @@ SLArPhysicsListMessenger::SLArPhysicsListMessenger(SLArPhysicsList* pPhys)
   fSetAbsorptionCMD->SetGuidance("Turn on or off absorption process");
   fSetAbsorptionCMD->AvailableForStates(G4State_Idle);
 
+  fTabulateOpticalCMD = new G4UIcmdWithABool(
+      "/SLAr/phys/tabulateOptical", this);
+  fTabulateOpticalCMD->SetGuidance("Use optical mean free paths tabulated on fixed energy grids");
+  fTabulateOpticalCMD->SetGuidance("(absorption and Rayleigh, finer grid over the scintillation band)");
+  fTabulateOpticalCMD->AvailableForStates(G4State_PreInit);
+  fTabulateOpticalCMD->SetToBeBroadcasted(false);
+
   fVerboseCmd = new G4UIcmdWithAnInteger(
       "/SLAr/phys/verbose",this);
   fVerboseCmd->SetGuidance("set verbose for physics processes");
@@ -155,6 +162,7 @@ SLArPhysicsListMessenger::~SLArPhysicsListMessenger()
   delete fCerenkovCmd;
 
   delete fSetAbsorptionCMD;
+  delete fTabulateOpticalCMD;
 
   delete fGammaCutCMD;
   delete fElectCutCMD;
@@ -181,6 +189,10 @@ void SLArPhysicsListMessenger::SetNewValue(G4UIcommand* command,
     fPhysicsList->SetAbsorption(G4UIcmdWithABool::GetNewBoolValue(newValue));
   }
 
+  else if( command == fTabulateOpticalCMD ) {
+    fPhysicsList->SetTabulatedOptical(G4UIcmdWithABool::GetNewBoolValue(newValue));
+  }
+
   else if( command == fVerboseCmd ) {
     fPhysicsList->SetVerbose(fVerboseCmd->GetNewIntValue(newValue));
   }
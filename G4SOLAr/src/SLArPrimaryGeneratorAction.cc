@@ -18,6 +18,7 @@
 #include <SLArExternalGeneratorAction.hh>
 //#include <SLArBackgroundGeneratorAction.hh>
 #include <SLArGENIEGeneratorAction.hh>
+#include <SLArPhaseSpaceGeneratorAction.hh>
 #ifdef SLAR_CRY
 #include <cry/SLArCRYGeneratorAction.hh>
 #endif
@@ -226,6 +227,14 @@ void SLArPrimaryGeneratorAction::AddGenerator(const rapidjson::Value& jgen) {
       }
 #endif
 
+    case (kPhaseSpace) : 
+      {
+        auto gen = new SLArPhaseSpaceGeneratorAction(label); 
+        gen->Configure( jgen["config"] ); 
+        this_gen = gen; 
+        break;
+      }
+
     default:
       {
         gen::printGeneratorType(); 
@@ -290,6 +299,10 @@ SLArPrimaryGeneratorAction::~SLArPrimaryGeneratorAction()
         delete local;
       }
 #endif 
+      else if (igen == kPhaseSpace) {
+        auto local = (SLArPhaseSpaceGeneratorAction*)gen.second;
+        delete local;
+      }
       //gen = nullptr;
     }
   }
@@ -4,6 +4,14 @@
  * @created     Thursday Sep 21, 2023 18:15:34 CEST
  */
 
+#include <cstdio>
+#include <stdexcept>
+
+#include "TH1.h"
+#include "TFile.h"
+
+#include "SLArUnit.hpp"
+
 #include "SLArRandomExtra.hh"
 
 G4ThreeVector SampleRandomDirection() {
@@ -19,3 +27,246 @@ G4ThreeVector SampleRandomDirection() {
   return dir; 
 }
 
+G4ThreeVector SampleHemisphereDirection(const G4ThreeVector& normal) {
+  double cosTheta = G4UniformRand();
+  double phi = CLHEP::twopi*G4UniformRand();
+  double sinTheta = std::sqrt(1. - cosTheta*cosTheta);
+
+  G4ThreeVector dir(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+  dir.rotateUz(normal);
+
+  return dir;
+}
+
+G4ThreeVector SampleCosineDirection(const G4ThreeVector& normal) {
+  // p(cos) ~ cos on [0, 1] => cos = sqrt(u)
+  double cosTheta = std::sqrt(G4UniformRand());
+  double phi = CLHEP::twopi*G4UniformRand();
+  double sinTheta = std::sqrt(1. - cosTheta*cosTheta);
+
+  G4ThreeVector dir(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+  dir.rotateUz(normal);
+
+  return dir;
+}
+
+G4ThreeVector SampleDirectionAroundAxis(const G4ThreeVector& axis, const G4double cosTheta) {
+  double phi = CLHEP::twopi*G4UniformRand();
+  double sinTheta = std::sqrt(1. - cosTheta*cosTheta);
+
+  G4ThreeVector dir(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+  dir.rotateUz(axis);
+
+  return dir;
+}
+
+SLArAliasTable::SLArAliasTable(const std::vector<G4double>& weights) {
+  Build(weights);
+}
+
+/**
+ * @details Build the alias table with Vose's algorithm: bins with a scaled
+ * probability below one are paired with an alias taken from the bins
+ * above one, so that each table entry holds at most two outcomes.
+ */
+void SLArAliasTable::Build(const std::vector<G4double>& weights) {
+  const size_t n = weights.size();
+  fTotalWeight = 0.0;
+  for (const auto& w : weights) {
+    if (w < 0) {
+      throw std::invalid_argument("SLArAliasTable::Build: negative weight in distribution\n");
+    }
+    fTotalWeight += w;
+  }
+  if (n == 0 || fTotalWeight <= 0) {
+    throw std::invalid_argument("SLArAliasTable::Build: empty distribution\n");
+  }
+
+  fProb.resize(n);
+  fAlias.resize(n);
+  std::vector<G4double> scaled(n);
+  std::vector<size_t> small;
+  std::vector<size_t> large;
+  for (size_t i = 0; i < n; i++) {
+    scaled[i] = weights[i] * n / fTotalWeight;
+    if (scaled[i] < 1.0) small.push_back(i);
+    else large.push_back(i);
+  }
+
+  while (!small.empty() && !large.empty()) {
+    const size_t s = small.back(); small.pop_back();
+    const size_t l = large.back(); large.pop_back();
+    fProb[s] = scaled[s];
+    fAlias[s] = l;
+    scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+    if (scaled[l] < 1.0) small.push_back(l);
+    else large.push_back(l);
+  }
+  // leftovers are full bins (up to rounding)
+  for (const auto& i : large) {fProb[i] = 1.0; fAlias[i] = i;}
+  for (const auto& i : small) {fProb[i] = 1.0; fAlias[i] = i;}
+
+  return;
+}
+
+size_t SLArAliasTable::SampleIndex() const {
+  const size_t n = fProb.size();
+  const G4double u = G4UniformRand() * n;
+  size_t i = static_cast<size_t>(u);
+  if (i >= n) i = n - 1;
+  return (u - i < fProb[i]) ? i : fAlias[i];
+}
+
+/**
+ * @details In histogram mode `x` holds the n+1 bin edges and `y` the n bin
+ * contents. In linear mode `x` and `y` are the points of the pdf and the
+ * alias table is built from the trapezoid area of each segment.
+ */
+void SLArSpectrumSampler::Build(
+    const std::vector<G4double>& x, const std::vector<G4double>& y, 
+    const EInterpolation interpolation)
+{
+  std::vector<G4double> weights; 
+  if (interpolation == kHistogram) {
+    if (x.size() != y.size() + 1) {
+      throw std::invalid_argument("SLArSpectrumSampler::Build: bin edges and contents size mismatch\n");
+    }
+    weights = y; 
+    fY.clear(); 
+  }
+  else {
+    if (x.size() != y.size() || x.size() < 2) {
+      throw std::invalid_argument("SLArSpectrumSampler::Build: pdf points size mismatch\n");
+    }
+    weights.resize(x.size() - 1); 
+    for (size_t i = 0; i < weights.size(); i++) {
+      if (y[i] < 0) {
+        throw std::invalid_argument("SLArSpectrumSampler::Build: negative pdf value\n");
+      }
+      weights[i] = 0.5*(y[i] + y[i+1])*(x[i+1] - x[i]); 
+    }
+    fY = y; 
+  }
+
+  for (size_t i = 0; i + 1 < x.size(); i++) {
+    if (x[i+1] < x[i]) {
+      throw std::invalid_argument("SLArSpectrumSampler::Build: x values must be sorted\n");
+    }
+  }
+
+  fX = x;
+  fInterpolation = interpolation; 
+  fTable.Build(weights);
+  return;
+}
+
+/**
+ * @details In linear mode the pdf points are placed at the bin centers
+ */
+void SLArSpectrumSampler::BuildFromHistogram(const TH1* h, const EInterpolation interpolation) {
+  const int nbins = h->GetNbinsX();
+  std::vector<G4double> x; 
+  std::vector<G4double> y(nbins);
+  for (int i = 0; i < nbins; i++) y[i] = h->GetBinContent(i+1);
+
+  if (interpolation == kHistogram) {
+    x.resize(nbins + 1); 
+    for (int i = 0; i < nbins; i++) x[i] = h->GetXaxis()->GetBinLowEdge(i+1);
+    x[nbins] = h->GetXaxis()->GetBinUpEdge(nbins);
+  }
+  else {
+    x.resize(nbins); 
+    for (int i = 0; i < nbins; i++) x[i] = h->GetXaxis()->GetBinCenter(i+1);
+  }
+
+  Build(x, y, interpolation);
+  return;
+}
+
+void SLArSpectrumSampler::Configure(const rapidjson::Value& jspec) {
+  const G4double vunit = (jspec.HasMember("unit")) ? unit::GetJSONunit(jspec) : 1.0; 
+
+  G4bool has_interpolation = jspec.HasMember("interpolation"); 
+  EInterpolation interpolation = kHistogram; 
+  if (has_interpolation) {
+    G4String interp_str = jspec["interpolation"].GetString(); 
+    if (interp_str == "histogram") interpolation = kHistogram; 
+    else if (interp_str == "linear") interpolation = kLinear; 
+    else {
+      char err_msg[200]; 
+      sprintf(err_msg, "SLArSpectrumSampler::Configure ERROR: unknown interpolation %s\n", 
+          interp_str.data()); 
+      throw std::invalid_argument(err_msg); 
+    }
+  }
+
+  if (jspec.HasMember("file")) {
+    if (jspec.HasMember("key") == false) {
+      throw std::invalid_argument("SLArSpectrumSampler::Configure: missing histogram \"key\"\n"); 
+    }
+    TFile input_file(jspec["file"].GetString()); 
+    if (input_file.IsOpen() == false) {
+      char err_msg[200]; 
+      sprintf(err_msg, "SLArSpectrumSampler::Configure ERROR: cannot open %s\n", 
+          jspec["file"].GetString()); 
+      throw std::runtime_error(err_msg); 
+    }
+    TH1* h = input_file.Get<TH1>(jspec["key"].GetString()); 
+    if (h == nullptr) {
+      char err_msg[200]; 
+      sprintf(err_msg, "SLArSpectrumSampler::Configure ERROR: cannot read %s from %s\n", 
+          jspec["key"].GetString(), jspec["file"].GetString()); 
+      throw std::runtime_error(err_msg); 
+    }
+    BuildFromHistogram(h, interpolation); 
+    input_file.Close(); 
+  }
+  else if (jspec.HasMember("x") && jspec.HasMember("y")) {
+    std::vector<G4double> x; 
+    std::vector<G4double> y; 
+    for (const auto& jx : jspec["x"].GetArray()) x.push_back( jx.GetDouble() ); 
+    for (const auto& jy : jspec["y"].GetArray()) y.push_back( jy.GetDouble() ); 
+    if (has_interpolation == false) {
+      interpolation = (x.size() == y.size()) ? kLinear : kHistogram; 
+    }
+    Build(x, y, interpolation); 
+  }
+  else {
+    throw std::invalid_argument("SLArSpectrumSampler::Configure: distribution requires \"file\" and \"key\" or \"x\" and \"y\" fields\n"); 
+  }
+
+  for (auto& x : fX) x *= vunit; 
+  return;
+}
+
+/**
+ * @details In linear mode the position within the segment is sampled by
+ * inverting the cdf of the trapezoid pdf, written in a form that is stable
+ * for flat segments.
+ */
+G4double SLArSpectrumSampler::Sample() const {
+  const size_t ibin = fTable.SampleIndex();
+  const G4double dx = fX[ibin+1] - fX[ibin]; 
+  const G4double u = G4UniformRand(); 
+
+  if (fInterpolation == kHistogram) return fX[ibin] + u*dx;
+
+  const G4double y0 = fY[ibin]; 
+  const G4double y1 = fY[ibin+1]; 
+  const G4double denom = y0 + std::sqrt(y0*y0 + u*(y1 - y0)*(y0 + y1)); 
+  const G4double t = (denom > 0) ? u*(y0 + y1) / denom : u; 
+  return fX[ibin] + t*dx;
+}
+
+rapidjson::Value SLArSpectrumSampler::ExportConfig(
+    rapidjson::Document::AllocatorType& allocator) const
+{
+  rapidjson::Value jspec(rapidjson::kObjectType); 
+  jspec.AddMember("interpolation", 
+      rapidjson::StringRef((fInterpolation == kHistogram) ? "histogram" : "linear"), allocator); 
+  jspec.AddMember("n_bins", static_cast<uint64_t>(fTable.GetSize()), allocator); 
+  jspec.AddMember("min", GetMin(), allocator); 
+  jspec.AddMember("max", GetMax(), allocator); 
+  return jspec; 
+}
+
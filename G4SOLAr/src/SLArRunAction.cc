@@ -12,16 +12,21 @@
 #include "SLArBulkVertexGenerator.hh"
 #include "SLArRunAction.hh"
 #include "SLArRun.hh"
+#include "SLArUserPhotonTrackInformation.hh"
+#include "physics/SLArScintillation.h"
+#include "physics/SLArOpticalLookup.hh"
 
 #include "G4Run.hh"
 #include "G4RunManager.hh"
 #include "G4SDManager.hh"
+#include "G4ProcessTable.hh"
 #include "G4UnitsTable.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 SLArRunAction::SLArRunAction()
- : G4UserRunAction(), fG4MacroFile(""), fEventAction(nullptr), fElectronDrift(nullptr)
+ : G4UserRunAction(), fG4MacroFile(""), fEventAction(nullptr), fElectronDrift(nullptr), 
+   fOpticalLookup(nullptr)
 { 
   // Create custom SLAr Analysis Manager
   SLArAnalysisManager* anamgr = SLArAnalysisManager::Instance();
@@ -32,11 +37,38 @@ SLArRunAction::SLArRunAction()
 SLArRunAction::~SLArRunAction()
 {
   delete SLArAnalysisManager::Instance();
+  if (fOpticalLookup) delete fOpticalLookup;
   fSDName.clear(); 
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+/**
+ * @details When trajectories are stored each optical photon gets a 
+ * SLArUserPhotonTrackInformation, served by a thread-local G4Allocator 
+ * whose default pages hold only a few objects. The pages are made 
+ * kPoolPageFactor times larger once per thread, before any photon 
+ * information is created (growing the page size resets the storage). 
+ * The Geant4 G4Track and G4DynamicParticle pools are owned by the kernel 
+ * and are left untouched. 
+ */
+void SLArRunAction::ConfigurePhotonInfoAllocator() {
+  static G4ThreadLocal G4bool configured = false; 
+  if (configured) return;
+  const G4int kPoolPageFactor = 64; 
+
+  if (SLArUserPhotonTrackInformationAllocator == nullptr) {
+    SLArUserPhotonTrackInformationAllocator = 
+      new G4Allocator<SLArUserPhotonTrackInformation>; 
+  }
+  SLArUserPhotonTrackInformationAllocator->IncreasePageSize( kPoolPageFactor ); 
+
+  configured = true; 
+  return;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 G4Run* SLArRunAction::GenerateRun() {
   return (new SLArRun(fSDName)); 
 }
@@ -53,6 +85,8 @@ void SLArRunAction::BeginOfRunAction(const G4Run* aRun)
 
   SLArAnaMgr->CreateFileStructure();
 
+  ConfigurePhotonInfoAllocator(); 
+
   fElectronDrift = new SLArElectronDrift(); 
   fElectronDrift->ComputeProperties(); 
   fElectronDrift->PrintProperties(); 
@@ -61,6 +95,21 @@ void SLArRunAction::BeginOfRunAction(const G4Run* aRun)
   for (const auto& xsec : SLArAnaMgr->GetXSecDumpVector()) {
     SLArAnaMgr->WriteCrossSection(xsec); 
   }
+
+  // install the optical lookup of the hybrid optical mode in this 
+  // thread's scintillation process
+  auto scint = dynamic_cast<SLArScintillation*>(
+      G4ProcessTable::GetProcessTable()->FindProcess("Scintillation", "e-")); 
+  if (scint && scint->IsHybridMode() && scint->GetOpticalLookup() == nullptr) {
+    auto detector = (SLArDetectorConstruction*)
+      G4RunManager::GetRunManager()->GetUserDetectorConstruction(); 
+    if (fOpticalLookup == nullptr) fOpticalLookup = detector->BuildOpticalLookup(); 
+    scint->SetOpticalLookup( fOpticalLookup ); 
+    printf("SLArRunAction: hybrid optical mode, photons tracked within %g cm of the optical detectors\n", 
+        scint->GetNearFieldDistance() / CLHEP::cm); 
+    printf("SLArRunAction WARNING: the optical lookup neglects Rayleigh scattering, "); 
+    printf("validate it against full tracking before physics use\n"); 
+  }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
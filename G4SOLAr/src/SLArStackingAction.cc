@@ -35,20 +35,27 @@
 #include "SLArAnalysisManager.hh"
 #include "SLArPrimaryGeneratorAction.hh"
 #include "SLArUserTrackInformation.hh"
+#include "SLArUserPrimaryInformation.hh"
+#include "SLArUserRegionInformation.hh"
+#include "SLArDetectorConstruction.hh"
 
 #include "G4VProcess.hh"
 #include "G4RunManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Region.hh"
 
 #include "G4ParticleDefinition.hh"
 #include "G4ParticleTypes.hh"
 #include "G4Track.hh"
+#include "G4PrimaryParticle.hh"
 #include "G4ios.hh"
+#include "Randomize.hh"
 #include <vector>
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 SLArStackingAction::SLArStackingAction(SLArEventAction* ea)
-  : G4UserStackingAction(), fEventAction(ea)
+  : G4UserStackingAction(), fEventAction(ea), fPhotonSurvivalProb(1.0)
 {}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -72,6 +79,20 @@ SLArStackingAction::ClassifyNewTrack(const G4Track * aTrack)
     else {
       //printf("Track ID %i is a new one!\n", aTrack->GetTrackID());
       auto SLArAnaMgr = SLArAnalysisManager::Instance(); 
+
+      // roulette/kill secondaries produced far from the active volume
+      auto& killing_rules = SLArAnaMgr->GetTrackKillingRules(); 
+      if (killing_rules.IsActive() && aTrack->GetParentID() > 0 && aTrack->GetVolume()) {
+        G4double weight = aTrack->GetWeight(); 
+        auto action = killing_rules.Apply(aTrack->GetParticleDefinition(), 
+            aTrack->GetVolume()->GetLogicalVolume(), aTrack->GetPosition(), 
+            aTrack->GetKineticEnergy(), weight); 
+        if (action == SLArTrackKillingRules::kKill) return fKill;
+        if (action == SLArTrackKillingRules::kRoulette) {
+          const_cast<G4Track*>(aTrack)->SetWeight( weight ); 
+        }
+      }
+
       G4int parentID = 0; 
       if (aTrack->GetParentID() == 0) { // this is a primary
         fEventAction->RegisterNewTrackPID(aTrack->GetTrackID(), aTrack->GetTrackID()); 
@@ -80,24 +101,14 @@ SLArStackingAction::ClassifyNewTrack(const G4Track * aTrack)
             //aTrack->GetTrackID(), aTrack->GetParticleDefinition()->GetPDGEncoding());
 
         // fix track ID in primary output object
-        auto& primaries = SLArAnaMgr->GetEvent().GetPrimaries();
-        for (auto &primaryInfo : primaries) {
-          if (aTrack->GetDynamicParticle()->GetPDGcode() == primaryInfo.GetCode()) {
-            G4double tolerance = 1e-3;
-            if (primaryInfo.GetCode() > 10000) {
-              //printf("possible canidate %i - [%g, %g, %g] vs [%g, %g, %g]\n", 
-                  //primaryInfo.GetCode(), 
-                  //aTrack->GetMomentum().x(), aTrack->GetMomentum().y(), aTrack->GetMomentum().z(), 
-                  //primaryInfo.GetMomentum()[0], primaryInfo.GetMomentum()[1], primaryInfo.GetMomentum()[2]); 
-              tolerance = 5e-2;
-            }
-            if (fabs(aTrack->GetMomentum().x() - primaryInfo.GetMomentum()[0]) < tolerance &&
-                fabs(aTrack->GetMomentum().y() - primaryInfo.GetMomentum()[1]) < tolerance &&
-                fabs(aTrack->GetMomentum().z() - primaryInfo.GetMomentum()[2]) < tolerance) {
-              //printf("This is a primary: Corrsponding primary info found (%i)\n", primaryInfo.GetTrackID());
-              primaryInfo.SetTrackID(aTrack->GetTrackID()); 
-              break;
-            }
+        const G4PrimaryParticle* g4primary = 
+          aTrack->GetDynamicParticle()->GetPrimaryParticle(); 
+        if (g4primary) {
+          auto primaryInfo = 
+            dynamic_cast<SLArUserPrimaryInformation*>(g4primary->GetUserInformation()); 
+          if (primaryInfo) {
+            SLArAnaMgr->GetEvent().SetPrimaryTrackID(
+                primaryInfo->GetPrimaryIdx(), aTrack->GetTrackID()); 
           }
         }
       } else {
@@ -142,18 +153,9 @@ SLArStackingAction::ClassifyNewTrack(const G4Track * aTrack)
       trajectory->SetInitMomentum( vertex_momentum.x(), vertex_momentum.y(), vertex_momentum.z() );
       G4int ancestor_id = fEventAction->FindAncestorID( parentID ); 
 
-      SLArMCPrimaryInfo* ancestor = nullptr; 
-      auto& primaries = SLArAnaMgr->GetEvent().GetPrimaries();
-      for (auto &p : primaries) {
-        if (p.GetTrackID() == ancestor_id) {
-          ancestor = &p; 
-          break;
-        }
-      }
+      SLArMCPrimaryInfo* ancestor = 
+        SLArAnaMgr->GetEvent().FindPrimaryByTrkID( ancestor_id ); 
       if (!ancestor) printf("Unable to find corresponding primary particle\n");
-#ifdef SLAR_DEBUG
-      if (!ancestor) printf("Unable to find corresponding primary particle\n");
-#endif
 
       ancestor->RegisterTrajectory( std::move(trajectory) ); 
 
@@ -168,24 +170,22 @@ SLArStackingAction::ClassifyNewTrack(const G4Track * aTrack)
   { // particle is optical photon
     if(aTrack->GetParentID()>0)
     { // particle is secondary
-      SLArAnalysisManager* anaMngr = SLArAnalysisManager::Instance(); 
-      SLArMCPrimaryInfo* primary = nullptr; 
-      //SLArMCPrimaryInfoPtr* primary = nullptr; 
-      auto& primaries = anaMngr->GetEvent().GetPrimaries();
+      // drop photons produced in regions where optical physics is disabled
+      if (aTrack->GetVolume()) {
+        auto region_info = dynamic_cast<SLArUserRegionInformation*>(
+            aTrack->GetVolume()->GetLogicalVolume()->GetRegion()->GetUserInformation()); 
+        if (region_info && region_info->IsOpticalEnabled() == false) {
+          return G4ClassificationOfNewTrack::fKill; 
+        }
+      }
 
+      SLArAnalysisManager* anaMngr = SLArAnalysisManager::Instance(); 
       int primary_parent_id = fEventAction->FindAncestorID(aTrack->GetParentID()); 
 //#ifdef SLAR_DEBUG
       //printf("Primary parent ID %i\n", primary_parent_id);
 //#endif
-      for (auto &p : primaries) {
-        if (p.GetTrackID() == primary_parent_id) {
-          primary = &p; 
-//#ifdef SLAR_DEBUG
-          //printf("primary parent found\n");
-//#endif
-          break; 
-        }
-      }
+      SLArMCPrimaryInfo* primary = 
+        anaMngr->GetEvent().FindPrimaryByTrkID( primary_parent_id ); 
        
 #ifdef SLAR_DEBUG
       if (!primary) printf("Unable to find corresponding primary particle\n");
@@ -214,6 +214,22 @@ SLArStackingAction::ClassifyNewTrack(const G4Track * aTrack)
       if (generatorAction->DoTraceOptPhotons() == false) {
         kClassification = G4ClassificationOfNewTrack::fKill;
       }
+      // early PDE culling: the photon counts above are complete, only a
+      // fraction of the photons is tracked to the (rescaled) sensors. 
+      // WLS photons inherit the survival of their parent. 
+      else if (fPhotonSurvivalProb < 1.0 && 
+          aTrack->GetCreatorProcess()->GetProcessName() != "WLS" && 
+          G4UniformRand() > fPhotonSurvivalProb) {
+        kClassification = G4ClassificationOfNewTrack::fKill;
+      }
+    }
+    else 
+    { // primary optical photon (e.g. photon bomb)
+      // the sensor efficiencies are rescaled for all the photons, so the
+      // primary photons undergo the same early PDE culling
+      if (fPhotonSurvivalProb < 1.0 && G4UniformRand() > fPhotonSurvivalProb) {
+        kClassification = G4ClassificationOfNewTrack::fKill;
+      }
     }
   }
 
@@ -228,7 +244,15 @@ void SLArStackingAction::NewStage()
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+/**
+ * @details The photon survival probability is read from the detector 
+ * construction here since the user actions are created before the geometry
+ */
 void SLArStackingAction::PrepareNewEvent()
-{}
+{
+  auto construction = (const SLArDetectorConstruction*)
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction(); 
+  if (construction) fPhotonSurvivalProb = construction->GetPhotonSurvivalProb(); 
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -31,8 +31,12 @@
 //
 #include "G4Track.hh"
 #include "G4VParticleChange.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Region.hh"
 
 #include "SLArStepMax.hh"
+#include "SLArUserRegionInformation.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -66,7 +70,7 @@ void SLArStepMax::SetStepMax(G4double step) { fMaxChargedStep = step ; }
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 G4double SLArStepMax::PostStepGetPhysicalInteractionLength(
-                                              const G4Track&,
+                                              const G4Track& aTrack,
                                               G4double,
                                               G4ForceCondition* condition)
 {
@@ -77,6 +81,16 @@ G4double SLArStepMax::PostStepGetPhysicalInteractionLength(
 
   if ( fMaxChargedStep > 0.) ProposedStep = fMaxChargedStep;
 
+  // the max step of the current region overrides the global one
+  const G4VPhysicalVolume* volume = aTrack.GetVolume();
+  if (volume) {
+    const auto region_info = dynamic_cast<const SLArUserRegionInformation*>(
+        volume->GetLogicalVolume()->GetRegion()->GetUserInformation()); 
+    if (region_info && region_info->GetMaxStep() < DBL_MAX) {
+      ProposedStep = region_info->GetMaxStep(); 
+    }
+  }
+
    return ProposedStep;
 }
 
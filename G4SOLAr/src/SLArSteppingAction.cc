@@ -22,7 +22,7 @@
 #include "G4HadProcesses.hh"
 
 #include "G4Event.hh"
-#include "G4RunManager.hh"
+#include "G4EventManager.hh"
 #include "G4Run.hh"
 #include "G4SDManager.hh"
 #include "G4PVReplica.hh"
@@ -102,8 +102,8 @@ void SLArSteppingAction::UserSteppingAction(const G4Step* step)
 
   
   if (track->GetParticleDefinition() != G4OpticalPhoton::OpticalPhotonDefinition()) {
-    auto trkInfo = (SLArUserTrackInformation*)track->GetUserInformation(); 
-    SLArEventTrajectory* trajectory = trkInfo->GimmeEvTrajectory();
+    auto trkInfo = dynamic_cast<SLArUserTrackInformation*>(track->GetUserInformation()); 
+    SLArEventTrajectory* trajectory = (trkInfo) ? trkInfo->GimmeEvTrajectory() : nullptr;
     double edep = step->GetTotalEnergyDeposit();
     auto stepMngr = fTrackinAction->GetTrackingManager()->GetSteppingManager(); 
     int n_ph = 0; 
@@ -125,7 +125,7 @@ void SLArSteppingAction::UserSteppingAction(const G4Step* step)
       }
     }
 
-    if (trkInfo->CheckStoreTrajectory() == true) {
+    if (trajectory && trkInfo->CheckStoreTrajectory() == true) {
       if (trajectory->GetPoints().empty()) {
         // record origin point
         //printf("recording origin point:\n"); 
@@ -142,9 +142,11 @@ void SLArSteppingAction::UserSteppingAction(const G4Step* step)
       }
     }
 
-    trajectory->IncrementEdep( edep ); 
-    trajectory->IncrementNion( n_el ); 
-    trajectory->IncrementNph ( n_ph ); 
+    if (trajectory) {
+      trajectory->IncrementEdep( edep ); 
+      trajectory->IncrementNion( n_el ); 
+      trajectory->IncrementNph ( n_ph ); 
+    }
 
     //printf("SLArSteppingAction::UserSteppingAction: adding %i ph and %i e ion. to %s [%i]\n", 
         //n_ph, n_el, 
@@ -158,15 +160,55 @@ void SLArSteppingAction::UserSteppingAction(const G4Step* step)
     //getchar(); 
 
     G4String terminator; 
+    auto anaMngr = SLArAnalysisManager::Instance(); 
+
+    // importance pilot run: score the population entering each cell. The 
+    // pre-step weight is used, since with importance biasing active the 
+    // post-step weight has already been split or rouletted at this boundary
+    auto& imp_map = anaMngr->GetImportanceMap(); 
+    if (imp_map.IsScoring() && 
+        thePostPoint->GetStepStatus() == fGeomBoundary && 
+        thePostPoint->GetPhysicalVolume() != nullptr && 
+        particleDef->GetParticleName() == imp_map.GetScoringParticle()) 
+    {
+      imp_map.ScoreEntry( thePostPoint->GetPhysicalVolume(), 
+          thePostPoint->GetTouchableHandle()->GetReplicaNumber(), 
+          thePrePoint->GetWeight() ); 
+    }
 
-#ifdef SLAR_EXTERNAL
-   if (thePostPoint->GetStepStatus() == fGeomBoundary) {
+    // roulette/kill the tracks entering volumes far from the active volume
+    auto& killing_rules = anaMngr->GetTrackKillingRules(); 
+    if (killing_rules.IsActive() && 
+        thePostPoint->GetStepStatus() == fGeomBoundary && 
+        thePostPoint->GetPhysicalVolume() != nullptr) 
+    {
+      G4double weight = track->GetWeight(); 
+      auto action = killing_rules.Apply(particleDef, 
+          thePostPoint->GetPhysicalVolume()->GetLogicalVolume(), 
+          thePostPoint->GetPosition(), thePostPoint->GetKineticEnergy(), weight); 
+      if (action == SLArTrackKillingRules::kKill) {
+        track->SetTrackStatus( fStopAndKill ); 
+        terminator = "SLArTrackKiller"; 
+      }
+      else if (action == SLArTrackKillingRules::kRoulette) {
+        track->SetWeight( weight ); 
+      }
+    }
+
+    // external background mode: stop the tracks at the LAr interface. 
+    // Tracks killed by a rule on this boundary are not recorded
+    if (anaMngr->IsExternalMode() && trajectory && 
+        terminator.empty() && 
+        thePostPoint->GetStepStatus() == fGeomBoundary) {
       if ( G4StrUtil::contains(thePostPV->GetLogicalVolume()->GetMaterial()->GetName(), "LAr") )
       {
         track->SetTrackStatus( fStopAndKill ); 
         
-        auto& ext_record = SLArAnalysisManager::Instance()->GetExternalRecord(); 
-        auto iev = G4RunManager::GetRunManager()->GetCurrentRun()->GetNumberOfEvent();
+        auto& ext_record = anaMngr->GetExternalRecord(); 
+        // same event number as the scorer records of SLArEventAction (the 
+        // run event counter differs from the event ID in MT runs)
+        const auto iev = 
+          G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID();
         ext_record.SetEvNumber( iev ); 
         ext_record.SetValues( *trajectory ); 
         ext_record.SetEnergyAtScorer( thePrePoint->GetKineticEnergy() ); 
@@ -174,14 +216,26 @@ void SLArSteppingAction::UserSteppingAction(const G4Step* step)
                                       thePostPoint->GetPosition().y(), 
                                       thePostPoint->GetPosition().z()); 
 
-        SLArAnalysisManager::Instance()->GetExternalsTree()->Fill(); 
+        anaMngr->GetExternalsTree()->Fill(); 
 
         ext_record.Reset(); 
 
+        auto& ps_record = anaMngr->GetPhaseSpaceRecord(); 
+        const auto& pos = thePostPoint->GetPosition(); 
+        const auto& dir = thePostPoint->GetMomentumDirection(); 
+        ps_record.fEvNumber = iev; 
+        ps_record.fPDGCode = trajectory->GetPDGID(); 
+        ps_record.fScorerID = -1; 
+        ps_record.fX = pos.x(); ps_record.fY = pos.y(); ps_record.fZ = pos.z(); 
+        ps_record.fUx = dir.x(); ps_record.fUy = dir.y(); ps_record.fUz = dir.z(); 
+        ps_record.fEnergy = thePostPoint->GetKineticEnergy(); 
+        ps_record.fTime = thePostPoint->GetGlobalTime(); 
+        ps_record.fWeight = track->GetWeight(); // includes the roulette weight
+        anaMngr->FillPhaseSpaceTree(); 
+
         terminator = "SLArUserInterfaceKiller";
       }
-   }
-#endif 
+    }
 
     if (track->GetTrackStatus() == fStopAndKill) {
 
@@ -260,7 +314,7 @@ void SLArSteppingAction::UserSteppingAction(const G4Step* step)
       thePrePV != thePostPV) {
 
     SLArUserPhotonTrackInformation* phInfo = 
-      (SLArUserPhotonTrackInformation*)track->GetUserInformation();
+      dynamic_cast<SLArUserPhotonTrackInformation*>(track->GetUserInformation());
 
     //find the boundary process only once
     if(!boundary){
@@ -357,8 +411,10 @@ void SLArSteppingAction::UserSteppingAction(const G4Step* step)
              //getchar(); 
 #endif
 
-            if (phInfo) phInfo->AddTrackStatusFlag(hitPMT);
-            if (volName=="SiPMActivePV") {
+            // flat anodes stop all photons, only those detected by a SiPM are flagged
+            const G4bool is_flat_anode = (volName == "AnodeSensorPlanePV"); 
+            if (phInfo && !is_flat_anode) phInfo->AddTrackStatusFlag(hitPMT);
+            if (volName=="SiPMActivePV" || is_flat_anode) {
 //#ifdef SLAR_DEBUG
               //printf("Copy No hierarchy: [%i, %i, %i, %i, %i, %i, %i, %i, %i, %i]\n", 
                   //touchable->GetCopyNumber(0), 
@@ -380,8 +436,15 @@ void SLArSteppingAction::UserSteppingAction(const G4Step* step)
 //#endif
               sipmSD = (SLArReadoutTileSD*)SDman->FindSensitiveDetector(sdNameSiPM);
               if(sipmSD) { 
-                fEventAction->IncReadoutTileHitCount(); 
-                sipmSD->ProcessHits_constStep(step, nullptr);
+                // photons reaching a flat anode outside of a SiPM, or not detected
+                // by the SiPM surface, leave no hit
+                if (sipmSD->ProcessHits_constStep(step, nullptr)) {
+                  fEventAction->IncReadoutTileHitCount(); 
+                  if (phInfo && is_flat_anode) phInfo->AddTrackStatusFlag(hitPMT);
+                }
+                else if (phInfo && is_flat_anode) {
+                  phInfo->AddTrackStatusFlag(boundaryAbsorbed);
+                }
               } else {
 #ifdef SLAR_DEBUG
                 printf("SLArSteppingAction::UserSteppingAction::Detection WARNING\n"); 
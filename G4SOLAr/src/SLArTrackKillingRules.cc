@@ -0,0 +1,179 @@
+/**
+ * @author      : Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        : SLArTrackKillingRules.cc
+ * @created     : Monday Oct 19, 2026 20:22:05 CEST
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <stdexcept>
+
+#include "rapidjson/filereadstream.h"
+
+#include "G4LogicalVolume.hh"
+#include "G4ParticleTable.hh"
+#include "Randomize.hh"
+
+#include "SLArUnit.hpp"
+#include "SLArTrackKillingRules.hh"
+
+G4bool SLArTrackKillingRules::Rule_t::MatchVolume(const G4String& lv_name) const {
+  for (const auto& vol : fVolumes) {
+    if (vol.back() == '*') {
+      if (lv_name.compare(0, vol.size()-1, vol, 0, vol.size()-1) == 0) return true;
+    }
+    else if (lv_name == vol) return true;
+  }
+  return false;
+}
+
+G4bool SLArTrackKillingRules::Rule_t::MatchParticle(const G4ParticleDefinition* particle) const {
+  if (fParticles.empty()) return true;
+  for (const auto& p : fParticles) {
+    if (p == particle) return true;
+  }
+  return false;
+}
+
+SLArTrackKillingRules::SLArTrackKillingRules()
+  : fTargetCenter(0, 0, 0), fTargetHalfSize(0, 0, 0)
+{}
+
+void SLArTrackKillingRules::Load(const G4String& file_path) {
+  FILE* rules_file = std::fopen(file_path, "r");
+  if (rules_file == nullptr) {
+    char err_msg[200];
+    sprintf(err_msg, "SLArTrackKillingRules::Load ERROR: cannot open %s\n", file_path.data());
+    throw std::runtime_error(err_msg);
+  }
+  char readBuffer[65536];
+  rapidjson::FileReadStream is(rules_file, readBuffer, sizeof(readBuffer));
+
+  rapidjson::Document d;
+  d.ParseStream<rapidjson::kParseCommentsFlag>(is);
+  std::fclose(rules_file);
+
+  if (!d.IsObject() || !d.HasMember("track_killing")) {
+    char err_msg[200];
+    sprintf(err_msg, "SLArTrackKillingRules::Load ERROR: missing \"track_killing\" field in %s\n",
+        file_path.data());
+    throw std::invalid_argument(err_msg);
+  }
+
+  // a new file replaces the rules loaded so far
+  fRules.clear();
+  Configure( d["track_killing"] );
+  return;
+}
+
+void SLArTrackKillingRules::Configure(const rapidjson::Value& jrules) {
+  assert( jrules.IsArray() );
+  auto particle_table = G4ParticleTable::GetParticleTable();
+
+  for (const auto& jrule : jrules.GetArray()) {
+    Rule_t rule;
+    if (jrule.HasMember("volumes") == false) {
+      throw std::invalid_argument("SLArTrackKillingRules::Configure: rule without \"volumes\" field\n");
+    }
+    for (const auto& jvol : jrule["volumes"].GetArray()) {
+      rule.fVolumes.push_back( jvol.GetString() );
+    }
+    if (rule.fVolumes.empty()) {
+      throw std::invalid_argument("SLArTrackKillingRules::Configure: rule with empty \"volumes\" list\n");
+    }
+    if (jrule.HasMember("particles")) {
+      for (const auto& jp : jrule["particles"].GetArray()) {
+        const auto particle = particle_table->FindParticle( jp.GetString() );
+        if (particle == nullptr) {
+          char err_msg[200];
+          sprintf(err_msg, "SLArTrackKillingRules::Configure ERROR: unknown particle %s\n",
+              jp.GetString());
+          throw std::invalid_argument(err_msg);
+        }
+        rule.fParticles.push_back( particle );
+      }
+    }
+    if (jrule.HasMember("energy_threshold")) {
+      rule.fEnergyThreshold = unit::ParseJsonVal( jrule["energy_threshold"] );
+    }
+    if (jrule.HasMember("min_distance")) {
+      rule.fMinDistance = unit::ParseJsonVal( jrule["min_distance"] );
+    }
+    if (jrule.HasMember("survival")) {
+      rule.fSurvivalProb = jrule["survival"].GetDouble();
+    }
+    if (rule.fSurvivalProb < 0 || rule.fSurvivalProb >= 1) {
+      throw std::invalid_argument("SLArTrackKillingRules::Configure: survival probability must be in [0, 1)\n");
+    }
+    fRules.push_back( rule );
+  }
+
+  fVolumeRules.clear();
+  printf("SLArTrackKillingRules: %lu rule(s) configured\n", fRules.size());
+  return;
+}
+
+void SLArTrackKillingRules::SetTarget(const G4ThreeVector& center, const G4ThreeVector& half_size) {
+  fTargetCenter = center;
+  fTargetHalfSize = half_size;
+  return;
+}
+
+G4double SLArTrackKillingRules::GetDistanceToTarget(const G4ThreeVector& pos) const {
+  G4double d2 = 0.0;
+  for (int i = 0; i < 3; i++) {
+    const G4double d = std::fabs(pos[i] - fTargetCenter[i]) - fTargetHalfSize[i];
+    if (d > 0) d2 += d*d;
+  }
+  return std::sqrt(d2);
+}
+
+/**
+ * @details Apply the first rule matching the track. When the track survives
+ * the roulette its weight is divided by the survival probability.
+ *
+ * @return kKill if the track must be killed, kRoulette if its weight has
+ * been updated, kKeep if no rule applies
+ */
+SLArTrackKillingRules::EAction SLArTrackKillingRules::Apply(
+    const G4ParticleDefinition* particle, const G4LogicalVolume* lv,
+    const G4ThreeVector& pos, const G4double ekin, G4double& weight)
+{
+  auto volume_rules = fVolumeRules.find( lv );
+  if (volume_rules == fVolumeRules.end()) {
+    std::vector<size_t> matching;
+    for (size_t i = 0; i < fRules.size(); i++) {
+      if (fRules[i].MatchVolume( lv->GetName() )) matching.push_back( i );
+    }
+    volume_rules = fVolumeRules.insert( std::make_pair(lv, matching) ).first;
+  }
+
+  for (const auto& irule : volume_rules->second) {
+    auto& rule = fRules[irule];
+    if (ekin >= rule.fEnergyThreshold) continue;
+    if (rule.MatchParticle( particle ) == false) continue;
+    if (rule.fMinDistance > 0 && GetDistanceToTarget( pos ) < rule.fMinDistance) continue;
+
+    if (rule.fSurvivalProb > 0 && G4UniformRand() < rule.fSurvivalProb) {
+      weight /= rule.fSurvivalProb;
+      rule.fNSurvived++;
+      return kRoulette;
+    }
+    rule.fNKilled++;
+    return kKill;
+  }
+
+  return kKeep;
+}
+
+void SLArTrackKillingRules::PrintSummary() const {
+  printf("SLArTrackKillingRules summary\n");
+  for (size_t i = 0; i < fRules.size(); i++) {
+    const auto& rule = fRules[i];
+    printf("- rule %lu (%s%s): %i killed, %i survived the roulette (p = %g)\n",
+        i, rule.fVolumes.front().data(), rule.fVolumes.size() > 1 ? ", ..." : "",
+        rule.fNKilled, rule.fNSurvived, rule.fSurvivalProb);
+  }
+  return;
+}
+
@@ -95,7 +95,7 @@ void SLArTrackingAction::PostUserTrackingAction(const G4Track* aTrack){
     if(aTrack->GetDefinition()==
         G4OpticalPhoton::OpticalPhotonDefinition()){
       SLArUserPhotonTrackInformation*
-        trackInformation=(SLArUserPhotonTrackInformation*)aTrack->GetUserInformation();
+        trackInformation=dynamic_cast<SLArUserPhotonTrackInformation*>(aTrack->GetUserInformation());
 
       /*
        *const G4VProcess* creator=aTrack->GetCreatorProcess();
@@ -6,6 +6,11 @@
 
 #include "SLArUserPhotonTrackInformation.hh"
 
+G4ThreadLocal G4Allocator<SLArUserPhotonTrackInformation>* 
+  SLArUserPhotonTrackInformationAllocator = nullptr;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 SLArUserPhotonTrackInformation::SLArUserPhotonTrackInformation()
   : fStatus(active),fReflections(0),fForcedraw(false) {}
 
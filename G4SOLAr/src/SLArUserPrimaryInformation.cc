@@ -0,0 +1,14 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArUserPrimaryInformation.cc
+ * @created     Mon Oct 19, 2026 10:14:02 CEST
+ */
+
+#include "SLArUserPrimaryInformation.hh"
+
+#include <cstdio>
+
+void SLArUserPrimaryInformation::Print() const {
+  printf("SLArUserPrimaryInformation: primary index %lu\n", fPrimaryIdx); 
+  return;
+}
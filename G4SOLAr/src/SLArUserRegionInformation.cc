@@ -0,0 +1,151 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArUserRegionInformation.cc
+ * @created     Monday Oct 19, 2026 21:11:40 CEST
+ */
+
+#include <cstdio>
+#include <stdexcept>
+
+#include "G4Region.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4UserLimits.hh"
+
+#include "SLArUnit.hpp"
+#include "SLArUserRegionInformation.hh"
+
+SLArUserRegionInformation::SLArUserRegionInformation()
+  : G4VUserRegionInformation(), fName(""), fMaxStep(DBL_MAX), fOpticalEnabled(true), 
+    fOpticalFastSim(false), fOpticalHandoffDistance(1.0*CLHEP::cm)
+{}
+
+void SLArUserRegionInformation::Configure(const rapidjson::Value& jregion) {
+  if (jregion.HasMember("name") == false || jregion.HasMember("volumes") == false) {
+    throw std::invalid_argument("SLArUserRegionInformation::Configure: region requires \"name\" and \"volumes\" fields\n");
+  }
+  fName = jregion["name"].GetString();
+  for (const auto& jvol : jregion["volumes"].GetArray()) {
+    fVolumes.push_back( jvol.GetString() );
+  }
+  if (fVolumes.empty()) {
+    char err_msg[200];
+    sprintf(err_msg, "SLArUserRegionInformation::Configure: region %s has no root volume\n",
+        fName.data());
+    throw std::invalid_argument(err_msg);
+  }
+
+  if (jregion.HasMember("production_cuts")) {
+    const auto& jcuts = jregion["production_cuts"];
+    for (const auto& particle : {"gamma", "e-", "e+", "proton"}) {
+      if (jcuts.HasMember(particle)) {
+        fCuts[particle] = unit::ParseJsonVal( jcuts[particle] );
+      }
+      else if (jcuts.HasMember("all")) {
+        fCuts[particle] = unit::ParseJsonVal( jcuts["all"] );
+      }
+    }
+  }
+  if (jregion.HasMember("max_step")) {
+    fMaxStep = unit::ParseJsonVal( jregion["max_step"] );
+  }
+  if (jregion.HasMember("optical")) {
+    fOpticalEnabled = jregion["optical"].GetBool();
+  }
+  if (jregion.HasMember("optical_fast_sim")) {
+    const auto& jfast = jregion["optical_fast_sim"];
+    if (jfast.IsBool()) {
+      fOpticalFastSim = jfast.GetBool();
+    }
+    else {
+      fOpticalFastSim = true;
+      if (jfast.HasMember("handoff_distance")) {
+        fOpticalHandoffDistance = unit::ParseJsonVal( jfast["handoff_distance"] );
+      }
+    }
+    if (fOpticalHandoffDistance <= 0) {
+      char err_msg[200];
+      sprintf(err_msg, "SLArUserRegionInformation::Configure: region %s has a non-positive optical handoff distance\n",
+          fName.data());
+      throw std::invalid_argument(err_msg);
+    }
+  }
+  return;
+}
+
+/**
+ * @details Create the G4Region, attach the root logical volumes and set the
+ * region production cuts and user limits. The region information object is
+ * attached to the region so that the user actions can retrieve it from the
+ * track volume.
+ */
+G4Region* SLArUserRegionInformation::BuildRegion() {
+  auto lv_store = G4LogicalVolumeStore::GetInstance();
+  auto region = new G4Region(fName);
+
+  for (const auto& lv_name : fVolumes) {
+    auto lv = lv_store->GetVolume(lv_name, false);
+    if (lv == nullptr) {
+      char err_msg[200];
+      sprintf(err_msg, "SLArUserRegionInformation::BuildRegion ERROR: cannot find logical volume %s for region %s\n",
+          lv_name.data(), fName.data());
+      throw std::runtime_error(err_msg);
+    }
+    region->AddRootLogicalVolume( lv );
+  }
+
+  ApplyProductionCuts( region );
+
+  if (fMaxStep < DBL_MAX) {
+    region->SetUserLimits( new G4UserLimits(fMaxStep) );
+  }
+
+  region->SetUserInformation( this );
+  return region;
+}
+
+/**
+ * @details Set the production cuts of the region: the particles listed in 
+ * the configuration take their own cut, the others the one of the default 
+ * region. Since the global cuts are set by the physics list after the 
+ * geometry is built, SLArPhysicsList::SetCuts calls this method again once 
+ * they are final.
+ */
+void SLArUserRegionInformation::ApplyProductionCuts(G4Region* region) const {
+  if (fCuts.empty()) return;
+
+  auto cuts = region->GetProductionCuts();
+  auto default_cuts =
+    G4ProductionCutsTable::GetProductionCutsTable()->GetDefaultProductionCuts();
+  if (cuts == nullptr || cuts == default_cuts) {
+    cuts = new G4ProductionCuts();
+    region->SetProductionCuts( cuts );
+  }
+  for (const auto& particle : {"gamma", "e-", "e+", "proton"}) {
+    const auto cut = fCuts.find(particle);
+    cuts->SetProductionCut(
+        (cut != fCuts.end()) ? cut->second : default_cuts->GetProductionCut(particle), 
+        particle);
+  }
+  return;
+}
+
+void SLArUserRegionInformation::Print() const {
+  printf("Region %s (", fName.data());
+  for (size_t i = 0; i < fVolumes.size(); i++) {
+    printf("%s%s", fVolumes[i].data(), (i+1 < fVolumes.size()) ? ", " : ")\n");
+  }
+  for (const auto& cut : fCuts) {
+    printf("- %s production cut: %g mm\n", cut.first.data(), cut.second / CLHEP::mm);
+  }
+  if (fMaxStep < DBL_MAX) printf("- max step: %g mm\n", fMaxStep / CLHEP::mm);
+  printf("- optical physics: %s\n", fOpticalEnabled ? "enabled" : "disabled");
+  if (fOpticalFastSim) {
+    printf("- fast optical transport: handoff at %g mm from surfaces\n", 
+        fOpticalHandoffDistance / CLHEP::mm);
+  }
+  return;
+}
+
@@ -6,6 +6,7 @@
 
 #include <detector/Anode/SLArDetAnodeAssembly.hh>
 #include <detector/Anode/SLArDetReadoutTileAssembly.hh>
+#include <detector/Anode/SLArDetReadoutTile.hh>
 #include <detector/SLArPlaneParameterisation.hpp>
 #include <detector/SLArGeoUtils.hh>
 
@@ -14,6 +15,11 @@
 #include <G4VisAttributes.hh>
 #include <G4PVParameterised.hh>
 #include <G4Box.hh>
+#include <G4PVPlacement.hh>
+#include <G4LogicalSkinSurface.hh>
+#include <G4OpticalSurface.hh>
+#include <G4MaterialPropertiesTable.hh>
+#include <Randomize.hh>
 #include <G4RotationMatrix.hh>
 
 SLArDetAnodeAssembly::SLArDetAnodeAssembly() : 
@@ -21,7 +27,8 @@ SLArDetAnodeAssembly::SLArDetAnodeAssembly() :
   fTPCID(0), 
   fMatAnode(nullptr), fAnodeRow(nullptr), 
   fPosition(0, 0, 0), fNormal(1, 0, 0),
-  fRotation(0), fTileAssemblyModel("")
+  fRotation(0), fTileAssemblyModel(""), 
+  fFlatSensorPlane(false), fMegaTile(nullptr), fSensorPlane(nullptr)
 {
   fGeoInfo = new SLArGeoInfo();     
 }
@@ -88,6 +95,10 @@ void SLArDetAnodeAssembly::Init(const rapidjson::Value& jconf) {
     fNormal[idim] = v.GetDouble(); 
     idim++; 
   }
+
+  if (janode.HasMember("flat_sensor_plane")) {
+    fFlatSensorPlane = janode["flat_sensor_plane"].GetBool(); 
+  }
   
 }
 
@@ -107,6 +118,7 @@ void SLArDetAnodeAssembly::BuildAnodeAssembly(SLArDetReadoutTileAssembly* megati
   G4int n_x = std::floor(anode_x / mt_x); 
   anode_x = n_x * mt_x; 
 
+  fMegaTile = megatile; 
   fAnodeRow = new SLArBaseDetModule(); 
   fAnodeRow->SetSolidVolume(
         new G4Box("anode_row_sv", 0.5*mt_x, 0.5*mt_y, 0.5*anode_z));
@@ -136,6 +148,173 @@ void SLArDetAnodeAssembly::BuildAnodeAssembly(SLArDetReadoutTileAssembly* megati
 
 }
 
+/**
+ * @details Build the anode as a single sensitive plane spanning the whole 
+ * tile assembly instead of the nested parameterised megatiles, tiles and 
+ * unit cells. The plane has the thickness of the SiPM active volume and 
+ * lies at the height of the SiPMs in the tiles, while the SiPM hit by a 
+ * photon is found from the intercept on the plane using the megatile, 
+ * tile and cell pitch (see FlatSensorLayout_t::Locate). The megatile and 
+ * tile layout (and so the anode configuration) is the same as in the 
+ * nested geometry.
+ *
+ * The plane does not carry the SiPM optical surface, which would make 
+ * the whole anode area photosensitive. In the nested geometry the PCB, 
+ * the charge pixels and the SiPM packages have neither a refractive index 
+ * nor an optical surface, so the photons reaching them are absorbed. The 
+ * plane is given the same behaviour: its surface absorbs every photon 
+ * with Detection status, and the SiPM surface response is applied by 
+ * SLArReadoutTileSD only to the photons hitting the plane inside a SiPM 
+ * active area (see FlatSensorLayout_t::SampleSiPMDetection). The only 
+ * difference with respect to the nested anode is that the photons 
+ * reflected by the SiPM surface are absorbed instead of being tracked 
+ * further, which matters only for a SiPM surface with a non-zero 
+ * REFLECTIVITY (a warning is printed in that case).
+ */
+void SLArDetAnodeAssembly::BuildFlatAnodeAssembly(
+    SLArDetReadoutTileAssembly* megatile, SLArDetReadoutTile* tile) 
+{
+  G4Box* megatileBox = (G4Box*)megatile->GetModSV(); 
+  G4double mt_x = 2*megatileBox->GetXHalfLength(); 
+  G4double mt_y = 2*megatileBox->GetYHalfLength(); 
+  G4double mt_z = 2*megatileBox->GetZHalfLength(); 
+
+  G4double anode_x = fGeoInfo->GetGeoPar("dim_x"); 
+  G4double anode_y = mt_y; 
+  G4double anode_z = fGeoInfo->GetGeoPar("dim_z");
+
+  G4int n_z = std::floor(anode_z / mt_z); 
+  anode_z = n_z * mt_z; 
+  G4int n_x = std::floor(anode_x / mt_x); 
+  anode_x = n_x * mt_x; 
+
+  fMegaTile = megatile; 
+
+  // setup the sensor layout 
+  G4double tile_x = tile->GetGeoPar("tile_x"); 
+  G4double tile_z = tile->GetGeoPar("tile_z"); 
+  G4double cell_x = tile->GetUnitCell()->GetGeoPar("cell_x"); 
+  G4double cell_y = tile->GetUnitCell()->GetGeoPar("cell_y"); 
+  G4double cell_z = tile->GetUnitCell()->GetGeoPar("cell_z"); 
+
+  fFlatLayout.fNMegaTile[0] = n_x; fFlatLayout.fMegaTilePitch[0] = mt_x; 
+  fFlatLayout.fNMegaTile[1] = n_z; fFlatLayout.fMegaTilePitch[1] = mt_z; 
+  fFlatLayout.fNTile[0] = std::floor(megatile->GetGeoPar("rdoutplane_x") / tile_x); 
+  fFlatLayout.fNTile[1] = std::floor(megatile->GetGeoPar("rdoutplane_z") / tile_z); 
+  fFlatLayout.fTilePitch[0] = tile_x; fFlatLayout.fTilePitch[1] = tile_z; 
+  fFlatLayout.fNCell[0] = std::floor(tile_x / cell_x); 
+  fFlatLayout.fNCell[1] = std::floor(tile_z / cell_z); 
+  fFlatLayout.fCellPitch[0] = cell_x; fFlatLayout.fCellPitch[1] = cell_z; 
+
+  auto sipm_active = tile->GetSiPMActive(); 
+  fFlatLayout.fSiPMHalfSize[0] = 0.5*sipm_active->GetGeoPar("active_sipm_x"); 
+  fFlatLayout.fSiPMHalfSize[1] = 0.5*sipm_active->GetGeoPar("active_sipm_z"); 
+  fFlatLayout.fSiPMPos.clear(); 
+  for (const auto& comp : tile->GetUnitCellStructure()) {
+    if (comp.fMod == tile->GetSiPM()) fFlatLayout.fSiPMPos.push_back( comp.fPos ); 
+  }
+
+  // build the anode volume and the sensor plane
+  fModSV = new G4Box("anode_sv", 0.5*anode_x, 0.5*anode_y, 0.5*anode_z); 
+  fModLV = new G4LogicalVolume(fModSV, fMatAnode->GetMaterial(), "anode_lv"); 
+  fModLV->SetVisAttributes( G4VisAttributes(false) ); 
+
+  G4double sipm_y = sipm_active->GetGeoPar("active_sipm_y"); 
+  G4double sensor_y = 0.5*(anode_y - cell_y); 
+  if (sipm_y < cell_y) sensor_y += 0.5*(sipm_y - cell_y); 
+
+  fSensorPlane = new SLArBaseDetModule(); 
+  fSensorPlane->SetMaterial( tile->GetSiPMActiveMaterial()->GetMaterial() ); 
+  fSensorPlane->SetSolidVolume(
+      new G4Box("anode_sensor_plane_sv", 0.5*anode_x, 0.5*sipm_y, 0.5*anode_z) ); 
+  fSensorPlane->SetLogicVolume(
+      new G4LogicalVolume(fSensorPlane->GetModSV(), fSensorPlane->GetMaterial(), 
+        "anode_sensor_plane_lv") ); 
+
+  // black absorber with unit "efficiency": every photon reaching the plane 
+  // is stopped and handed to the SD, which applies the SiPM surface response
+  G4double surf_ene[2] = {1*CLHEP::eV, 13*CLHEP::eV}; 
+  G4double surf_refl[2] = {0.0, 0.0}; 
+  G4double surf_eff[2] = {1.0, 1.0}; 
+  auto plane_mpt = new G4MaterialPropertiesTable(); 
+  plane_mpt->AddProperty("REFLECTIVITY", surf_ene, surf_refl, 2); 
+  plane_mpt->AddProperty("EFFICIENCY", surf_ene, surf_eff, 2); 
+  auto plane_surf = new G4OpticalSurface("AnodeSensorPlane_Surf", 
+      glisur, polished, dielectric_metal); 
+  plane_surf->SetMaterialPropertiesTable(plane_mpt); 
+  new G4LogicalSkinSurface("AnodeSensorPlane_LgSkin", fSensorPlane->GetModLV(), 
+      plane_surf); 
+
+  auto sipm_surf = tile->GetSiPMActiveMaterial()->GetMaterialOpticalSurf(); 
+  fFlatLayout.fSiPMSurfaceProperties = 
+    (sipm_surf) ? sipm_surf->GetMaterialPropertiesTable() : nullptr; 
+  if (fFlatLayout.fSiPMSurfaceProperties) {
+    auto sipm_refl = fFlatLayout.fSiPMSurfaceProperties->GetProperty(kREFLECTIVITY); 
+    if (sipm_refl && sipm_refl->GetMaxValue() > 0.) {
+      printf("SLArDetAnodeAssembly::BuildFlatAnodeAssembly WARNING: "); 
+      printf("photons reflected by the SiPM surface (max REFLECTIVITY %g) are lost on the flat anode\n", 
+          sipm_refl->GetMaxValue()); 
+    }
+  }
+
+  fSensorPlane->GetModPV("AnodeSensorPlanePV", 0, G4ThreeVector(0, sensor_y, 0), 
+      fModLV, false, 0); 
+}
+
+G4bool SLArDetAnodeAssembly::FlatSensorLayout_t::Locate(
+    const G4ThreeVector& plane_pos, SensorIdx_t& idx) const 
+{
+  // find the replica containing u and move u in the replica frame
+  auto locate = [](G4double& u, const G4int n, const G4double pitch, G4int& i) {
+    const G4double s = u / pitch + 0.5*n; 
+    if (s < 0 || s >= n) return false; 
+    i = static_cast<G4int>(s); 
+    u -= (i + 0.5 - 0.5*n) * pitch; 
+    return true; 
+  }; 
+
+  G4double x = plane_pos.x(); 
+  G4double z = plane_pos.z(); 
+  if ( !locate(x, fNMegaTile[0], fMegaTilePitch[0], idx.fRowMegaTile) ||
+       !locate(z, fNMegaTile[1], fMegaTilePitch[1], idx.fMegaTile) ||
+       !locate(x, fNTile[0], fTilePitch[0], idx.fRowTile) || 
+       !locate(z, fNTile[1], fTilePitch[1], idx.fTile) || 
+       !locate(x, fNCell[0], fCellPitch[0], idx.fRowCell) || 
+       !locate(z, fNCell[1], fCellPitch[1], idx.fCell) ) {
+    return false;
+  }
+
+  for (const auto& sipm_pos : fSiPMPos) {
+    const G4double dx = x - sipm_pos.x(); 
+    const G4double dz = z - sipm_pos.z(); 
+    if (std::fabs(dx) < fSiPMHalfSize[0] && std::fabs(dz) < fSiPMHalfSize[1]) {
+      idx.fLocalPos.set(dx, 0., dz); 
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @details Same logic as G4OpBoundaryProcess for a dielectric_metal surface:
+ * the photon is absorbed with probability 1 - REFLECTIVITY and the absorbed 
+ * photon is detected with probability EFFICIENCY. Reflected photons are 
+ * not detected.
+ */
+G4bool SLArDetAnodeAssembly::FlatSensorLayout_t::SampleSiPMDetection(
+    const G4double phEne) const 
+{
+  if (fSiPMSurfaceProperties == nullptr) return false;
+
+  const auto reflectivity = fSiPMSurfaceProperties->GetProperty(kREFLECTIVITY); 
+  const auto efficiency = fSiPMSurfaceProperties->GetProperty(kEFFICIENCY); 
+  if (efficiency == nullptr) return false;
+
+  const G4double p_abs = (reflectivity) ? 1.0 - reflectivity->Value(phEne) : 1.0; 
+  return G4UniformRand() < p_abs * efficiency->Value(phEne); 
+}
+
 SLArCfgAnode SLArDetAnodeAssembly::BuildAnodeConfig() {
   SLArCfgAnode anodeCfg("Anode_"+std::to_string(fID)); 
   anodeCfg.SetIdx( fID ); 
@@ -147,22 +326,13 @@ SLArCfgAnode SLArDetAnodeAssembly::BuildAnodeConfig() {
   anodeCfg.SetPsi( fGeoInfo->GetGeoPar("anode_psi") ); 
 
 
-  auto anode_parameterised = (G4PVParameterised*)fModLV->GetDaughter(0); 
-  auto mtrow_parameterised = (G4PVParameterised*)fAnodeRow->GetModLV()->GetDaughter(0); 
-
-  auto megatile_lv = fAnodeRow->GetModLV()->GetDaughter(0)->GetLogicalVolume(); 
+  auto megatile_lv = fMegaTile->GetModLV(); 
   auto trow_lv = megatile_lv->GetDaughter(0)->GetLogicalVolume(); 
   auto tile_lv = trow_lv->GetDaughter(0)->GetLogicalVolume(); 
   
   auto mt_parameterised  = (G4PVParameterised*)megatile_lv->GetDaughter(0); 
   auto trow_parameterised  = (G4PVParameterised*)trow_lv->GetDaughter(0); 
 
-  if (anode_parameterised->IsParameterised() == false) {
-    printf("SLArDetAnodeAssembly::BuildAnodeConfig() "); 
-    printf("Anode is not a parameterised volume! Quit.\n"); 
-    throw std::runtime_error("SLArDetAnodeAssembly::BuildAnodeConfig() ERROR: Anode is not a parameterized volume.\n"); 
-  }
-
   auto get_replication_data = [](G4PVParameterised* pv) {
     SLArPlaneParameterisation::PlaneReplicationData_t data; 
     pv->GetReplicationData(data.fReplicaAxis, data.fNreplica, 
@@ -174,8 +344,34 @@ SLArCfgAnode SLArDetAnodeAssembly::BuildAnodeConfig() {
     return data;
   };
 
-  auto rpl_mt_row = get_replication_data(anode_parameterised); 
-  auto rpl_mt_clm = get_replication_data(mtrow_parameterised); 
+  SLArPlaneParameterisation::PlaneReplicationData_t rpl_mt_row; 
+  SLArPlaneParameterisation::PlaneReplicationData_t rpl_mt_clm; 
+  if (fFlatSensorPlane) {
+    // megatiles are not placed in the flat geometry: use the sensor layout
+    rpl_mt_row.fReplicaAxis = kXAxis; 
+    rpl_mt_row.fNreplica = fFlatLayout.fNMegaTile[0]; 
+    rpl_mt_row.fWidth = fFlatLayout.fMegaTilePitch[0]; 
+    rpl_mt_row.fReplicaAxisVec.set(1, 0, 0); 
+    rpl_mt_row.fStartingPos.set(-0.5*rpl_mt_row.fWidth*(rpl_mt_row.fNreplica-1), 0, 0); 
+    rpl_mt_clm.fReplicaAxis = kZAxis; 
+    rpl_mt_clm.fNreplica = fFlatLayout.fNMegaTile[1]; 
+    rpl_mt_clm.fWidth = fFlatLayout.fMegaTilePitch[1]; 
+    rpl_mt_clm.fReplicaAxisVec.set(0, 0, 1); 
+    rpl_mt_clm.fStartingPos.set(0, 0, -0.5*rpl_mt_clm.fWidth*(rpl_mt_clm.fNreplica-1)); 
+  }
+  else {
+    auto anode_parameterised = (G4PVParameterised*)fModLV->GetDaughter(0); 
+    auto mtrow_parameterised = (G4PVParameterised*)fAnodeRow->GetModLV()->GetDaughter(0); 
+
+    if (anode_parameterised->IsParameterised() == false) {
+      printf("SLArDetAnodeAssembly::BuildAnodeConfig() "); 
+      printf("Anode is not a parameterised volume! Quit.\n"); 
+      throw std::runtime_error("SLArDetAnodeAssembly::BuildAnodeConfig() ERROR: Anode is not a parameterized volume.\n"); 
+    }
+
+    rpl_mt_row = get_replication_data(anode_parameterised); 
+    rpl_mt_clm = get_replication_data(mtrow_parameterised); 
+  }
   auto rpl_t_row  = get_replication_data(mt_parameterised); 
   auto rpl_t_clm  = get_replication_data(trow_parameterised); 
 
@@ -82,20 +82,8 @@ G4bool SLArReadoutTileSD::ProcessHits_constStep(const G4Step* step,
 #endif
 
 
-  G4double phEne = 0*CLHEP::eV;
-  //G4StepPoint* preStepPoint  = step->GetPreStepPoint();
   G4StepPoint* postStepPoint = step->GetPostStepPoint();
   
-  G4TouchableHistory* touchable
-    = (G4TouchableHistory*)(step->GetPostStepPoint()->GetTouchable());
-
-  G4ThreeVector worldPos 
-    = postStepPoint->GetPosition();
-  G4ThreeVector localPos
-    = touchable->GetHistory()
-      ->GetTopTransform().TransformPoint(worldPos);
- 
-  SLArReadoutTileHit* hit = nullptr;
   // Get the creation process of optical photon
   G4String procName = "";
   
@@ -104,25 +92,69 @@ G4bool SLArReadoutTileSD::ProcessHits_constStep(const G4Step* step,
     auto creator = track->GetCreatorProcess(); 
     if (creator) procName = creator->GetProcessName();
   }
-  phEne = track->GetTotalEnergy();
 
-  hit = new SLArReadoutTileHit(); //so create new hit
+  // flat anode: the plane surface stops all photons, apply here the SiPM 
+  // surface response (the SiPM area is checked by ProcessPhotonHit)
+  const G4VTouchable* touchable = postStepPoint->GetTouchable(); 
+  if (touchable->GetVolume()->GetName() == "AnodeSensorPlanePV") {
+    auto flat_anode = fFlatAnodes.find( touchable->GetCopyNumber(1) ); 
+    if (flat_anode == fFlatAnodes.end()) return false;
+    if (flat_anode->second.SampleSiPMDetection(track->GetTotalEnergy()) == false) {
+      return false;
+    }
+  }
+
+  return ProcessPhotonHit(postStepPoint->GetTouchable(), 
+      postStepPoint->GetPosition(), postStepPoint->GetGlobalTime(), 
+      track->GetTotalEnergy(), procName, track->GetParentID()); 
+}
+
+G4bool SLArReadoutTileSD::ProcessPhotonHit(const G4VTouchable* touchable, 
+    const G4ThreeVector& worldPos, const G4double time, 
+    const G4double phEne, const G4String& procName, const G4int producerID)
+{
+  G4ThreeVector localPos
+    = touchable->GetHistory()
+      ->GetTopTransform().TransformPoint(worldPos);
+
+  // flat anode: find the SiPM from the photon intercept on the sensor plane
+  G4bool is_flat_anode = (touchable->GetVolume()->GetName() == "AnodeSensorPlanePV"); 
+  SLArDetAnodeAssembly::FlatSensorLayout_t::SensorIdx_t sensor; 
+  if (is_flat_anode) {
+    auto flat_anode = fFlatAnodes.find( touchable->GetCopyNumber(1) ); 
+    if (flat_anode == fFlatAnodes.end()) return false;
+    if (flat_anode->second.Locate(localPos, sensor) == false) return false;
+    localPos = sensor.fLocalPos; 
+  }
+ 
+  SLArReadoutTileHit* hit = new SLArReadoutTileHit(); //so create new hit
   hit->SetPhotonWavelength( CLHEP::h_Planck * CLHEP::c_light / phEne * 1e6);
   hit->SetWorldPos(worldPos);
   hit->SetLocalPos(localPos);
-  hit->SetTime(postStepPoint->GetGlobalTime());
-  hit->SetAnodeIdx(touchable->GetCopyNumber(9));
-  hit->SetRowMegaTileIdx(touchable->GetCopyNumber(8)); 
-  hit->SetMegaTileIdx(touchable->GetCopyNumber(7));
-  hit->SetRowTileIdx(touchable->GetCopyNumber(6));
-  hit->SetTileIdx(touchable->GetCopyNumber(5));
-  hit->SetRowCellNr(touchable->GetCopyNumber(4)); 
-  hit->SetCellNr(touchable->GetCopyNumber(3)); 
+  hit->SetTime(time);
+  if (is_flat_anode) {
+    hit->SetAnodeIdx(touchable->GetCopyNumber(1));
+    hit->SetRowMegaTileIdx(sensor.fRowMegaTile); 
+    hit->SetMegaTileIdx(sensor.fMegaTile);
+    hit->SetRowTileIdx(sensor.fRowTile);
+    hit->SetTileIdx(sensor.fTile);
+    hit->SetRowCellNr(sensor.fRowCell); 
+    hit->SetCellNr(sensor.fCell); 
+  }
+  else {
+    hit->SetAnodeIdx(touchable->GetCopyNumber(9));
+    hit->SetRowMegaTileIdx(touchable->GetCopyNumber(8)); 
+    hit->SetMegaTileIdx(touchable->GetCopyNumber(7));
+    hit->SetRowTileIdx(touchable->GetCopyNumber(6));
+    hit->SetTileIdx(touchable->GetCopyNumber(5));
+    hit->SetRowCellNr(touchable->GetCopyNumber(4)); 
+    hit->SetCellNr(touchable->GetCopyNumber(3)); 
+  }
   hit->SetPhotonProcess(procName);
-  hit->SetProducerID( track->GetParentID() ); 
+  hit->SetProducerID( producerID ); 
 
 #ifdef SLAR_DEBUG
-  printf("SLArReadoutTileSD::ProcessHits_constStep\n");
+  printf("SLArReadoutTileSD::ProcessPhotonHit\n");
   printf("%s photon hit at t = %g ns\n", procName.c_str(), hit->GetTime());
   //if (hit->GetTime() < 1*CLHEP::ns) getchar(); 
 #endif
@@ -131,4 +163,10 @@ G4bool SLArReadoutTileSD::ProcessHits_constStep(const G4Step* step,
   return true;
 }
 
+void SLArReadoutTileSD::RegisterFlatAnode(const G4int anode_id, 
+    const SLArDetAnodeAssembly::FlatSensorLayout_t& layout) 
+{
+  fFlatAnodes[anode_id] = layout; 
+}
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -17,7 +17,8 @@ G4ThreadLocal G4Allocator<SLArExtHit>* SLArExtHitAllocator;
 SLArExtHit::SLArExtHit() : G4VHit(),
   fEvNumber(0), fPDGCode(0), fTrkID(-1), fParentID(-1), fOriginVol(-1),
   fOriginEnergy(0.0), fEnergy(0.0), fTime(0.0), fWeight(1.0), fVertex{0.0}, fOriginVertex{0.0},
-  fCreator("")
+  fCreator(""), fScorerID(-1), fEntryEnergy(0.0), fEntryTime(0.0), fEntryWeight(1.0), 
+  fEntryVertex{0.0}, fEntryDir{0.0}
 {}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -31,11 +32,16 @@ SLArExtHit::SLArExtHit(const SLArExtHit &right) : G4VHit(),
   fEvNumber(right.fEvNumber), fPDGCode(right.fPDGCode), fTrkID(right.fTrkID), 
   fParentID(right.fParentID), fOriginVol(right.fOriginVol), 
   fOriginEnergy(right.fOriginEnergy), fEnergy(right.fEnergy), fTime(right.fTime), 
-  fWeight(right.fWeight), fVertex{0}, fOriginVertex{0.0}, fCreator(right.fCreator) 
+  fWeight(right.fWeight), fVertex{0}, fOriginVertex{0.0}, fCreator(right.fCreator), 
+  fScorerID(right.fScorerID), fEntryEnergy(right.fEntryEnergy), 
+  fEntryTime(right.fEntryTime), fEntryWeight(right.fEntryWeight), 
+  fEntryVertex{0.0}, fEntryDir{0.0}
 {
   for (size_t i = 0; i < 3; i++) {
     fVertex[i] = right.fVertex[i];
     fOriginVertex[i] = right.fOriginVertex[i];
+    fEntryVertex[i] = right.fEntryVertex[i];
+    fEntryDir[i] = right.fEntryDir[i];
   }
 }
 
@@ -53,9 +59,15 @@ const SLArExtHit& SLArExtHit::operator=(const SLArExtHit &right)
   fTime = right.fTime;
   fWeight = right.fWeight;
   fCreator = right.fCreator;
+  fScorerID = right.fScorerID;
+  fEntryEnergy = right.fEntryEnergy;
+  fEntryTime = right.fEntryTime;
+  fEntryWeight = right.fEntryWeight;
   for (size_t i = 0; i < 3; i++) {
     fVertex[i] = right.fVertex[i];
     fOriginVertex[i] = right.fOriginVertex[i];
+    fEntryVertex[i] = right.fEntryVertex[i];
+    fEntryDir[i] = right.fEntryDir[i];
   }
 
   return *this;
@@ -76,9 +88,15 @@ G4bool SLArExtHit::operator==(const SLArExtHit &right) const
   is_equal *= (fTime == right.fTime);
   is_equal *= (fWeight == right.fWeight);
   is_equal *= (fCreator == right.fCreator);
+  is_equal *= (fScorerID == right.fScorerID);
+  is_equal *= (fEntryEnergy == right.fEntryEnergy);
+  is_equal *= (fEntryTime == right.fEntryTime);
+  is_equal *= (fEntryWeight == right.fEntryWeight);
   for (size_t i = 0; i < 3; i++) {
     is_equal *= (fVertex[i] == right.fVertex[i]);
     is_equal *= (fOriginVertex[i] == right.fOriginVertex[i]);
+    is_equal *= (fEntryVertex[i] == right.fEntryVertex[i]);
+    is_equal *= (fEntryDir[i] == right.fEntryDir[i]);
   }
 
   return is_equal;
@@ -95,6 +113,9 @@ void SLArExtHit::Print() const
       fOriginVertex[0], fOriginVertex[1], fOriginVertex[2], 
       fOriginVol, fCreator.data(), fOriginEnergy); 
   printf("time: %g, weight: %g\n", fTime, fWeight); 
+  printf("scorer %i entry: [%g, %g, %g] - dir [%g, %g, %g] - energy: %g - time: %g - weight: %g\n", 
+      fScorerID, fEntryVertex[0], fEntryVertex[1], fEntryVertex[2], 
+      fEntryDir[0], fEntryDir[1], fEntryDir[2], fEntryEnergy, fEntryTime, fEntryWeight); 
 
   return;
 }
@@ -111,9 +132,15 @@ void SLArExtHit::reset() {
   fEnergy = 0;
   fTime = 0;
   fWeight = 0;
+  fScorerID = -1;
+  fEntryEnergy = 0;
+  fEntryTime = 0;
+  fEntryWeight = 0;
   for (size_t i = 0; i < 3; i++) {
     fVertex[i] = 0.0;
     fOriginVertex[i] = 0.0;
+    fEntryVertex[i] = 0.0;
+    fEntryDir[i] = 0.0;
   }
   fCreator = "";
   
@@ -14,8 +14,9 @@
 #include <cstdio>
 #include "detector/TPC/SLArExtScorerSD.hh"
 
-SLArExtScorerSD::SLArExtScorerSD(G4String name) 
-  : G4VSensitiveDetector(name), fHitsCollection(nullptr), fHCID(-10)
+SLArExtScorerSD::SLArExtScorerSD(G4String name, const G4int scorer_id) 
+  : G4VSensitiveDetector(name), fHitsCollection(nullptr), fHCID(-10), 
+    fScorerID(scorer_id)
 {
   collectionName.insert(SensitiveDetectorName+"Coll");
 }
@@ -80,6 +81,18 @@ G4bool SLArExtScorerSD::ProcessHits(G4Step* step, G4TouchableHistory* ) {
   scorer_hit->fVertex[1] = thePostPoint->GetPosition().y();
   scorer_hit->fVertex[2] = thePostPoint->GetPosition().z();
 
+  // phase-space point where the particle enters the scorer
+  scorer_hit->fScorerID = fScorerID; 
+  scorer_hit->fEntryEnergy = thePrePoint->GetKineticEnergy(); 
+  scorer_hit->fEntryTime = thePrePoint->GetGlobalTime(); 
+  scorer_hit->fEntryWeight = thePrePoint->GetWeight(); 
+  const auto& entry_pos = thePrePoint->GetPosition(); 
+  const auto& entry_dir = thePrePoint->GetMomentumDirection(); 
+  for (size_t i = 0; i < 3; i++) {
+    scorer_hit->fEntryVertex[i] = entry_pos[i]; 
+    scorer_hit->fEntryDir[i] = entry_dir[i]; 
+  }
+
   fHitsCollection->insert( scorer_hit ); 
 
   if (verboseLevel > 1) {
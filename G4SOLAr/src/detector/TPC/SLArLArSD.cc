@@ -137,14 +137,8 @@ G4bool SLArLArSD::ProcessHits(G4Step* step, G4TouchableHistory*)
         G4RunManager::GetRunManager()->GetUserEventAction(); 
       auto ancestor_id = eventAction->FindAncestorID(step->GetTrack()->GetTrackID()); 
       // Add edep in LAr to the primary 
-      SLArMCPrimaryInfo* ancestor = nullptr;
-      auto& primaries = anaMngr->GetEvent().GetPrimaries();
-      for (auto &p : primaries) {
-        if (p.GetTrackID() == ancestor_id) {
-          ancestor = &p;
-          break;
-        }
-      }
+      SLArMCPrimaryInfo* ancestor = 
+        anaMngr->GetEvent().FindPrimaryByTrkID( ancestor_id ); 
 
       if (ancestor) ancestor->IncrementLArEdep(edep); 
 
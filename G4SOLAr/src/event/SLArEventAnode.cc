@@ -5,7 +5,9 @@
  */
 
 #include <memory>
+#include <stdexcept>
 #include "event/SLArEventAnode.hh"
+#include "event/SLArPixelFrontEnd.hh"
 #include "config/SLArCfgMegaTile.hh"
 
 ClassImp(SLArEventAnode)
@@ -13,7 +15,7 @@ ClassImp(SLArEventAnode)
 SLArEventAnode::SLArEventAnode() : TNamed(),
     fID(0), fNhits(0), fIsActive(true), 
     fLightBacktrackerRecordSize(0), fChargeBacktrackerRecordSize(0), 
-    fZeroSuppressionThreshold(0)
+    fZeroSuppressionThreshold(0), fOnlineZeroSuppression(false)
 {}
 
 SLArEventAnode::SLArEventAnode(const SLArEventAnode& right) 
@@ -25,6 +27,8 @@ SLArEventAnode::SLArEventAnode(const SLArEventAnode& right)
   fLightBacktrackerRecordSize = right.fLightBacktrackerRecordSize;
   fChargeBacktrackerRecordSize = right.fChargeBacktrackerRecordSize;
   fZeroSuppressionThreshold = right.fZeroSuppressionThreshold;
+  fOnlineZeroSuppression = right.fOnlineZeroSuppression; 
+  fChargeStaging = right.fChargeStaging; 
   for (const auto &mgev : right.fMegaTilesMap) {
     fMegaTilesMap[mgev.first] = SLArEventMegatile(mgev.second);
   }
@@ -118,6 +122,7 @@ int SLArEventAnode::ResetHits() {
   }
 
   fMegaTilesMap.clear();
+  fChargeStaging.clear();
   return nn; 
 }
 
@@ -139,7 +144,8 @@ Int_t SLArEventAnode::ApplyZeroSuppression() {
       for (auto it_pix = pix_map.begin(); it_pix!=pix_map.end(); ) {
         auto pix_key = it_pix->first;
         erasedHits += it_pix->second.ZeroSuppression( fZeroSuppressionThreshold ); 
-        if (it_pix->second.GetHits().empty()) {
+        // pixels keeping front-end packets survive even without raw ticks
+        if (it_pix->second.GetHits().empty() && it_pix->second.GetPackets().empty()) {
           it_pix = pix_map.erase(it_pix);
         } 
         else {
@@ -152,6 +158,131 @@ Int_t SLArEventAnode::ApplyZeroSuppression() {
   return erasedHits;
 }
 
+ULong64_t SLArEventAnode::PackStagingKey(const SLArCfgAnode::SLArPixIdx& pixID, const UShort_t tick) {
+  for (const auto& idx : pixID) {
+    if (idx < 0 || idx > 0xFFFF) {
+      throw std::out_of_range(
+          Form("SLArEventAnode::PackStagingKey: pixel index [%i, %i, %i] out of range", 
+            pixID[0], pixID[1], pixID[2]));
+    }
+  }
+
+  return (static_cast<ULong64_t>(pixID[0]) << 48) | 
+         (static_cast<ULong64_t>(pixID[1]) << 32) | 
+         (static_cast<ULong64_t>(pixID[2]) << 16) | 
+          static_cast<ULong64_t>(tick); 
+}
+
+void SLArEventAnode::UnpackStagingKey(const ULong64_t key, SLArCfgAnode::SLArPixIdx& pixID, UShort_t& tick) {
+  pixID[0] = static_cast<int>((key >> 48) & 0xFFFF); 
+  pixID[1] = static_cast<int>((key >> 32) & 0xFFFF); 
+  pixID[2] = static_cast<int>((key >> 16) & 0xFFFF); 
+  tick     = static_cast<UShort_t>(key & 0xFFFF); 
+  return;
+}
+
+/**
+ * @details Accumulate a charge hit in the online zero-suppression buffer. 
+ * Only the hit count per pixel tick is stored, together with a compact list 
+ * of contributing tracks when charge backtracking is enabled. Consecutive 
+ * electrons from the same track (the typical case, since they come from 
+ * the same energy deposition) are merged into a single contributor entry. 
+ */
+void SLArEventAnode::StageChargeHit(const SLArCfgAnode::SLArPixIdx& pixID, const SLArEventChargeHit& hit) {
+  const UShort_t tick = 
+    static_cast<UShort_t>(hit.GetTime() / SLArEventChargePixel::kDefaultClockUnit); 
+  auto& staged = fChargeStaging[ PackStagingKey(pixID, tick) ]; 
+  staged.fNhits++; 
+
+  if (fChargeBacktrackerRecordSize == 0) return;
+
+  auto& contributors = staged.fContributors; 
+  if (!contributors.empty() && 
+      contributors.back().fTrkID == hit.GetProducerTrkID() && 
+      contributors.back().fPrimaryTrkID == hit.GetPrimaryProducerTrkID()) {
+    contributors.back().fN++; 
+  }
+  else {
+    contributors.push_back( {hit.GetProducerTrkID(), hit.GetPrimaryProducerTrkID(), 1} ); 
+  }
+  return;
+}
+
+/**
+ * @details Move the staged pixel ticks passing the zero-suppression 
+ * threshold into the persistent hit collections and clear the buffer. 
+ * Backtracker records are created only for the surviving ticks by calling 
+ * `bkt_eval` once per staged contributor. 
+ *
+ * @return number of charge hits discarded by the zero suppression
+ */
+Int_t SLArEventAnode::FlushStagedChargeHits(ChargeBacktrackerEval_t bkt_eval) {
+  Int_t erasedHits = 0; 
+  SLArCfgAnode::SLArPixIdx pixID; 
+  UShort_t tick = 0; 
+
+  for (const auto& staged_itr : fChargeStaging) {
+    const auto& staged = staged_itr.second;
+    if (staged.fNhits < fZeroSuppressionThreshold) {
+      erasedHits += staged.fNhits; 
+      continue;
+    }
+
+    UnpackStagingKey(staged_itr.first, pixID, tick); 
+    auto& mt_event = GetOrCreateEventMegatile(pixID[0]); 
+    auto& t_event = mt_event.GetOrCreateEventTile(pixID[1]);
+    auto& p_event = t_event.GetOrCreateChargePixel(pixID[2]); 
+    p_event.RegisterHits(tick, staged.fNhits); 
+
+    if (!bkt_eval || fChargeBacktrackerRecordSize == 0) continue;
+
+    auto& records = p_event.GetBacktrackerVector(tick); 
+    const float hit_time = tick * p_event.GetClockUnit(); 
+    for (const auto& contributor : staged.fContributors) {
+      SLArEventChargeHit hit(hit_time, contributor.fTrkID, contributor.fPrimaryTrkID); 
+      bkt_eval(hit, contributor.fN, records); 
+    }
+  }
+
+  fChargeStaging.clear(); 
+  return erasedHits;
+}
+
+/**
+ * @details Rebuild the raw tick stream of each pixel from the online 
+ * zero-suppression buffer and run the front-end emulator on it, so that 
+ * the packets are computed before the ticks below threshold are dropped by 
+ * SLArEventAnode::FlushStagedChargeHits. Only the pixels producing at least 
+ * one packet are created in the event. 
+ */
+Int_t SLArEventAnode::ProcessStagedChargeHits(SLArPixelFrontEnd& frontend) {
+  // group the staged ticks by pixel (the tick is the lowest 16 bits of the key)
+  std::map<ULong64_t, HitsCollection_t> pixel_ticks; 
+  for (const auto& staged_itr : fChargeStaging) {
+    const ULong64_t pix_key = staged_itr.first & ~static_cast<ULong64_t>(0xFFFF);
+    const UShort_t tick = static_cast<UShort_t>(staged_itr.first & 0xFFFF); 
+    pixel_ticks[pix_key][tick] = staged_itr.second.fNhits;
+  }
+
+  Int_t n_packets = 0; 
+  SLArCfgAnode::SLArPixIdx pixID; 
+  UShort_t tick = 0; 
+  std::vector<SLArPixelPacket_t> packets; 
+  for (const auto& pix_itr : pixel_ticks) {
+    packets.clear(); 
+    if (frontend.Process(pix_itr.second, packets) == 0) continue;
+
+    UnpackStagingKey(pix_itr.first, pixID, tick); 
+    auto& mt_event = GetOrCreateEventMegatile(pixID[0]); 
+    auto& t_event = mt_event.GetOrCreateEventTile(pixID[1]);
+    auto& p_event = t_event.GetOrCreateChargePixel(pixID[2]); 
+    p_event.GetPackets() = packets; 
+    n_packets += packets.size(); 
+  }
+
+  return n_packets;
+}
+
 //bool SLArEventAnode::SortHits() {
   //int isort = true;
   //for (auto &mgtile : fMegaTilesMap) {
@@ -5,31 +5,204 @@
  */
 
 #include "event/SLArEventBacktrackerRecord.hh"
+#include "TBuffer.h"
 #include <cstdio>
+#include <utility>
 
-ClassImp(SLArEventBacktrackerRecord) 
+namespace {
+  //! Free list of overflow buffers, recycled across records and events
+  constexpr size_t kMaxPooledBuffers = 4096;
+  thread_local bool gPoolAlive = false;
 
-SLArEventBacktrackerRecord::SLArEventBacktrackerRecord() : TObject() {}
+  struct BacktrackerPool_t {
+    std::vector<std::unique_ptr<BacktrackerOverflow_t>> fFree;
+    BacktrackerPool_t() {gPoolAlive = true;}
+    ~BacktrackerPool_t() {gPoolAlive = false;}
+  };
+
+  BacktrackerPool_t& GetPool() {
+    static thread_local BacktrackerPool_t pool;
+    return pool;
+  }
+
+  std::unique_ptr<BacktrackerOverflow_t> AcquireOverflow() {
+    auto& pool = GetPool();
+    if (pool.fFree.empty()) {
+      return std::unique_ptr<BacktrackerOverflow_t>(new BacktrackerOverflow_t());
+    }
+    auto buffer = std::move(pool.fFree.back());
+    pool.fFree.pop_back();
+    return buffer;
+  }
+
+  void ReleaseOverflow(std::unique_ptr<BacktrackerOverflow_t>& buffer) {
+    if (!buffer) return;
+    // the pool may already be gone when records are destroyed at exit
+    if (gPoolAlive && GetPool().fFree.size() < kMaxPooledBuffers) {
+      buffer->clear();
+      GetPool().fFree.push_back(std::move(buffer));
+    }
+    buffer.reset();
+  }
+}
+
+ClassImp(SLArEventBacktrackerRecord)
+
+SLArEventBacktrackerRecord::SLArEventBacktrackerRecord()
+  : fSize(0), fKey{0}, fCount{0}, fOverflow(nullptr)
+{}
+
+SLArEventBacktrackerRecord::SLArEventBacktrackerRecord(const SLArEventBacktrackerRecord& right)
+  : fSize(right.fSize), fOverflow(nullptr)
+{
+  for (UShort_t i = 0; i < kInlineSize; i++) {
+    fKey[i] = right.fKey[i];
+    fCount[i] = right.fCount[i];
+  }
+  if (right.fOverflow) {
+    fOverflow = AcquireOverflow();
+    *fOverflow = *right.fOverflow;
+  }
+}
+
+SLArEventBacktrackerRecord::SLArEventBacktrackerRecord(SLArEventBacktrackerRecord&& right) noexcept
+  : fSize(right.fSize), fOverflow(std::move(right.fOverflow))
+{
+  for (UShort_t i = 0; i < kInlineSize; i++) {
+    fKey[i] = right.fKey[i];
+    fCount[i] = right.fCount[i];
+  }
+  right.fSize = 0;
+}
+
+SLArEventBacktrackerRecord& SLArEventBacktrackerRecord::operator=(const SLArEventBacktrackerRecord& right)
+{
+  if (this == &right) return *this;
+
+  Reset();
+  fSize = right.fSize;
+  for (UShort_t i = 0; i < kInlineSize; i++) {
+    fKey[i] = right.fKey[i];
+    fCount[i] = right.fCount[i];
+  }
+  if (right.fOverflow) {
+    fOverflow = AcquireOverflow();
+    *fOverflow = *right.fOverflow;
+  }
+  return *this;
+}
+
+SLArEventBacktrackerRecord& SLArEventBacktrackerRecord::operator=(SLArEventBacktrackerRecord&& right) noexcept
+{
+  if (this == &right) return *this;
+
+  Reset();
+  fSize = right.fSize;
+  for (UShort_t i = 0; i < kInlineSize; i++) {
+    fKey[i] = right.fKey[i];
+    fCount[i] = right.fCount[i];
+  }
+  fOverflow = std::move(right.fOverflow);
+  right.fSize = 0;
+  return *this;
+}
+
+SLArEventBacktrackerRecord::~SLArEventBacktrackerRecord()
+{
+  ReleaseOverflow(fOverflow);
+}
 
 void SLArEventBacktrackerRecord::Reset() {
-  fCounter.clear(); 
+  fSize = 0;
+  ReleaseOverflow(fOverflow);
+}
+
+Int_t SLArEventBacktrackerRecord::GetKey(const UShort_t i) const {
+  return (i < kInlineSize) ? fKey[i] : fOverflow->at(i-kInlineSize).fKey;
+}
+
+UShort_t SLArEventBacktrackerRecord::GetCount(const UShort_t i) const {
+  return (i < kInlineSize) ? fCount[i] : fOverflow->at(i-kInlineSize).fCount;
+}
+
+BacktrackerCounter_t SLArEventBacktrackerRecord::GetConstCounter() const {
+  BacktrackerCounter_t counter;
+  for (UShort_t i = 0; i < fSize; i++) {
+    counter[GetKey(i)] += GetCount(i);
+  }
+  return counter;
 }
 
 UShort_t SLArEventBacktrackerRecord::UpdateCounter(const int key, const UShort_t val)
 {
-  fCounter[key] += val;
-  return fCounter[key];
+  const UShort_t n_inline = (fSize < kInlineSize) ? fSize : kInlineSize;
+  for (UShort_t i = 0; i < n_inline; i++) {
+    if (fKey[i] == key) {
+      fCount[i] += val;
+      return fCount[i];
+    }
+  }
+
+  if (fOverflow) {
+    for (auto& contributor : *fOverflow) {
+      if (contributor.fKey == key) {
+        contributor.fCount += val;
+        return contributor.fCount;
+      }
+    }
+  }
+
+  if (fSize < kInlineSize) {
+    fKey[fSize] = key;
+    fCount[fSize] = val;
+  }
+  else {
+    if (!fOverflow) fOverflow = AcquireOverflow();
+    fOverflow->push_back( {key, val} );
+  }
+  fSize++;
+
+  return val;
+}
+
+void SLArEventBacktrackerRecord::Streamer(TBuffer& R__b)
+{
+  if (R__b.IsReading()) {
+    UInt_t R__s, R__c;
+    Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
+    Reset();
+    if (R__v < 2) {
+      // map-based records, converted by the schema evolution rule
+      R__b.ReadClassBuffer(SLArEventBacktrackerRecord::Class(), this, R__v, R__s, R__c);
+      return;
+    }
+    UShort_t n = 0;
+    R__b >> n;
+    std::vector<Int_t> keys(n);
+    for (auto& key : keys) R__b >> key;
+    for (const auto& key : keys) {
+      UShort_t count = 0;
+      R__b >> count;
+      UpdateCounter(key, count);
+    }
+    R__b.CheckByteCount(R__s, R__c, SLArEventBacktrackerRecord::Class());
+  }
+  else {
+    UInt_t R__c = R__b.WriteVersion(SLArEventBacktrackerRecord::Class(), kTRUE);
+    R__b << fSize;
+    for (UShort_t i = 0; i < fSize; i++) R__b << GetKey(i);
+    for (UShort_t i = 0; i < fSize; i++) R__b << GetCount(i);
+    R__b.SetByteCount(R__c, kTRUE);
+  }
 }
 
 
 ClassImp(SLArEventBacktrackerVector)
 
 SLArEventBacktrackerVector::SLArEventBacktrackerVector()
-  : TObject()
 {}
 
 SLArEventBacktrackerVector::SLArEventBacktrackerVector(const UShort_t size)
-  : TObject()
 {
   InitRecords(size);
 }
@@ -49,8 +222,64 @@ void SLArEventBacktrackerVector::Reset() {
   return;
 }
 
+/**
+ * @details Columnar layout: number of records, the size of each record,
+ * then the keys of all the records followed by all their counts. Keys and
+ * counts are thus grouped together, which compresses much better than the
+ * per-record std::map streaming of version 1.
+ */
+void SLArEventBacktrackerVector::Streamer(TBuffer& R__b)
+{
+  if (R__b.IsReading()) {
+    UInt_t R__s, R__c;
+    Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
+    Reset();
+    if (R__v < 2) {
+      R__b.ReadClassBuffer(SLArEventBacktrackerVector::Class(), this, R__v, R__s, R__c);
+      return;
+    }
+
+    UShort_t n_records = 0;
+    R__b >> n_records;
+    fRecords.clear();
+    fRecords.resize(n_records);
+
+    std::vector<UShort_t> sizes(n_records, 0);
+    size_t n_entries = 0;
+    for (auto& size : sizes) {
+      R__b >> size;
+      n_entries += size;
+    }
+
+    std::vector<Int_t> keys(n_entries);
+    for (auto& key : keys) R__b >> key;
+
+    size_t ientry = 0;
+    for (UShort_t ir = 0; ir < n_records; ir++) {
+      for (UShort_t i = 0; i < sizes[ir]; i++, ientry++) {
+        UShort_t count = 0;
+        R__b >> count;
+        fRecords[ir].UpdateCounter(keys[ientry], count);
+      }
+    }
+    R__b.CheckByteCount(R__s, R__c, SLArEventBacktrackerVector::Class());
+  }
+  else {
+    UInt_t R__c = R__b.WriteVersion(SLArEventBacktrackerVector::Class(), kTRUE);
+    const UShort_t n_records = fRecords.size();
+    R__b << n_records;
+    for (const auto& record : fRecords) R__b << record.GetSize();
+    for (const auto& record : fRecords) {
+      for (UShort_t i = 0; i < record.GetSize(); i++) R__b << record.GetKey(i);
+    }
+    for (const auto& record : fRecords) {
+      for (UShort_t i = 0; i < record.GetSize(); i++) R__b << record.GetCount(i);
+    }
+    R__b.SetByteCount(R__c, kTRUE);
+  }
+}
+
 SLArEventBacktrackerVector::~SLArEventBacktrackerVector()
 {
   fRecords.clear();
 }
-
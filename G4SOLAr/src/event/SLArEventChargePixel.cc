@@ -11,17 +11,22 @@ ClassImp(SLArEventChargePixel)
 SLArEventChargePixel::SLArEventChargePixel() 
   : SLArEventHitsCollection<SLArEventChargeHit>()
 {
-  fClockUnit = 50;
+  fClockUnit = kDefaultClockUnit;
 }
 
 SLArEventChargePixel::SLArEventChargePixel(const int& idx, const SLArEventChargeHit& hit)
   : SLArEventHitsCollection<SLArEventChargeHit>(idx) 
 {
   fName = Form("EvPix%i", fIdx); 
-  fClockUnit = 50; 
+  fClockUnit = kDefaultClockUnit; 
   RegisterHit(hit); 
 }
 
 SLArEventChargePixel::SLArEventChargePixel(const SLArEventChargePixel& right) 
-  : SLArEventHitsCollection<SLArEventChargeHit>(right) 
+  : SLArEventHitsCollection<SLArEventChargeHit>(right), fPackets(right.fPackets)
 {}
+
+int SLArEventChargePixel::ResetHits() {
+  fPackets.clear(); 
+  return SLArEventHitsCollection<SLArEventChargeHit>::ResetHits(); 
+}
@@ -73,6 +73,13 @@ int SLArEventHitsCollection<T>::RegisterHit(const T hit) {
   return fNhits;
 }
 
+template<class T>
+int SLArEventHitsCollection<T>::RegisterHits(const UShort_t clock_tick, const UShort_t n) {
+  fHits[clock_tick] += n; 
+  fNhits += n; 
+  return fNhits;
+}
+
 //template<class T>
 //bool SLArEventHitsCollection<T>::SortHits() {
   //std::sort(fHits.begin(), fHits.end(), T::CompareHitPtrs); 
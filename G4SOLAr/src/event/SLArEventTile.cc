@@ -127,6 +127,20 @@ SLArEventChargePixel& SLArEventTile::RegisterChargeHit(const int& pixID, const S
 
 }
 
+SLArEventChargePixel& SLArEventTile::GetOrCreateChargePixel(const int& pixID) {
+  auto it = fPixelHits.find(pixID);
+
+  if (it != fPixelHits.end()) {
+    return it->second;
+  }
+  
+  auto& pixEv = fPixelHits[pixID];
+  pixEv.SetIdx( pixID ); 
+  pixEv.SetName( Form("EvPix%i", pixID) ); 
+  pixEv.SetBacktrackerRecordSize( fChargeBacktrackerRecordSize ); 
+  return pixEv;
+}
+
 double SLArEventTile::GetPixelHits() const {
   double nhits = 0.;
   for (const auto &pixel : fPixelHits) {
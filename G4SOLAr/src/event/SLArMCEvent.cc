@@ -25,6 +25,7 @@ SLArMCEvent::SLArMCEvent(const SLArMCEvent& ev) : TObject(ev)
   for (const auto& p : ev.fSLArPrimary) {
     fSLArPrimary.push_back( SLArMCPrimaryInfo(p) );
   }
+  fPrimaryIdxByTrkID = ev.fPrimaryIdxByTrkID; 
 
   for (const auto& itr : ev.fEvAnode) {
     fEvAnode[itr.first] = SLArEventAnode(itr.second);
@@ -112,6 +113,7 @@ void SLArMCEvent::Reset()
     //delete p;
   //}
   fSLArPrimary.clear(); 
+  fPrimaryIdxByTrkID.clear(); 
 
   fDirection = {0, 0, 1};
   fEvNumber = -1;
@@ -132,19 +134,48 @@ void SLArMCEvent::SetDirection(double px, double py, double pz) {
 }
 
 bool SLArMCEvent::CheckIfPrimary(int trkId) const {
-  bool is_primary = false; 
-  for (const auto &p : fSLArPrimary) {
-    if (trkId == p.GetTrackID()) {
-      is_primary = true; 
-      break;
+  if (fPrimaryIdxByTrkID.empty()) {
+    for (const auto &p : fSLArPrimary) {
+      if (trkId == p.GetTrackID()) return true; 
     }
+    return false;
   }
-  return is_primary; 
+  return GetPrimaryIdxByTrkID(trkId) >= 0; 
+}
+
+void SLArMCEvent::BuildPrimaryIndex() {
+  fPrimaryIdxByTrkID.clear(); 
+  for (size_t i = 0; i < fSLArPrimary.size(); i++) {
+    const int trkId = fSLArPrimary[i].GetTrackID(); 
+    if (trkId < 0) continue;
+    if (static_cast<size_t>(trkId) >= fPrimaryIdxByTrkID.size()) {
+      fPrimaryIdxByTrkID.resize(trkId+1, -1); 
+    }
+    fPrimaryIdxByTrkID[trkId] = i; 
+  }
+  return;
 }
 
 size_t SLArMCEvent::RegisterPrimary(SLArMCPrimaryInfo& p) {
+  const int trkId = p.GetTrackID(); 
   fSLArPrimary.push_back( std::move(p) );
+  if (trkId >= 0) SetPrimaryTrackID(fSLArPrimary.size()-1, trkId); 
   return fSLArPrimary.size();
 }
 
+void SLArMCEvent::SetPrimaryTrackID(const size_t idx, const int trkId) {
+  if (idx >= fSLArPrimary.size() || trkId < 0) {
+    printf("SLArMCEvent::SetPrimaryTrackID WARNING: invalid primary index %lu or track id %i\n", 
+        idx, trkId); 
+    return;
+  }
+
+  fSLArPrimary[idx].SetTrackID(trkId); 
+  if (static_cast<size_t>(trkId) >= fPrimaryIdxByTrkID.size()) {
+    fPrimaryIdxByTrkID.resize(trkId+1, -1); 
+  }
+  fPrimaryIdxByTrkID[trkId] = idx; 
+  return;
+}
+
 
@@ -14,7 +14,7 @@ ClassImp(SLArMCPrimaryInfo)
 
 SLArMCPrimaryInfo::SLArMCPrimaryInfo() : 
   TNamed(),
-  fID(0), fTrkID(0), fGeneratorLabel(), fEnergy(0.),
+  fID(0), fTrkID(0), fGeneratorLabel(), fEnergy(0.), fTime(0.), fWeight(1.),
   fTotalEdep(0.), fTotalLArEdep(0), fTotalScintPhotons(0), fTotalCerenkovPhotons(0),
   fVertex(3, 0.), fMomentum(3, 0.)
 {
@@ -24,6 +24,7 @@ SLArMCPrimaryInfo::SLArMCPrimaryInfo() :
 SLArMCPrimaryInfo::SLArMCPrimaryInfo(const SLArMCPrimaryInfo& p) 
   : TNamed(p), 
     fID(p.fID), fTrkID(p.fTrkID), fGeneratorLabel(p.fGeneratorLabel), fEnergy(p.fEnergy), 
+    fTime(p.fTime), fWeight(p.fWeight), 
     fTotalEdep(p.fTotalEdep), fTotalLArEdep(p.fTotalLArEdep), 
     fTotalScintPhotons(p.fTotalScintPhotons), fTotalCerenkovPhotons(p.fTotalCerenkovPhotons),
     fVertex(p.fVertex), fMomentum(p.fMomentum) 
@@ -65,6 +66,7 @@ void SLArMCPrimaryInfo::ResetParticle()
   fTitle        = "";
   fEnergy       = 0.;
   fTime         = 0.;
+  fWeight       = 1.;
   fTotalEdep    = 0.;
   fTotalLArEdep = 0.;
   fTotalScintPhotons = 0; 
@@ -85,6 +87,7 @@ void SLArMCPrimaryInfo::PrintParticle() const
   std::cout << "Generator:" << fGeneratorLabel << std::endl;
   std::cout << "Particle:" << fName << ", id: " << fID <<", trk id: " << fTrkID << std::endl;
   std::cout << "Energy  :" << fEnergy <<std::endl;
+  std::cout << "Weight  :" << fWeight <<std::endl;
   std::cout << "Vertex:" << fVertex[0] << ", " 
                          << fVertex[1]<< ", " 
                          << fVertex[2] << " (mm)" << std::endl;
@@ -0,0 +1,146 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArPixelFrontEnd.cc
+ * @created     Monday Oct 19, 2026 15:31:48 CEST
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include "event/SLArPixelFrontEnd.hh"
+
+void SLArPixelFrontEnd::Config_t::Print() const {
+  printf("SLArPixelFrontEnd configuration\n");
+  printf("- trigger mode: %s\n", fTriggerMode == kSelfTrigger ? "self-trigger" : "periodic");
+  printf("- threshold: %g e-\n", fThreshold);
+  printf("- noise rms: %g e-\n", fNoiseRMS);
+  printf("- ADC: %u bits, pedestal %g ADC, gain %g e-/ADC\n", fADCBits, fPedestal, fGain);
+  printf("- hold time: %u ticks\n", fHoldTicks);
+  printf("- dead time: %u ticks\n", fDeadTicks);
+  if (fTriggerMode == kPeriodicTrigger) printf("- trigger period: %u ticks\n", fPeriodTicks);
+  printf("\n");
+  return;
+}
+
+SLArPixelFrontEnd::SLArPixelFrontEnd() : fConfig(), fRandom()
+{}
+
+SLArPixelFrontEnd::SLArPixelFrontEnd(const Config_t& cfg) : fConfig(cfg), fRandom()
+{}
+
+void SLArPixelFrontEnd::SetParameter(const std::string& name, const double val) {
+  if (name == "threshold") fConfig.fThreshold = val;
+  else if (name == "noise") fConfig.fNoiseRMS = val;
+  else if (name == "pedestal") fConfig.fPedestal = val;
+  else if (name == "gain") fConfig.fGain = val;
+  else if (name == "adc_bits") fConfig.fADCBits = static_cast<UShort_t>(val);
+  else if (name == "hold_ticks") fConfig.fHoldTicks = static_cast<UShort_t>(val);
+  else if (name == "dead_ticks") fConfig.fDeadTicks = static_cast<UShort_t>(val);
+  else if (name == "period_ticks") fConfig.fPeriodTicks = static_cast<UShort_t>(val);
+  else if (name == "trigger_mode") {
+    fConfig.fTriggerMode = (val > 0) ? kPeriodicTrigger : kSelfTrigger;
+  }
+  else {
+    throw std::invalid_argument("SLArPixelFrontEnd::SetParameter: unknown parameter " + name);
+  }
+
+  if (fConfig.fGain <= 0) {
+    throw std::invalid_argument("SLArPixelFrontEnd::SetParameter: ADC gain must be positive");
+  }
+  if (fConfig.fADCBits == 0 || fConfig.fADCBits > 16) {
+    throw std::invalid_argument("SLArPixelFrontEnd::SetParameter: ADC bits must be in [1, 16]");
+  }
+  return;
+}
+
+UShort_t SLArPixelFrontEnd::Digitize(const Float_t q) {
+  const Double_t adc_max = (1u << fConfig.fADCBits) - 1;
+  Double_t adc = fConfig.fPedestal + (q + fRandom.Gaus(0, fConfig.fNoiseRMS)) / fConfig.fGain;
+  adc = std::round(adc);
+  if (adc < 0) adc = 0;
+  else if (adc > adc_max) adc = adc_max;
+  return static_cast<UShort_t>(adc);
+}
+
+Float_t SLArPixelFrontEnd::ToElectrons(const UShort_t adc) const {
+  return (adc - fConfig.fPedestal) * fConfig.fGain;
+}
+
+size_t SLArPixelFrontEnd::Process(const HitsCollection_t& hits, std::vector<SLArPixelPacket_t>& packets) {
+  fBuffer.assign(hits.begin(), hits.end());
+  return Process(fBuffer.data(), fBuffer.size(), packets);
+}
+
+/**
+ * @details Process a time-ordered stream of (clock tick, electrons) pairs
+ * and append the resulting packets to `packets`.
+ *
+ * @return number of packets produced
+ */
+size_t SLArPixelFrontEnd::Process(const std::pair<UShort_t, UShort_t>* ticks, const size_t n,
+    std::vector<SLArPixelPacket_t>& packets)
+{
+  const size_t n_packets_start = packets.size();
+  if (n == 0) return 0;
+
+  auto emit = [&](const UInt_t tick, const Double_t q) {
+    SLArPixelPacket_t packet;
+    packet.fTick = static_cast<UShort_t>(tick);
+    packet.fADC = Digitize(q);
+    packet.fQTrue = static_cast<UInt_t>(q);
+    packets.push_back( packet );
+  };
+
+  Double_t q = 0;
+
+  if (fConfig.fTriggerMode == kPeriodicTrigger) {
+    const UInt_t period = fConfig.fPeriodTicks;
+    if (period == 0) {
+      throw std::invalid_argument("SLArPixelFrontEnd::Process: periodic trigger with null period");
+    }
+    UInt_t window_end = (ticks[0].first / period + 1) * period;
+    for (size_t i = 0; i < n; i++) {
+      const UInt_t tick = ticks[i].first;
+      if (tick >= window_end) {
+        if (q > 0) emit(window_end - period, q);
+        q = 0;
+        window_end = (tick / period + 1) * period;
+      }
+      q += ticks[i].second;
+    }
+    if (q > 0) emit(window_end - period, q);
+
+    return packets.size() - n_packets_start;
+  }
+
+  EChannelState state = kIdle;
+  UInt_t trigger_tick = 0;
+  UInt_t release_tick = 0;
+  for (size_t i = 0; i < n; i++) {
+    const UInt_t tick = ticks[i].first;
+
+    if (state == kIntegrating && tick > trigger_tick + fConfig.fHoldTicks) {
+      emit(trigger_tick, q);
+      q = 0;
+      state = kDead;
+      release_tick = trigger_tick + fConfig.fHoldTicks + fConfig.fDeadTicks;
+    }
+
+    if (state == kDead) {
+      if (tick < release_tick) continue;
+      state = kIdle;
+    }
+
+    q += ticks[i].second;
+
+    if (state == kIdle && q + fRandom.Gaus(0, fConfig.fNoiseRMS) > fConfig.fThreshold) {
+      state = kIntegrating;
+      trigger_tick = tick;
+    }
+  }
+
+  if (state == kIntegrating) emit(trigger_tick, q);
+
+  return packets.size() - n_packets_start;
+}
+
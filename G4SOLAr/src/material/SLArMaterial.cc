@@ -6,11 +6,11 @@
 
 #include "SLArUserPath.hh"
 #include "material/SLArMaterial.hh"
+#include "material/SLArMaterialDB.hh"
 
 #include "rapidjson/document.h"
 #include "rapidjson/encodings.h"
 #include "rapidjson/allocators.h"
-#include "rapidjson/filereadstream.h"
 
 #include "G4UIcommand.hh"
 #include "G4NistManager.hh"
@@ -31,7 +31,8 @@ SLArMaterial::SLArMaterial(const SLArMaterial &mat)
   fOpticalSurf   = mat.fOpticalSurf; 
 }
 
-SLArMaterial::SLArMaterial(G4String matID)
+SLArMaterial::SLArMaterial(G4String matID) : 
+  fDBFile(""), fMaterialID(""), fMaterial(nullptr), fOpticalSurf(nullptr)
 {
   SetMaterialID(matID);
 }
@@ -70,30 +71,19 @@ G4Material* SLArMaterial::FindInMaterialTable(const char* mname) {
   return mm;
 }
 
+/**
+ * @details The material description is taken from the shared 
+ * SLArMaterialDB, which parses the database file only once. 
+ */
 G4Material* SLArMaterial::ParseMaterialDB(G4String mat_id) {
   G4Material* material = nullptr; 
-  //- - - - - - - - - - - - - - - - - - - - - - - - - - - - 
-  // open material description file
-  FILE* mat_cfg_file = std::fopen(fDBFile, "r");
-  char readBuffer[65536];
-  rapidjson::FileReadStream is(mat_cfg_file, readBuffer, sizeof(readBuffer));
-
-  rapidjson::Document d;
-  d.ParseStream<rapidjson::kParseCommentsFlag>(is);
-  assert(d.IsObject());
-  assert(d.HasMember("materials")); 
-  assert(d["materials"].IsArray()); 
-
-
-  for (const auto &mats :  d["materials"].GetArray()) {
-    assert(mats.HasMember("name"));
-    if ( !G4StrUtil::contains(mats["name"].GetString(), mat_id) ) {
-      continue;
-    } else {
-      material = ParseMaterial(mats);
-      fclose(mat_cfg_file); 
-      return material; 
-    }
+  auto material_db = SLArMaterialDB::Instance(); 
+  material_db->Load(fDBFile); 
+
+  const auto jmat = material_db->FindMaterial(mat_id); 
+  if (jmat) {
+    material = ParseMaterial(*jmat);
+    return material; 
   }
 
   printf("SLArMaterial::BuildMaterialFromDB(%s) WARNING:", mat_id.c_str()); 
@@ -102,8 +92,6 @@ G4Material* SLArMaterial::ParseMaterialDB(G4String mat_id) {
   material = G4NistManager::Instance()->FindOrBuildMaterial(mat_id, true); 
   material->SetName(mat_id); 
 
-  fclose(mat_cfg_file);
-
   return material; 
 }
 
@@ -115,6 +103,8 @@ void SLArMaterial::BuildMaterialFromDB(G4String db_file, G4String mat_id) {
   fDBFile = db_file; 
    
   if ( (fMaterial = FindInMaterialTable(mat_id)) ) {
+    // share the optical surface built with the material
+    fOpticalSurf = SLArMaterialDB::Instance()->FindSurface(mat_id); 
     return;  
   } 
   
@@ -257,6 +247,8 @@ G4Material* SLArMaterial::ParseMaterial(const rapidjson::Value& jmaterial) {
     printf("SLArMaterial::BuildMaterial(%s): Building Material Surface Properties\n", 
         jmaterial["name"].GetString());
     ParseSurfaceProperties(jmaterial["SurfaceProperties"]);
+    SLArMaterialDB::Instance()->RegisterSurface(
+        jmaterial["name"].GetString(), fOpticalSurf); 
   }
 
   printf("DONE\n");
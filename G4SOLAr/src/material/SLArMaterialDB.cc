@@ -0,0 +1,81 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArMaterialDB.cc
+ * @created     Tuesday Oct 20, 2026 10:38:15 CEST
+ */
+
+#include <cstdio>
+#include <stdexcept>
+
+#include "material/SLArMaterialDB.hh"
+
+#include "rapidjson/filereadstream.h"
+
+SLArMaterialDB* SLArMaterialDB::fgInstance = nullptr;
+
+SLArMaterialDB* SLArMaterialDB::Instance() {
+  if (fgInstance == nullptr) fgInstance = new SLArMaterialDB();
+  return fgInstance;
+}
+
+void SLArMaterialDB::Load(const G4String& db_file) {
+  if (db_file == fDBFile && fDocument.IsObject()) return;
+
+  FILE* mat_cfg_file = std::fopen(db_file, "r");
+  if (mat_cfg_file == nullptr) {
+    char err_msg[200];
+    sprintf(err_msg, "SLArMaterialDB::Load ERROR: cannot open material DB %s\n",
+        db_file.data());
+    throw std::runtime_error(err_msg);
+  }
+  char readBuffer[65536];
+  rapidjson::FileReadStream is(mat_cfg_file, readBuffer, sizeof(readBuffer));
+  fDocument.ParseStream<rapidjson::kParseCommentsFlag>(is);
+  std::fclose(mat_cfg_file);
+
+  if (fDocument.HasParseError() || !fDocument.IsObject() || 
+      !fDocument.HasMember("materials") || !fDocument["materials"].IsArray()) {
+    char err_msg[200];
+    sprintf(err_msg, "SLArMaterialDB::Load ERROR: %s is not a valid material DB\n",
+        db_file.data());
+    throw std::invalid_argument(err_msg);
+  }
+
+  fDBFile = db_file;
+  fMaterials.clear();
+  fIndex.clear();
+  for (const auto& jmat : fDocument["materials"].GetArray()) {
+    if (jmat.HasMember("name") == false) continue;
+    fMaterials.push_back( &jmat );
+    // keep the first entry for duplicated names, as the linear search did
+    fIndex.emplace( jmat["name"].GetString(), &jmat );
+  }
+  printf("SLArMaterialDB::Load: %lu materials indexed from %s\n",
+      fMaterials.size(), fDBFile.data());
+  return;
+}
+
+/**
+ * @details Exact name match first. For backward compatibility, fall back to
+ * the first material whose name contains the requested ID.
+ */
+const rapidjson::Value* SLArMaterialDB::FindMaterial(const G4String& mat_id) const {
+  auto it = fIndex.find(mat_id);
+  if (it != fIndex.end()) return it->second;
+
+  for (const auto& jmat : fMaterials) {
+    if (G4StrUtil::contains((*jmat)["name"].GetString(), mat_id)) return jmat;
+  }
+  return nullptr;
+}
+
+void SLArMaterialDB::RegisterSurface(const G4String& mat_name, G4OpticalSurface* surface) {
+  fSurfaces[mat_name] = surface;
+  return;
+}
+
+G4OpticalSurface* SLArMaterialDB::FindSurface(const G4String& mat_name) const {
+  auto it = fSurfaces.find(mat_name);
+  return (it != fSurfaces.end()) ? it->second : nullptr;
+}
+
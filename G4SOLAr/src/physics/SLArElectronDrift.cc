@@ -149,11 +149,20 @@ void SLArElectronDrift::Drift(const int& n,
   G4RandGauss::shootArray(n_elec_anode, &t_[0], hitTime, diffLengthL/fvDrift); 
 
   SLArCfgAnode::SLArPixIdx pixID;
+  const bool is_staging = anodeEv->IsStagingChargeHits(); 
   for (G4int i=0; i<n_elec_anode; i++) {
     pixID = anodeCfg->GetPixelIndex(x_[i], y_[i]); 
     if (pixID[0] >= 0 && pixID[1] >= 0 && pixID[2] >= 0 ) {
 
       SLArEventChargeHit hit(t_[i], trkId, ancestorId); 
+
+      // online zero suppression: hits (and backtracking info) are staged 
+      // and only moved to the event record at the end of the event
+      if (is_staging) {
+        anodeEv->StageChargeHit(pixID, hit); 
+        continue;
+      }
+
       auto& evPixel = anodeEv->RegisterChargeHit(pixID, hit); 
 
       //#ifdef SLAR_DEBUG
@@ -0,0 +1,28 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArOpAbsorption.cc
+ * @created     Tuesday Oct 20, 2026 09:47:13 CEST
+ */
+
+#include "physics/SLArOpAbsorption.hh"
+
+#include "G4Track.hh"
+#include "G4Material.hh"
+
+SLArOpAbsorption::SLArOpAbsorption(const G4String& processName, G4ProcessType type)
+  : G4OpAbsorption(processName, type), fTable(DBL_MAX)
+{}
+
+void SLArOpAbsorption::BuildPhysicsTable(const G4ParticleDefinition& particle) {
+  G4OpAbsorption::BuildPhysicsTable(particle);
+  fTable.Build(kABSLENGTH);
+  return;
+}
+
+G4double SLArOpAbsorption::GetMeanFreePath(const G4Track& track,
+    G4double, G4ForceCondition*)
+{
+  return fTable.Value(track.GetMaterial()->GetIndex(),
+      track.GetDynamicParticle()->GetTotalMomentum());
+}
+
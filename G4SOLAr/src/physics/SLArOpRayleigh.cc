@@ -0,0 +1,33 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArOpRayleigh.cc
+ * @created     Tuesday Oct 20, 2026 09:49:38 CEST
+ */
+
+#include "physics/SLArOpRayleigh.hh"
+
+#include "G4Track.hh"
+#include "G4Material.hh"
+
+SLArOpRayleigh::SLArOpRayleigh(const G4String& processName, G4ProcessType type)
+  : G4OpRayleigh(processName, type), fTable(DBL_MAX)
+{}
+
+/**
+ * @details The table is built from the physics table of G4OpRayleigh, so
+ * that the mean free paths computed by Geant4 for materials without a
+ * RAYLEIGH property (e.g. Water) are tabulated as well.
+ */
+void SLArOpRayleigh::BuildPhysicsTable(const G4ParticleDefinition& particle) {
+  G4OpRayleigh::BuildPhysicsTable(particle);
+  fTable.Build( GetPhysicsTable() );
+  return;
+}
+
+G4double SLArOpRayleigh::GetMeanFreePath(const G4Track& track,
+    G4double, G4ForceCondition*)
+{
+  return fTable.Value(track.GetMaterial()->GetIndex(),
+      track.GetDynamicParticle()->GetTotalMomentum());
+}
+
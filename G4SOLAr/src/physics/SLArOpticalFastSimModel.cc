@@ -0,0 +1,253 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArOpticalFastSimModel.cc
+ * @created     Monday Oct 19, 2026 22:44:31 CEST
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include "physics/SLArOpticalFastSimModel.hh"
+#include "physics/SLArOpAbsorption.hh"
+#include "physics/SLArOpRayleigh.hh"
+
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4Track.hh"
+#include "G4VTouchable.hh"
+#include "G4NavigationHistory.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessTable.hh"
+#include "Randomize.hh"
+
+SLArOpticalFastSimModel::SLArOpticalFastSimModel(const G4String& name, G4Region* region)
+  : G4VFastSimulationModel(name, region), fHandoffDistance(1.0*CLHEP::cm),
+    fProcessesChecked(false), fAbsorptionOn(false), fRayleighOn(false), 
+    fAbsTable(nullptr), fRayleighTable(nullptr)
+{}
+
+G4bool SLArOpticalFastSimModel::IsApplicable(const G4ParticleDefinition& particle) {
+  return (&particle == G4OpticalPhoton::OpticalPhotonDefinition());
+}
+
+/**
+ * @details The model is triggered when the photon lies in a supported volume
+ * and the first surface on its path is farther than twice the handoff
+ * distance, so that the analytic transport can cover a sizeable path.
+ */
+G4bool SLArOpticalFastSimModel::ModelTrigger(const G4FastTrack& fastTrack) {
+  if (!fProcessesChecked) CheckOpticalProcesses();
+
+  const G4Track* track = fastTrack.GetPrimaryTrack();
+  const G4VTouchable* touchable = track->GetTouchable();
+  if (touchable == nullptr || touchable->GetHistory() == nullptr) return false;
+
+  const auto& vol = GetVolumeCache( touchable->GetVolume()->GetLogicalVolume() );
+  if (vol.fSupported == false) return false;
+
+  const G4AffineTransform& to_local = touchable->GetHistory()->GetTopTransform();
+  const G4ThreeVector pos = to_local.TransformPoint( track->GetPosition() );
+  const G4ThreeVector dir = to_local.TransformAxis( track->GetMomentumDirection() );
+
+  return ( DistanceToSurface(vol, pos, dir) > 2*fHandoffDistance );
+}
+
+/**
+ * @details Transport the photon in the frame of its current volume. At each
+ * leg the absorption and Rayleigh path lengths are sampled from the
+ * material mean free paths at the photon energy: if the shortest one falls
+ * before the handoff point the photon is either absorbed (and killed) or
+ * scattered following the G4OpRayleigh angular distribution, otherwise it
+ * is moved to the handoff point and returned to the full tracking.
+ */
+void SLArOpticalFastSimModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep) {
+  const G4Track* track = fastTrack.GetPrimaryTrack();
+  const G4VTouchable* touchable = track->GetTouchable();
+  const auto& vol = GetVolumeCache( touchable->GetVolume()->GetLogicalVolume() );
+  const G4AffineTransform& to_local = touchable->GetHistory()->GetTopTransform();
+
+  G4ThreeVector pos = to_local.TransformPoint( track->GetPosition() );
+  G4ThreeVector dir = to_local.TransformAxis( track->GetMomentumDirection() );
+  G4ThreeVector pol = to_local.TransformAxis( track->GetPolarization() );
+
+  const G4double energy = track->GetKineticEnergy();
+  G4double abs_length = DBL_MAX;
+  G4double ray_length = DBL_MAX;
+  if (fAbsorptionOn) {
+    if (fAbsTable) abs_length = fAbsTable->Value(vol.fMaterialIdx, energy);
+    else if (vol.fAbsLength) abs_length = vol.fAbsLength->Value(energy);
+  }
+  if (fRayleighOn) {
+    if (fRayleighTable) ray_length = fRayleighTable->Value(vol.fMaterialIdx, energy);
+    else if (vol.fRayleigh) ray_length = vol.fRayleigh->Value(energy);
+  }
+
+  G4double path = 0.0;
+  G4bool absorbed = false;
+  // the number of legs is bounded only to protect against degenerate tables
+  const G4int max_legs = 100000;
+  for (G4int ileg = 0; ileg < max_legs; ileg++) {
+    const G4double free_path =
+      DistanceToSurface(vol, pos, dir) - fHandoffDistance;
+    const G4double s_abs = (abs_length < DBL_MAX) ?
+      -abs_length*std::log(G4UniformRand()) : DBL_MAX;
+    const G4double s_ray = (ray_length < DBL_MAX) ?
+      -ray_length*std::log(G4UniformRand()) : DBL_MAX;
+    const G4double s = std::min(s_abs, s_ray);
+
+    if (s < free_path) {
+      pos += s*dir;
+      path += s;
+      if (s_abs < s_ray) {absorbed = true; break;}
+      RayleighScatter(dir, pol);
+    }
+    else {
+      if (free_path > 0) {
+        pos += free_path*dir;
+        path += free_path;
+      }
+      break;
+    }
+  }
+
+  const G4double velocity = track->CalculateVelocityForOpticalPhoton();
+
+  fastStep.ProposePrimaryTrackPathLength( path );
+  fastStep.ProposePrimaryTrackFinalTime( track->GetGlobalTime() + path/velocity );
+  fastStep.ProposePrimaryTrackFinalPosition(
+      to_local.InverseTransformPoint(pos), false );
+
+  if (absorbed) {
+    fastStep.KillPrimaryTrack();
+    return;
+  }
+
+  fastStep.ProposePrimaryTrackFinalMomentumDirection(
+      to_local.InverseTransformAxis(dir), false );
+  fastStep.ProposePrimaryTrackFinalPolarization(
+      to_local.InverseTransformAxis(pol), false );
+  return;
+}
+
+/**
+ * @details Cache the solid, the daughter placements and the optical
+ * properties of the volume material. Volumes without a refractive index or
+ * with replicated/parameterised daughters are flagged as unsupported.
+ */
+const SLArOpticalFastSimModel::VolumeCache_t&
+SLArOpticalFastSimModel::GetVolumeCache(const G4LogicalVolume* lv) {
+  auto it = fVolumeCache.find(lv);
+  if (it != fVolumeCache.end()) return it->second;
+
+  VolumeCache_t vol;
+  vol.fSolid = lv->GetSolid();
+  vol.fSupported = true;
+  vol.fMaterialIdx = lv->GetMaterial()->GetIndex();
+
+  auto mpt = lv->GetMaterial()->GetMaterialPropertiesTable();
+  if (mpt == nullptr || mpt->GetProperty(kRINDEX) == nullptr) {
+    vol.fSupported = false;
+  }
+  else {
+    vol.fAbsLength = mpt->GetProperty(kABSLENGTH);
+    vol.fRayleigh  = mpt->GetProperty(kRAYLEIGH);
+  }
+
+  for (size_t i = 0; i < lv->GetNoDaughters(); i++) {
+    const auto pv = lv->GetDaughter(i);
+    if (pv->IsReplicated() || pv->IsParameterised()) {
+      vol.fSupported = false;
+      break;
+    }
+    Daughter_t daughter;
+    daughter.fTransform = G4AffineTransform(pv->GetRotation(), pv->GetTranslation());
+    daughter.fTransform.Invert();
+    daughter.fSolid = pv->GetLogicalVolume()->GetSolid();
+    vol.fDaughters.push_back( daughter );
+  }
+
+  return fVolumeCache.emplace(lv, vol).first->second;
+}
+
+/**
+ * @details The bulk processes are sampled only if they are active for the
+ * optical photons in the physics list (e.g. absorption can be switched off
+ * from SLArPhysicsList). When the tabulated processes are used (see
+ * /SLAr/phys/tabulateOptical) the model reads their tables as well.
+ */
+void SLArOpticalFastSimModel::CheckOpticalProcesses() {
+  auto photon = G4OpticalPhoton::OpticalPhotonDefinition();
+  auto pmanager = photon->GetProcessManager();
+  auto ptable = G4ProcessTable::GetProcessTable();
+
+  auto absorption = ptable->FindProcess("OpAbsorption", photon);
+  auto rayleigh = ptable->FindProcess("OpRayleigh", photon);
+  fAbsorptionOn = (absorption && pmanager->GetProcessActivation(absorption));
+  fRayleighOn = (rayleigh && pmanager->GetProcessActivation(rayleigh));
+
+  // use the tabulated mean free paths when the processes provide them
+  if (auto tab_absorption = dynamic_cast<SLArOpAbsorption*>(absorption)) {
+    fAbsTable = &tab_absorption->GetTable();
+  }
+  if (auto tab_rayleigh = dynamic_cast<SLArOpRayleigh*>(rayleigh)) {
+    fRayleighTable = &tab_rayleigh->GetTable();
+  }
+  fProcessesChecked = true;
+  return;
+}
+
+G4double SLArOpticalFastSimModel::DistanceToSurface(const VolumeCache_t& vol,
+    const G4ThreeVector& pos, const G4ThreeVector& dir) const
+{
+  G4double dist = vol.fSolid->DistanceToOut(pos, dir);
+  for (const auto& daughter : vol.fDaughters) {
+    const G4double d = daughter.fSolid->DistanceToIn(
+        daughter.fTransform.TransformPoint(pos),
+        daughter.fTransform.TransformAxis(dir));
+    if (d < dist) dist = d;
+  }
+  return dist;
+}
+
+/**
+ * @details Same sampling as G4OpRayleigh::PostStepDoIt: the new polarization
+ * lies in the plane of the new direction and of the old polarization, and
+ * the pair is accepted with probability cos^2 of the polarization angle.
+ */
+void SLArOpticalFastSimModel::RayleighScatter(G4ThreeVector& dir, G4ThreeVector& pol) const {
+  G4ThreeVector new_dir;
+  G4ThreeVector new_pol;
+  G4double cos_pol = 0.0;
+  do {
+    G4double cos_theta = G4UniformRand();
+    const G4double sin_theta = std::sqrt(1. - cos_theta*cos_theta);
+    if (G4UniformRand() < 0.5) cos_theta = -cos_theta;
+    const G4double phi = CLHEP::twopi*G4UniformRand();
+    new_dir.set(sin_theta*std::cos(phi), sin_theta*std::sin(phi), cos_theta);
+    new_dir.rotateUz(dir);
+    new_dir = new_dir.unit();
+
+    new_pol = pol - new_dir.dot(pol)*new_dir;
+    if (new_pol.mag() == 0.) {
+      const G4double alpha = CLHEP::twopi*G4UniformRand();
+      new_pol.set(std::cos(alpha), std::sin(alpha), 0.);
+      new_pol.rotateUz(new_dir);
+    }
+    else {
+      new_pol = new_pol.unit();
+      if (G4UniformRand() < 0.5) new_pol = -new_pol;
+    }
+    cos_pol = new_pol.dot(pol);
+  } while (cos_pol*cos_pol < G4UniformRand());
+
+  dir = new_dir;
+  pol = new_pol;
+  return;
+}
+
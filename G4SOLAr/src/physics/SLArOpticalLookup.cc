@@ -0,0 +1,327 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArOpticalLookup.cc
+ * @created     Wednesday Oct 21, 2026 14:38:12 CEST
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "physics/SLArOpticalLookup.hh"
+#include "SLArAnalysisManager.hh"
+#include "SLArEventAction.hh"
+#include "SLArPrimaryGeneratorAction.hh"
+#include "SLArUserRegionInformation.hh"
+#include "detector/SuperCell/SLArSuperCellHit.hh"
+#include "detector/Anode/SLArReadoutTileSD.hh"
+
+#include "G4Event.hh"
+#include "G4EventManager.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4Navigator.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4PhysicsFreeVector.hh"
+#include "G4Poisson.hh"
+#include "G4Region.hh"
+#include "G4RunManager.hh"
+#include "G4SDManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TouchableHistory.hh"
+#include "G4TransportationManager.hh"
+#include "Randomize.hh"
+
+namespace {
+  template<class TCfg>
+  SLArOpticalLookup::Detector_t detector_from_cfg(TCfg& cfg) {
+    SLArOpticalLookup::Detector_t det;
+    const auto normal = cfg.GetNormal();
+    const auto axis0 = cfg.GetAxis0();
+    const auto axis1 = cfg.GetAxis1();
+    const auto size = cfg.GetSize();
+    det.fCenter.set( cfg.GetPhysX(), cfg.GetPhysY(), cfg.GetPhysZ() );
+    det.fNormal.set( normal.x(), normal.y(), normal.z() );
+    det.fAxis0.set( axis0.x(), axis0.y(), axis0.z() );
+    det.fAxis1.set( axis1.x(), axis1.y(), axis1.z() );
+    det.fHalfSize0 = 0.5*std::fabs( axis0.Dot(size) );
+    det.fHalfSize1 = 0.5*std::fabs( axis1.Dot(size) );
+    return det;
+  }
+}
+
+SLArOpticalLookup::SLArOpticalLookup(const G4Material* lar)
+  : fAbsLength(nullptr), fGroupVel(nullptr), fEfficiency(nullptr),
+    fEfficiencyScale(1.0), fTileEfficiency(nullptr), fTileEfficiencyScale(1.0),
+    fHCID(-1), fTileSD(nullptr), fNavigator(nullptr)
+{
+  if (lar) fLArName = lar->GetName();
+  const auto mpt = (lar) ? lar->GetMaterialPropertiesTable() : nullptr;
+  if (mpt) {
+    fAbsLength = mpt->GetProperty(kABSLENGTH);
+    fGroupVel = mpt->GetProperty(kGROUPVEL);
+  }
+  else {
+    printf("SLArOpticalLookup WARNING: no optical properties for the LAr material\n");
+  }
+}
+
+SLArOpticalLookup::~SLArOpticalLookup() {
+  if (fNavigator) delete fNavigator;
+}
+
+void SLArOpticalLookup::AddSuperCells(SLArCfgSystemSuperCell& pdsCfg) {
+  for (auto& array_itr : pdsCfg.GetMap()) {
+    auto& arrayCfg = array_itr.second;
+    for (auto& scCfg : arrayCfg.GetMap()) {
+      Detector_t det = detector_from_cfg(scCfg);
+      // same numbering as the copy numbers used by SLArSuperCellSD
+      det.fCellNo = scCfg.GetID() % 100;
+      det.fRowNo = scCfg.GetID() / 100 - 1;
+      det.fArrayNo = arrayCfg.GetIdx();
+      fSuperCell.push_back( det );
+    }
+  }
+  return;
+}
+
+void SLArOpticalLookup::AddAnodes(std::map<int, SLArCfgAnode>& anodeCfg) {
+  for (auto& anode_itr : anodeCfg) {
+    for (auto& mtCfg : anode_itr.second.GetMap()) {
+      Detector_t det = detector_from_cfg(mtCfg);
+      // the anode normal is not oriented towards the LAr volume: the
+      // photons reaching the back of the anode are stopped by the tracing
+      det.fTwoSided = true;
+      fMegaTile.push_back( det );
+    }
+  }
+  return;
+}
+
+G4double SLArOpticalLookup::DistanceToDetector(const Detector_t& det, const G4ThreeVector& pos) {
+  const G4ThreeVector d = pos - det.fCenter;
+  const G4double u = d.dot(det.fAxis0);
+  const G4double v = d.dot(det.fAxis1);
+  const G4double du = std::max(std::fabs(u) - det.fHalfSize0, 0.0);
+  const G4double dv = std::max(std::fabs(v) - det.fHalfSize1, 0.0);
+  const G4double h = d.dot(det.fNormal);
+  return std::sqrt(du*du + dv*dv + h*h);
+}
+
+/**
+ * @details Solid angle subtended by the detector rectangle at the given
+ * point, computed from the corner coordinates (X, Y) relative to the
+ * projection of the point on the detector plane at height h as the signed
+ * sum of atan(XY / (h sqrt(X^2 + Y^2 + h^2))) over the four corners.
+ * Points behind the detector plane do not see the detector.
+ */
+G4double SLArOpticalLookup::SolidAngle(const Detector_t& det, const G4ThreeVector& pos) {
+  const G4ThreeVector d = pos - det.fCenter;
+  G4double h = d.dot(det.fNormal);
+  if (det.fTwoSided) h = std::fabs(h);
+  if (h <= 0.0) return 0.0;
+
+  const G4double u = d.dot(det.fAxis0);
+  const G4double v = d.dot(det.fAxis1);
+  const G4double x[2] = {-det.fHalfSize0 - u, det.fHalfSize0 - u};
+  const G4double y[2] = {-det.fHalfSize1 - v, det.fHalfSize1 - v};
+
+  G4double omega = 0.0;
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 2; j++) {
+      const G4double sign = (i == j) ? 1.0 : -1.0;
+      omega += sign * std::atan( x[i]*y[j] /
+          (h * std::sqrt(x[i]*x[i] + y[j]*y[j] + h*h)) );
+    }
+  }
+  return omega;
+}
+
+G4double SLArOpticalLookup::GetDistanceToDetectors(const G4ThreeVector& pos) const {
+  G4double dmin = DBL_MAX;
+  for (const auto& det : fSuperCell) dmin = std::min(dmin, DistanceToDetector(det, pos));
+  for (const auto& det : fMegaTile) dmin = std::min(dmin, DistanceToDetector(det, pos));
+  return dmin;
+}
+
+/**
+ * @details Same selection and photon counting as in 
+ * SLArStackingAction::ClassifyNewTrack for the tracked scintillation 
+ * photons: photons produced in regions where the optical physics is 
+ * disabled are dropped before being counted, while the photons are 
+ * counted but produce no hits when the optical photons are not traced. 
+ */
+G4bool SLArOpticalLookup::RegisterPhotons(const G4Track& parent, const G4int n_photons) {
+  if (parent.GetVolume()) {
+    auto region_info = dynamic_cast<SLArUserRegionInformation*>(
+        parent.GetVolume()->GetLogicalVolume()->GetRegion()->GetUserInformation()); 
+    if (region_info && region_info->IsOpticalEnabled() == false) return false;
+  }
+
+  auto eventAction = (SLArEventAction*)
+    G4RunManager::GetRunManager()->GetUserEventAction(); 
+  if (eventAction) {
+    eventAction->IncPhotonCount_Scnt( n_photons ); 
+    const int ancestor_id = eventAction->FindAncestorID( parent.GetTrackID() ); 
+    SLArMCPrimaryInfo* primary = 
+      SLArAnalysisManager::Instance()->GetEvent().FindPrimaryByTrkID( ancestor_id ); 
+    if (primary) primary->IncrementScintPhotons( n_photons ); 
+  }
+
+  auto generatorAction = (gen::SLArPrimaryGeneratorAction*)
+    G4RunManager::GetRunManager()->GetUserPrimaryGeneratorAction(); 
+  return (generatorAction == nullptr || generatorAction->DoTraceOptPhotons());
+}
+
+/**
+ * @details The photon energy and the emission point along the segment are
+ * sampled for each candidate, which is then aimed at a uniformly sampled
+ * point of the detector face. The candidate survives with the probability
+ * of not being absorbed along the direct path times the detection
+ * efficiency.
+ */
+G4bool SLArOpticalLookup::SampleCandidate(const Emission_t& emission,
+    const Detector_t& det, const G4MaterialPropertyVector* pde,
+    const G4double pde_scale, Candidate_t& candidate) const
+{
+  const G4double integral_max = emission.fSpectrumIntegral->GetMaxValue();
+  candidate.fEnergy = emission.fSpectrumIntegral->GetEnergy( G4UniformRand()*integral_max );
+
+  const G4double frac = G4UniformRand();
+  candidate.fOrigin = emission.fStart + frac*emission.fDelta;
+  candidate.fTarget = det.fCenter +
+    (2*G4UniformRand() - 1)*det.fHalfSize0*det.fAxis0 +
+    (2*G4UniformRand() - 1)*det.fHalfSize1*det.fAxis1;
+  candidate.fTime = emission.fTime + frac*emission.fDeltaTime
+    - emission.fDecayTime*std::log(G4UniformRand());
+
+  const G4double r = (candidate.fTarget - candidate.fOrigin).mag();
+  G4double p_detection = pde_scale;
+  if (pde) p_detection *= pde->Value(candidate.fEnergy);
+  if (fAbsLength) p_detection *= std::exp(-r / fAbsLength->Value(candidate.fEnergy));
+  return (G4UniformRand() < p_detection);
+}
+
+G4double SLArOpticalLookup::GetArrivalTime(const Candidate_t& candidate, const G4double r) const {
+  const G4double v_group = (fGroupVel) ? fGroupVel->Value(candidate.fEnergy) : CLHEP::c_light;
+  return candidate.fTime + r / v_group;
+}
+
+/**
+ * @details The direct path is followed with a navigator independent from
+ * the tracking one, crossing the LAr volumes (TPC, anode, megatile, tile
+ * rows and cells are all LAr) up to the first volume made of a different
+ * material. The caller owns the returned touchable.
+ */
+const G4VPhysicalVolume* SLArOpticalLookup::TraceToAnode(
+    const Candidate_t& candidate, G4ThreeVector& hitPos, G4TouchableHistory*& touchable)
+{
+  if (fNavigator == nullptr) {
+    fNavigator = new G4Navigator();
+    fNavigator->SetWorldVolume( G4TransportationManager::GetTransportationManager()
+        ->GetNavigatorForTracking()->GetWorldVolume() );
+  }
+
+  const G4ThreeVector dir = (candidate.fTarget - candidate.fOrigin).unit();
+  hitPos = candidate.fOrigin;
+  const G4VPhysicalVolume* volume =
+    fNavigator->LocateGlobalPointAndSetup(hitPos, &dir, false, false);
+
+  const G4int max_steps = 100;
+  for (G4int istep = 0; istep < max_steps; istep++) {
+    if (volume == nullptr) return nullptr;
+    if (volume->GetLogicalVolume()->GetMaterial()->GetName() != fLArName) {
+      touchable = fNavigator->CreateTouchableHistory();
+      return volume;
+    }
+
+    G4double safety = 0.0;
+    const G4double step = fNavigator->ComputeStep(hitPos, dir, kInfinity, safety);
+    if (step == kInfinity) return nullptr;
+    hitPos += step*dir;
+    fNavigator->SetGeometricallyLimitedStep();
+    volume = fNavigator->LocateGlobalPointAndSetup(hitPos, &dir, true, false);
+  }
+
+  return nullptr;
+}
+
+/**
+ * @details The solid angle is evaluated at the middle of the emission
+ * segment, while each hit gets its own emission point along the segment
+ * for the propagation time.
+ */
+void SLArOpticalLookup::ProcessEmission(const Emission_t& emission) {
+  if (emission.fNumPhotons <= 0 || emission.fSpectrumIntegral == nullptr) return;
+  if (emission.fSpectrumIntegral->GetMaxValue() <= 0.0) return;
+
+  const auto event = G4EventManager::GetEventManager()->GetConstCurrentEvent();
+  if (event == nullptr || event->GetHCofThisEvent() == nullptr) return;
+  auto sdManager = G4SDManager::GetSDMpointer();
+
+  const G4ThreeVector center = emission.fStart + 0.5*emission.fDelta;
+  Candidate_t candidate;
+
+  // SuperCells
+  if (fHCID < 0) fHCID = sdManager->GetCollectionID("SuperCellColl");
+  auto hitsCollection = (fHCID < 0) ? nullptr :
+    static_cast<SLArSuperCellHitsCollection*>(event->GetHCofThisEvent()->GetHC(fHCID));
+
+  for (const auto& det : fSuperCell) {
+    if (hitsCollection == nullptr) break;
+    const G4double omega = SolidAngle(det, center);
+    if (omega <= 0.0) continue;
+
+    const G4long n_candidates = G4Poisson( emission.fNumPhotons * omega / (4*CLHEP::pi) );
+    for (G4long k = 0; k < n_candidates; k++) {
+      if (SampleCandidate(emission, det, fEfficiency, fEfficiencyScale, candidate) == false) continue;
+
+      const G4ThreeVector& hitPos = candidate.fTarget;
+      const G4double energy = candidate.fEnergy;
+      auto hit = new SLArSuperCellHit();
+      hit->SetPhotonEnergy( energy );
+      hit->SetPhotonWavelength( CLHEP::h_Planck * CLHEP::c_light / energy *1e6 );
+      hit->SetWorldPos( hitPos );
+      hit->SetLocalPos( hitPos - det.fCenter );
+      hit->SetTime( GetArrivalTime(candidate, (hitPos - candidate.fOrigin).mag()) );
+      hit->SetSuperCellNo( det.fCellNo );
+      hit->SetSuperCellRowNo( det.fRowNo );
+      hit->SetSuperCellArrayNo( det.fArrayNo );
+      hit->SetPhotonProcess( emission.fCreatorProcess );
+      hit->SetProducerID( emission.fParentID );
+      hitsCollection->insert( hit );
+    }
+  }
+
+  // Anode SiPMs
+  if (fTileSD == nullptr && fMegaTile.empty() == false) {
+    fTileSD = dynamic_cast<SLArReadoutTileSD*>(
+        sdManager->FindSensitiveDetector("/tile/sipm", false));
+  }
+
+  for (const auto& det : fMegaTile) {
+    if (fTileSD == nullptr) break;
+    const G4double omega = SolidAngle(det, center);
+    if (omega <= 0.0) continue;
+
+    const G4long n_candidates = G4Poisson( emission.fNumPhotons * omega / (4*CLHEP::pi) );
+    for (G4long k = 0; k < n_candidates; k++) {
+      if (SampleCandidate(emission, det, fTileEfficiency, fTileEfficiencyScale, candidate) == false) continue;
+
+      G4ThreeVector hitPos;
+      G4TouchableHistory* touchable = nullptr;
+      const auto volume = TraceToAnode(candidate, hitPos, touchable);
+      if (volume == nullptr) continue;
+      const G4String& volName = volume->GetName();
+      if (volName == "SiPMActivePV" || volName == "AnodeSensorPlanePV") {
+        fTileSD->ProcessPhotonHit(touchable, hitPos,
+            GetArrivalTime(candidate, (hitPos - candidate.fOrigin).mag()),
+            candidate.fEnergy, emission.fCreatorProcess, emission.fParentID);
+      }
+      delete touchable;
+    }
+  }
+  return;
+}
+
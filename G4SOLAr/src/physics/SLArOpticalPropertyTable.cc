@@ -0,0 +1,97 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        SLArOpticalPropertyTable.cc
+ * @created     Tuesday Oct 20, 2026 09:20:05 CEST
+ */
+
+#include <algorithm>
+
+#include "physics/SLArOpticalPropertyTable.hh"
+
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4PhysicsTable.hh"
+
+void SLArOpticalPropertyTable::Grid_t::Fill(const G4MaterialPropertyVector* vec,
+    const G4double emin, const G4double emax, const G4int n_bins)
+{
+  fEmin = emin;
+  fEmax = emax;
+  fInvStep = n_bins / (emax - emin);
+  fValue.resize(n_bins + 1);
+  const G4double step = (emax - emin) / n_bins;
+  for (G4int i = 0; i <= n_bins; i++) {
+    fValue[i] = vec->Value( std::min(emin + i*step, emax) );
+  }
+  return;
+}
+
+SLArOpticalPropertyTable::SLArOpticalPropertyTable(const G4double default_value,
+    const G4int n_bins, const G4int n_band_bins)
+  : fDefault(default_value), fNBins(n_bins), fNBandBins(n_band_bins), fBuilt(false)
+{}
+
+void SLArOpticalPropertyTable::Build(const G4MaterialPropertyIndex property) {
+  const auto material_table = G4Material::GetMaterialTable();
+  fEntry.clear();
+  fEntry.resize( material_table->size() );
+  for (size_t i = 0; i < material_table->size(); i++) {
+    const auto mpt = (*material_table)[i]->GetMaterialPropertiesTable();
+    if (mpt) BuildEntry(i, mpt->GetProperty(property));
+  }
+  fBuilt = true;
+  return;
+}
+
+void SLArOpticalPropertyTable::Build(const G4PhysicsTable* table) {
+  fEntry.clear();
+  fEntry.resize( G4Material::GetNumberOfMaterials() );
+  if (table) {
+    for (size_t i = 0; i < fEntry.size() && i < table->size(); i++) {
+      BuildEntry(i, static_cast<const G4MaterialPropertyVector*>((*table)(i)));
+    }
+  }
+  fBuilt = true;
+  return;
+}
+
+/**
+ * @details The scintillation band is taken from the energy range of the
+ * SCINTILLATIONCOMPONENT spectra of the material, restricted to the range
+ * of the tabulated property.
+ */
+void SLArOpticalPropertyTable::BuildEntry(const size_t material_idx,
+    const G4MaterialPropertyVector* vec)
+{
+  if (vec == nullptr || vec->GetVectorLength() == 0) return;
+
+  Entry_t& entry = fEntry[material_idx];
+  const G4double emin = vec->GetMinEnergy();
+  const G4double emax = vec->GetMaxEnergy();
+  entry.fValid = true;
+  entry.fLowValue = vec->Value(emin);
+  entry.fHighValue = vec->Value(emax);
+  entry.fFull.fEmin = emin;
+  entry.fFull.fEmax = emax;
+  if (emax <= emin) return;
+  entry.fFull.Fill(vec, emin, emax, fNBins);
+
+  const auto mpt =
+    (*G4Material::GetMaterialTable())[material_idx]->GetMaterialPropertiesTable();
+  if (mpt == nullptr) return;
+  G4double band_min = DBL_MAX;
+  G4double band_max = -DBL_MAX;
+  for (const auto& component : {kSCINTILLATIONCOMPONENT1,
+      kSCINTILLATIONCOMPONENT2, kSCINTILLATIONCOMPONENT3}) {
+    const auto spectrum = mpt->GetProperty(component);
+    if (spectrum == nullptr || spectrum->GetVectorLength() == 0) continue;
+    band_min = std::min(band_min, spectrum->GetMinEnergy());
+    band_max = std::max(band_max, spectrum->GetMaxEnergy());
+  }
+  band_min = std::max(band_min, emin);
+  band_max = std::min(band_max, emax);
+  if (band_max > band_min) entry.fBand.Fill(vec, band_min, band_max, fNBandBins);
+
+  return;
+}
+
@@ -66,6 +66,8 @@
   #define G4DEBUG_SCINTILLATION
 #endif
 
+#include <algorithm>
+
 #include "globals.hh"
 #include "G4DynamicParticle.hh"
 #include "G4EmProcessSubType.hh"
@@ -104,6 +106,9 @@ SLArScintillation::SLArScintillation(const G4String& processName,
   , fNumPhotons(0)
   , fNumIonElectrons(0)
   , fDoGeneratePhotons(true)
+  , fHybridMode(false)
+  , fNearFieldDistance(50.0*CLHEP::cm)
+  , fOpticalLookup(nullptr)
 {
   secID = G4PhysicsModelCatalog::GetModelID("model_Scintillation");
   SetProcessSubType(fScintillation);
@@ -117,6 +122,10 @@ SLArScintillation::SLArScintillation(const G4String& processName,
   scint_mesg_ = new G4GenericMessenger(this, "/SLAr/scint/", "Control Scinitllation Process");
   scint_mesg_->DeclareProperty("electricField", electricField_,"Electric Field for LArQL [kV/cm]");
   scint_mesg_->DeclareProperty("enablePhGeneration", fDoGeneratePhotons, "enable/disable optical ph generation");
+  scint_mesg_->DeclareProperty("hybridMode", fHybridMode, 
+      "track only the photons produced close to the optical detectors (approximate lookup elsewhere, to be validated against full tracking)");
+  scint_mesg_->DeclarePropertyWithUnit("nearFieldDistance", "cm", fNearFieldDistance, 
+      "distance from the optical detectors within which photons are tracked in hybrid mode");
 
   if(verboseLevel > 1)
   {
@@ -355,6 +364,74 @@ void SLArScintillation::BuildPhysicsTable(const G4ParticleDefinition&)
     fIntegralTable2->insertAt(i, vector2);
     fIntegralTable3->insertAt(i, vector3);
   }
+
+  // build the inverse integrals used to sample the photon energies
+  for(G4int scnt = 0; scnt < 3; ++scnt)
+  {
+    G4PhysicsTable* table = (scnt == 0) ? fIntegralTable1 :
+                            (scnt == 1) ? fIntegralTable2 : fIntegralTable3;
+    fInverseIntegral[scnt].clear();
+    fInverseIntegral[scnt].resize(numOfMaterials);
+    for(size_t i = 0; i < numOfMaterials; ++i)
+    {
+      fInverseIntegral[scnt][i].Build((G4PhysicsFreeVector*) ((*table)(i)));
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+void SLArScintillation::InverseIntegral_t::Build(
+  const G4PhysicsFreeVector* integral)
+{
+  fEnergy.clear();
+  fIntegral.clear();
+  fGuide.clear();
+  fMax = 0.0;
+
+  const size_t n = integral->GetVectorLength();
+  if(n < 2)
+    return;
+
+  fEnergy.resize(n);
+  fIntegral.resize(n);
+  for(size_t i = 0; i < n; ++i)
+  {
+    fEnergy[i]   = integral->Energy(i);
+    fIntegral[i] = (*integral)[i];
+  }
+  fMax = fIntegral[n - 1];
+
+  // guide[k] is the last node whose integral is below k/nguide * max
+  const size_t nguide = 2 * n;
+  fGuide.resize(nguide);
+  size_t idx = 0;
+  for(size_t k = 0; k < nguide; ++k)
+  {
+    const G4double threshold = fMax * k / nguide;
+    while(idx + 2 < n && fIntegral[idx + 1] <= threshold)
+      ++idx;
+    fGuide[k] = idx;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+G4double SLArScintillation::InverseIntegral_t::GetEnergy(const G4double u) const
+{
+  const size_t n     = fEnergy.size();
+  const G4double val = u * fMax;
+  size_t k = static_cast<size_t>(u * fGuide.size());
+  if(k >= fGuide.size())
+    k = fGuide.size() - 1;
+
+  size_t idx = fGuide[k];
+  while(idx + 2 < n && fIntegral[idx + 1] < val)
+    ++idx;
+
+  const G4double dI = fIntegral[idx + 1] - fIntegral[idx];
+  if(dI <= 0.0)
+    return fEnergy[idx];
+  return fEnergy[idx] +
+         (val - fIntegral[idx]) * (fEnergy[idx + 1] - fEnergy[idx]) / dI;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -547,10 +624,31 @@ G4VParticleChange* SLArScintillation::PostStepDoIt(const G4Track& aTrack,
     return G4VRestDiscreteProcess::PostStepDoIt(aTrack, aStep);
   }
 
-  aParticleChange.SetNumberOfSecondaries(fNumPhotons);
+  // In hybrid mode the photons emitted far from the optical detectors
+  // are not tracked: the emission is handed to the optical lookup,
+  // which produces the detector hits directly.
+  const G4bool isNeutral = (aParticle->GetDefinition()->GetPDGCharge() == 0);
+  G4bool useLookup = false;
+  if(fHybridMode && fOpticalLookup)
+  {
+    const G4ThreeVector emissionCenter = isNeutral ?
+      pPostStepPoint->GetPosition() : x0 + 0.5 * aStep.GetDeltaPosition();
+    useLookup = (fOpticalLookup->GetDistanceToDetectors(emissionCenter) >
+                 fNearFieldDistance);
+  }
+
+  // the photons handed to the lookup never reach the stacking action,
+  // where the tracked photons are counted
+  if(useLookup && !fOpticalLookup->RegisterPhotons(aTrack, fNumPhotons))
+  {
+    aParticleChange.SetNumberOfSecondaries(0);
+    return G4VRestDiscreteProcess::PostStepDoIt(aTrack, aStep);
+  }
+
+  aParticleChange.SetNumberOfSecondaries(useLookup ? 0 : fNumPhotons);
 
 
-  if(fTrackSecondariesFirst)
+  if(fTrackSecondariesFirst && !useLookup)
   {
     if(aTrack.GetTrackStatus() == fAlive)
       aParticleChange.ProposeTrackStatus(fSuspend);
@@ -624,79 +722,133 @@ G4VParticleChange* SLArScintillation::PostStepDoIt(const G4Track& aTrack,
     if(!scintIntegral)
       continue;
 
-    G4double CIImax = scintIntegral->GetMaxValue();
-    //printf("[scnt %i] fNumPhotons: %i -> numPhot = %lu (%.2f\%%)\n", 
-        //scnt, fNumPhotons, numPhot, G4double(numPhot) / fNumPhotons); 
-    //getchar();
-    for(size_t i = 0; i < numPhot; ++i)
+    const InverseIntegral_t& inverseIntegral =
+      fInverseIntegral[scnt][materialIndex];
+    if(inverseIntegral.IsEmpty())
+      continue;
+
+    // The photon kinematics is generated in blocks of kPhotonBatch photons:
+    // the uniform random numbers of a block are drawn at once and each
+    // quantity is computed in a separate loop over contiguous arrays, which
+    // the compiler can vectorize. The polarization is built directly from
+    // the orthonormal basis (e_theta, e_phi) of the photon direction.
+    const G4double v0 = pPreStepPoint->GetVelocity();
+    const G4double dv = pPostStepPoint->GetVelocity() - v0;
+    const G4double stepLength = aStep.GetStepLength();
+    const G4ThreeVector deltaPosition = aStep.GetDeltaPosition();
+
+    if(useLookup)
     {
-      // Determine photon energy
-      G4double CIIvalue      = G4UniformRand() * CIImax;
-      G4double sampledEnergy = scintIntegral->GetEnergy(CIIvalue);
+      SLArVOpticalLookup::Emission_t emission;
+      const G4double stepTime = stepLength / (v0 + dv / 2.);
+      emission.fStart = isNeutral ? x0 + deltaPosition : x0;
+      emission.fDelta = isNeutral ? G4ThreeVector() : deltaPosition;
+      emission.fTime = isNeutral ? t0 + stepTime : t0;
+      emission.fDeltaTime = isNeutral ? 0.0 : stepTime;
+      emission.fDecayTime = scintTime;
+      emission.fNumPhotons = numPhot;
+      emission.fParentID = aTrack.GetTrackID();
+      emission.fSpectrumIntegral = scintIntegral;
+      emission.fCreatorProcess = GetProcessName();
+      fOpticalLookup->ProcessEmission(emission);
+      continue;
+    }
+
+    CLHEP::HepRandomEngine* engine = G4Random::getTheEngine();
+
+    G4double rnd[6 * kPhotonBatch];
+    G4double energy[kPhotonBatch];
+    G4double cost[kPhotonBatch], sint[kPhotonBatch];
+    G4double cosp[kPhotonBatch], sinp[kPhotonBatch];
+    G4double cosa[kPhotonBatch], sina[kPhotonBatch];
+    G4double frac[kPhotonBatch], dt[kPhotonBatch];
 
-      if(verboseLevel > 1)
+    for(size_t first = 0; first < numPhot; first += kPhotonBatch)
+    {
+      const size_t nb = std::min(kPhotonBatch, numPhot - first);
+      engine->flatArray(6 * nb, rnd);
+      const G4double* uEnergy = rnd;
+      const G4double* uCost   = rnd + nb;
+      const G4double* uPhi    = rnd + 2 * nb;
+      const G4double* uPol    = rnd + 3 * nb;
+      const G4double* uPos    = rnd + 4 * nb;
+      const G4double* uTime   = rnd + 5 * nb;
+
+      // Determine photon energies
+      for(size_t i = 0; i < nb; ++i)
+        energy[i] = inverseIntegral.GetEnergy(uEnergy[i]);
+
+      // Generate random photon directions and polarization angles
+      for(size_t i = 0; i < nb; ++i)
       {
-        G4cout << "sampledEnergy = " << sampledEnergy << G4endl;
-        G4cout << "CIIvalue =        " << CIIvalue << G4endl;
+        cost[i] = 1. - 2. * uCost[i];
+        sint[i] = std::sqrt((1. - cost[i]) * (1. + cost[i]));
       }
-
-      // Generate random photon direction
-      G4double cost = 1. - 2. * G4UniformRand();
-      G4double sint = std::sqrt((1. - cost) * (1. + cost));
-      G4double phi  = twopi * G4UniformRand();
-      G4double sinp = std::sin(phi);
-      G4double cosp = std::cos(phi);
-      G4ParticleMomentum photonMomentum(sint * cosp, sint * sinp, cost);
-
-      // Determine polarization of new photon
-      G4ThreeVector photonPolarization(cost * cosp, cost * sinp, -sint);
-      G4ThreeVector perp = photonMomentum.cross(photonPolarization);
-      phi                = twopi * G4UniformRand();
-      sinp               = std::sin(phi);
-      cosp               = std::cos(phi);
-      photonPolarization = (cosp * photonPolarization + sinp * perp).unit();
-
-      // Generate a new photon:
-      G4DynamicParticle* scintPhoton =
-        new G4DynamicParticle(opticalphoton, photonMomentum);
-      scintPhoton->SetPolarization(photonPolarization);
-      scintPhoton->SetKineticEnergy(sampledEnergy);
-
-      // Generate new G4Track object:
-      G4double rand = G4UniformRand();
-      if(aParticle->GetDefinition()->GetPDGCharge() == 0)
+      for(size_t i = 0; i < nb; ++i)
+      {
+        cosp[i] = std::cos(twopi * uPhi[i]);
+        sinp[i] = std::sin(twopi * uPhi[i]);
+      }
+      for(size_t i = 0; i < nb; ++i)
       {
-        rand = 1.0;
+        cosa[i] = std::cos(twopi * uPol[i]);
+        sina[i] = std::sin(twopi * uPol[i]);
       }
 
-      // emission time distribution
-      G4double delta = rand * aStep.GetStepLength();
-      G4double deltaTime =
-        delta /
-        (pPreStepPoint->GetVelocity() +
-         rand * (pPostStepPoint->GetVelocity() - pPreStepPoint->GetVelocity()) /
-           2.);
+      // emission point along the step and time distribution
+      for(size_t i = 0; i < nb; ++i)
+      {
+        frac[i] = isNeutral ? 1.0 : uPos[i];
+        dt[i]   = frac[i] * stepLength / (v0 + frac[i] * dv / 2.);
+      }
       if(riseTime == 0.0)
       {
-        deltaTime -= scintTime * std::log(G4UniformRand());
+        for(size_t i = 0; i < nb; ++i)
+          dt[i] -= scintTime * std::log(uTime[i]);
       }
       else
       {
-        deltaTime += sample_time(riseTime, scintTime);
+        for(size_t i = 0; i < nb; ++i)
+          dt[i] += sample_time(riseTime, scintTime);
       }
 
-      G4double secTime          = t0 + deltaTime;
-      G4ThreeVector secPosition = x0 + rand * aStep.GetDeltaPosition();
-
-      G4Track* secTrack = new G4Track(scintPhoton, secTime, secPosition);
-      secTrack->SetTouchableHandle(
-        aStep.GetPreStepPoint()->GetTouchableHandle());
-      secTrack->SetParentID(aTrack.GetTrackID());
-      secTrack->SetCreatorModelID(secID);
-      if(fScintillationTrackInfo)
-        secTrack->SetUserInformation(
-          new G4ScintillationTrackInformation(scintType));
-      aParticleChange.AddSecondary(secTrack);
+      for(size_t i = 0; i < nb; ++i)
+      {
+        G4ParticleMomentum photonMomentum(sint[i] * cosp[i],
+                                          sint[i] * sinp[i], cost[i]);
+        // cos(a) e_theta + sin(a) e_phi is a unit vector normal to the
+        // direction
+        G4ThreeVector photonPolarization(
+          cosa[i] * cost[i] * cosp[i] - sina[i] * sinp[i],
+          cosa[i] * cost[i] * sinp[i] + sina[i] * cosp[i],
+          -cosa[i] * sint[i]);
+
+        // Generate a new photon:
+        G4DynamicParticle* scintPhoton =
+          new G4DynamicParticle(opticalphoton, photonMomentum);
+        scintPhoton->SetPolarization(photonPolarization);
+        scintPhoton->SetKineticEnergy(energy[i]);
+
+        if(verboseLevel > 1)
+        {
+          G4cout << "sampledEnergy = " << energy[i] << G4endl;
+        }
+
+        G4double secTime          = t0 + dt[i];
+        G4ThreeVector secPosition = x0 + frac[i] * deltaPosition;
+
+        // G4Track and G4DynamicParticle are served by the Geant4
+        // thread-local pool allocators
+        G4Track* secTrack = new G4Track(scintPhoton, secTime, secPosition);
+        secTrack->SetTouchableHandle(
+          aStep.GetPreStepPoint()->GetTouchableHandle());
+        secTrack->SetParentID(aTrack.GetTrackID());
+        secTrack->SetCreatorModelID(secID);
+        if(fScintillationTrackInfo)
+          secTrack->SetUserInformation(
+            new G4ScintillationTrackInformation(scintType));
+        aParticleChange.AddSecondary(secTrack);
+      }
     }
   }
 
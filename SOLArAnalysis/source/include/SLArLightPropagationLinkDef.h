@@ -9,4 +9,5 @@
 #pragma link C++ nestedtypedefs;
 #pragma link C++ namespace slarAna;
 #pragma link C++ class SLArLightPropagationModel+;
+#pragma link C++ class slarAna::SLArPhotonTimingLibrary+;
 #endif
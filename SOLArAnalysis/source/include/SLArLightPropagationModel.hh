@@ -26,6 +26,7 @@
 #include <string>
 
 #include "TF1.h"
+#include "TRandom.h"
 #include "TVector3.h"
 
 
@@ -48,6 +49,21 @@ namespace slarAna {
 
   extern TString DetectorFaceName[6];
 
+  /*! \struct ArrivalTimePars_t
+   *
+   *  Parameters of the photon arrival time distribution on an optical
+   *  detector: a Landau for the direct and forward-scattered light plus
+   *  an exponential tail for the diffuse light, both starting at the
+   *  direct-path time fT0. All times are in ns.
+   */
+  struct ArrivalTimePars_t {
+    double fT0 = 0.;        //!< Direct-path arrival time
+    double fLandauMPV = 0.; //!< Landau location parameter
+    double fLandauWidth = 1.;
+    double fExpFraction = 0.; //!< Fraction of photons in the exponential tail
+    double fExpTau = 1.;
+  };
+
   class SLArLightPropagationModel {
 
     private:
@@ -65,6 +81,13 @@ namespace slarAna {
 
       std::map<EDetectorFace, EDetectorClass> fFaceClass;
 
+      // arrival time tables fitted to full optical tracking (see LoadArrivalTimeTables)
+      std::vector<double> fTimingDistance;    // cm
+      std::vector<double> fTimingLandauDelay; // ns
+      std::vector<double> fTimingLandauWidth; // ns
+      std::vector<double> fTimingExpFraction;
+      std::vector<double> fTimingExpTau;      // ns
+
     public:
       // constructor
       SLArLightPropagationModel();
@@ -76,6 +99,20 @@ namespace slarAna {
           SLArCfgBaseModule* cfgTile, 
           const TVector3 &ScintPoint);
 
+      // arrival time distribution on the optical detector
+      ArrivalTimePars_t ArrivalTimeOpDetTile(
+          SLArCfgBaseModule* cfgTile,
+          const TVector3 &ScintPoint);
+      ArrivalTimePars_t ArrivalTimeAtDistance(const double distance);
+      static double DirectPathTime(const double distance);
+      void LoadArrivalTimeTables(const char* file_path, const char* tree_name = "arrival_time_pars");
+      inline bool HasArrivalTimeTables() const {return !fTimingDistance.empty();}
+      static double ArrivalTimePDF(const double t, const ArrivalTimePars_t& pars);
+      static double ArrivalTimeCDF(const double t, const ArrivalTimePars_t& pars);
+      static double SampleArrivalTime(const ArrivalTimePars_t& pars, TRandom* rndm);
+      static void ArrivalTimeQuantiles(const ArrivalTimePars_t& pars,
+          const int n_quantiles, std::vector<double>& quantiles);
+
       // gaisser-hillas function
       static Double_t GaisserHillas(double x, double *par);
 
@@ -76,6 +76,19 @@ namespace slarAna {
   // LAr absorption length in cm
   const double L_abs = 2000.;	// 20 m
 
+  // ************************************************************************
+  //                    ARRIVAL TIME PARAMETRIZATION
+  // ************************************************************************
+  // Mean group velocity of the LAr VUV scintillation light (same value as
+  // the DUNE semi-analytical model)
+  const double vuv_vgroup_mean = 10.13;	// cm/ns
+
+  // The Landau (direct and few-scatter light) + exponential (diffuse light)
+  // parameters of the arrival time distribution as a function of the
+  // distance are not hard-coded: they are fitted to a full optical tracking
+  // run by build_vis_map (-f) and loaded with
+  // SLArLightPropagationModel::LoadArrivalTimeTables.
+
   // ************************************************************************
   //                    NUMBER OF VIS HITS PARAMETRIZATION
   // ************************************************************************
@@ -0,0 +1,85 @@
+/**
+ * @author      : Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        : SLArPhotonTimingLibrary.hh
+ * @created     : Wednesday Oct 21, 2026 10:12:37 CEST
+ *
+ * @brief       : Voxelised photon library storing, for each voxel and
+ *                optical channel, the visibility and a compact quantized
+ *                table of the photon arrival time distribution
+ */
+
+#ifndef SLARPHOTONTIMINGLIBRARY_HH
+
+#define SLARPHOTONTIMINGLIBRARY_HH
+
+#include <vector>
+
+#include "TNamed.h"
+#include "TRandom.h"
+
+namespace slarAna {
+  /**
+   * @brief Compact per-voxel, per-channel photon visibility and timing library
+   *
+   * The library covers a box divided in nx*ny*nz voxels. Only the channels
+   * with a non-negligible visibility are stored for each voxel, in a
+   * compressed-row layout: the entries of voxel i are those in the range
+   * [fVoxelOffset[i], fVoxelOffset[i+1]). The arrival time distribution of
+   * each entry is described by the direct-path time and by n_quantiles-1
+   * quantiles of its cumulative, evenly spaced between 0 and 0.999 and
+   * stored as 16-bit offsets in units of fTimeStep. This costs
+   * 2*(n_quantiles-1) + 10 bytes per entry, and a hit time is sampled with
+   * one random number and a linear interpolation.
+   *
+   * Entries must be added in increasing voxel order. Times are in ns,
+   * positions in the units used to build the library.
+   */
+  class SLArPhotonTimingLibrary : public TNamed {
+    public:
+      SLArPhotonTimingLibrary();
+      SLArPhotonTimingLibrary(const char* name, const char* title,
+          const int nx, const double xmin, const double xmax,
+          const int ny, const double ymin, const double ymax,
+          const int nz, const double zmin, const double zmax,
+          const int n_quantiles = 16, const double time_step = 0.1);
+      ~SLArPhotonTimingLibrary() {}
+
+      int  FindVoxel(const double x, const double y, const double z) const;
+      void GetVoxelCenter(const int voxel, double& x, double& y, double& z) const;
+      inline int GetNVoxels() const {return fNx*fNy*fNz;}
+      inline int GetNQuantiles() const {return fNQuantiles;}
+      inline double GetTimeStep() const {return fTimeStep;}
+      inline size_t GetNEntries() const {return fChannel.size();}
+
+      void AddEntry(const int voxel, const int channel, const float visibility,
+          const std::vector<double>& quantiles);
+      //! Index of the first and (one past the) last entry of the voxel
+      void GetVoxelEntries(const int voxel, size_t& first, size_t& last) const;
+      inline int GetEntryChannel(const size_t entry) const {return fChannel[entry];}
+      inline float GetEntryVisibility(const size_t entry) const {return fVisibility[entry];}
+      //! Arrival time of the k-th stored quantile of the entry (k = 0 is the direct-path time)
+      double GetEntryQuantileTime(const size_t entry, const int k) const;
+      double SampleArrivalTime(const size_t entry, TRandom* rndm) const;
+
+    private:
+      int fNx;
+      int fNy;
+      int fNz;
+      double fMin[3];
+      double fMax[3];
+      int fNQuantiles;
+      double fTimeStep; // Quantization step of the arrival time quantiles [ns]
+
+      std::vector<UInt_t> fVoxelOffset; // Index of the first entry of each voxel
+      std::vector<Int_t> fChannel;
+      std::vector<Float_t> fVisibility;
+      std::vector<Float_t> fT0; // Direct-path arrival time of each entry [ns]
+      std::vector<UShort_t> fQuantile;
+
+    public:
+      ClassDef(SLArPhotonTimingLibrary, 1);
+  };
+}
+
+#endif /* end of include guard SLARPHOTONTIMINGLIBRARY_HH */
+
@@ -5,6 +5,7 @@
  */
 
 #include <iostream>
+#include <algorithm>
 #include <getopt.h>
 #include "TFile.h"
 #include "TTree.h"
@@ -31,8 +32,153 @@ typedef SLArCfgBaseSystem<SLArCfgSuperCellArray> SLArPDSCfg;
 typedef SLArCfgBaseSystem<SLArCfgMegaTile> SLArPixCfg;
 
 #include "SLArLightPropagationModel.hh"
+#include "SLArPhotonTimingLibrary.hh"
 
-void build_vis_map(const char* data_file_path, const char* output_path = "") 
+// minimum visibility of the channels stored in the timing library
+const double vis_timing_min = 1e-9; 
+
+// distance bins [cm] and minimum number of hits of the arrival time fits
+const std::vector<double> fit_distance_edges = 
+{0, 25, 50, 100, 150, 200, 300, 400, 500, 600, 800, 1000, 1200, 1600}; 
+const int fit_min_hits = 1000; 
+
+/**
+ * @brief Fit the arrival time tables to a full optical tracking run
+ *
+ * The input must be produced with the photon bomb generator, so that all
+ * the photons of an event are emitted at the vertex and time of the first
+ * primary. For each SuperCell with hits, the delay of the hit times with
+ * respect to the direct-path time d/vuv_vgroup_mean is histogrammed in
+ * bins of the distance d between vertex and SuperCell, and fitted with
+ * the truncated Landau plus exponential model of SLArLightPropagationModel.
+ * Only SuperCells are used since their event index is the configuration ID.
+ * The fitted parameters are written to tables_path as the arrival_time_pars
+ * tree read by SLArLightPropagationModel::LoadArrivalTimeTables, together
+ * with the fitted delay histograms.
+ */
+int fit_arrival_time(const char* tracking_file_path, const char* tables_path) 
+{
+  TFile* file = new TFile(tracking_file_path); 
+  if (file->IsZombie()) {
+    fprintf(stderr, "fit_arrival_time: unable to open %s\n", tracking_file_path); 
+    return 1; 
+  }
+  SLArPDSCfg* scCfg = (SLArPDSCfg*)file->Get("PDSSysConfig"); 
+  TTree* tree = file->Get<TTree>("EventTree"); 
+  if (scCfg == nullptr || tree == nullptr) {
+    fprintf(stderr, "fit_arrival_time: no PDSSysConfig or EventTree in %s\n", tracking_file_path); 
+    return 1; 
+  }
+
+  const double cm = G4UIcommand::ValueOf("cm"); 
+
+  const size_t n_dist = fit_distance_edges.size() - 1; 
+  std::vector<TH1D*> hDelay(n_dist, nullptr); 
+  std::vector<double> sum_distance(n_dist, 0.); 
+  for (size_t id = 0; id < n_dist; id++) {
+    hDelay[id] = new TH1D(Form("hDelay_%lu", id), 
+        Form("%g < d < %g cm;Delay [ns];Hits", fit_distance_edges[id], fit_distance_edges[id+1]), 
+        401, -1, 400); 
+  }
+
+  SLArMCEvent* ev = nullptr; 
+  tree->SetBranchAddress("MCEvent", &ev); 
+  for (Long64_t iev = 0; iev < tree->GetEntries(); iev++) {
+    tree->GetEntry(iev); 
+    if (ev->GetPrimaries().empty()) continue;
+    const auto& primary = ev->GetPrimary(0); 
+    const TVector3 vertex(primary.GetVertex()[0]/cm, 
+        primary.GetVertex()[1]/cm, primary.GetVertex()[2]/cm); 
+
+    for (auto& sc_array : ev->GetEventSuperCellArray()) {
+      auto& arrayCfg = scCfg->GetBaseElement(sc_array.first); 
+      for (auto& sc : sc_array.second.GetSuperCellMap()) {
+        if (sc.second.GetConstHits().empty()) continue;
+        const auto& cfg = arrayCfg.GetBaseElementByID(sc.first); 
+        const TVector3 sc_pos(cfg.GetPhysX()/cm, cfg.GetPhysY()/cm, cfg.GetPhysZ()/cm); 
+        const double distance = (vertex - sc_pos).Mag(); 
+        const auto bin = std::upper_bound(fit_distance_edges.begin(), fit_distance_edges.end(), distance); 
+        if (bin == fit_distance_edges.begin() || bin == fit_distance_edges.end()) continue;
+        const size_t id = bin - fit_distance_edges.begin() - 1; 
+
+        const double t_direct = primary.GetTime() + 
+          slarAna::SLArLightPropagationModel::DirectPathTime(distance); 
+        for (const auto& tick : sc.second.GetConstHits()) {
+          // hit times are stored in clock ticks, take the tick center
+          const double t_hit = (tick.first + 0.5)*sc.second.GetClockUnit(); 
+          hDelay[id]->Fill(t_hit - t_direct, tick.second); 
+          sum_distance[id] += distance*tick.second; 
+        }
+      }
+    }
+  }
+
+  // landau + exponential model of the delay, normalised to the histogram entries
+  TF1* fDelay = new TF1("fDelay", [](double* x, double* p) {
+      slarAna::ArrivalTimePars_t pars; 
+      pars.fLandauMPV = p[1]; 
+      pars.fLandauWidth = p[2]; 
+      pars.fExpFraction = p[3]; 
+      pars.fExpTau = p[4]; 
+      return p[0]*slarAna::SLArLightPropagationModel::ArrivalTimePDF(x[0], pars); 
+      }, 0, 400, 5); 
+  fDelay->SetParNames("norm", "landau_delay", "landau_width", "exp_fraction", "exp_tau"); 
+
+  TFile* ftables = new TFile(tables_path, "recreate"); 
+  TTree* tpars = new TTree("arrival_time_pars", "arrival time parameters fitted to full tracking"); 
+  double distance = 0., delay = 0., width = 0., fraction = 0., tau = 0.; 
+  tpars->Branch("distance", &distance); 
+  tpars->Branch("landau_delay", &delay); 
+  tpars->Branch("landau_width", &width); 
+  tpars->Branch("exp_fraction", &fraction); 
+  tpars->Branch("exp_tau", &tau); 
+
+  for (size_t id = 0; id < n_dist; id++) {
+    TH1D* h = hDelay[id]; 
+    if (h->Integral() < fit_min_hits) {
+      printf("fit_arrival_time: %g hits at %g-%g cm, skipping\n", 
+          h->Integral(), fit_distance_edges[id], fit_distance_edges[id+1]); 
+      continue;
+    }
+    // start from the histogram shape
+    fDelay->SetParameters(h->Integral()*h->GetBinWidth(1), 
+        std::max(h->GetBinCenter(h->GetMaximumBin()), 0.), std::max(0.25*h->GetRMS(), 0.5), 
+        0.2, std::max(h->GetMean(), 1.)); 
+    fDelay->SetParLimits(1, 0, 400); 
+    fDelay->SetParLimits(2, 0.01, 100); 
+    fDelay->SetParLimits(3, 0, 1); 
+    fDelay->SetParLimits(4, 0.1, 1000); 
+    const int status = h->Fit(fDelay, "QLR"); 
+    h->Write(); 
+    if (status != 0) {
+      printf("fit_arrival_time: fit at %g-%g cm failed (status %i), skipping\n", 
+          fit_distance_edges[id], fit_distance_edges[id+1], status); 
+      continue;
+    }
+
+    distance = sum_distance[id] / h->Integral(); 
+    delay = fDelay->GetParameter(1); 
+    width = fDelay->GetParameter(2); 
+    fraction = fDelay->GetParameter(3); 
+    tau = fDelay->GetParameter(4); 
+    printf("d = %6.1f cm: delay %6.2f ns, width %6.2f ns, exp. fraction %.3f, tau %6.2f ns\n", 
+        distance, delay, width, fraction, tau); 
+    tpars->Fill(); 
+  }
+  tpars->Write(); 
+  const Long64_t n_fitted = tpars->GetEntries(); 
+  ftables->Close(); 
+  file->Close(); 
+
+  if (n_fitted < 2) {
+    fprintf(stderr, "fit_arrival_time: only %lli distance bins fitted, at least 2 are needed\n", n_fitted); 
+    return 1; 
+  }
+  return 0; 
+}
+
+void build_vis_map(const char* data_file_path, const char* output_path = "", 
+    const int n_time_quantiles = 0, const char* timing_tables_path = "") 
 {
   //--------------------------------------------------------- Source plot style 
   slide_default(); 
@@ -56,12 +202,31 @@ void build_vis_map(const char* data_file_path, const char* output_path = "")
       20 , -3000, +3000, 
       28 , -7000, 7000); 
 
+  // create the per-voxel, per-channel arrival time libraries. Channels are 
+  // numbered following the ordering of the configuration maps 
+  slarAna::SLArPhotonTimingLibrary* timePixSys = nullptr; 
+  slarAna::SLArPhotonTimingLibrary* timeSCSys = nullptr; 
+  if (n_time_quantiles > 0) {
+    timePixSys = new slarAna::SLArPhotonTimingLibrary("timePix", 
+        Form("%s arrival time", pixCfg->GetName()), 
+        18 , -1800, +1800, 
+        20 , -3000, +3000, 
+        28, -7000, 7000, n_time_quantiles); 
+    timeSCSys = new slarAna::SLArPhotonTimingLibrary("timeSC", 
+        Form("%s arrival time", scCfg->GetName()), 
+        18 , -1800, +1800, 
+        20 , -3000, +3000, 
+        28, -7000, 7000, n_time_quantiles); 
+  }
+  std::vector<double> quantiles; 
+
   // Create semi-analytical light propagation model 
   slarAna::SLArLightPropagationModel lightModel;
   lightModel.SetDetectorClass(slarAna::kNorth  , slarAna::kReadoutTile);
   lightModel.SetDetectorClass(slarAna::kSouth  , slarAna::kReadoutTile);
   lightModel.SetDetectorClass(slarAna::kTop    , slarAna::kSuperCell);
   lightModel.SetDetectorClass(slarAna::kBottom , slarAna::kSuperCell);
+  if (n_time_quantiles > 0) lightModel.LoadArrivalTimeTables(timing_tables_path); 
 
   // loop over the map's bins and compute the local visibility
   int ibin = 0; 
@@ -73,9 +238,18 @@ void build_vis_map(const char* data_file_path, const char* output_path = "")
         double z_ = hvisPixSys->GetZaxis()->GetBinCenter(izbin)/G4UIcommand::ValueOf("cm"); 
 
         double vis = 0.; 
+        int ichannel = 0; 
         for (const auto &mod : pixCfg->GetModuleMap()) {
           for (auto &tile : mod.second->GetMap()) {
-            vis += lightModel.VisibilityOpDetTile(tile.second, TVector3(x_, y_, z_));  
+            const TVector3 scint_point(x_, y_, z_); 
+            const double vis_tile = lightModel.VisibilityOpDetTile(tile.second, scint_point);  
+            vis += vis_tile; 
+            if (timePixSys && vis_tile > vis_timing_min) {
+              auto time_pars = lightModel.ArrivalTimeOpDetTile(tile.second, scint_point); 
+              lightModel.ArrivalTimeQuantiles(time_pars, n_time_quantiles, quantiles); 
+              timePixSys->AddEntry(ibin, ichannel, vis_tile, quantiles); 
+            }
+            ichannel++; 
           }
         }
 
@@ -96,9 +270,18 @@ void build_vis_map(const char* data_file_path, const char* output_path = "")
         double z_ = hvisSCSys->GetZaxis()->GetBinCenter(izbin)/G4UIcommand::ValueOf("cm"); 
 
         double vis = 0.; 
+        int ichannel = 0; 
         for (const auto &mod : scCfg->GetModuleMap()) {
           for (auto &tile : mod.second->GetMap()) {
-            vis += lightModel.VisibilityOpDetTile(tile.second, TVector3(x_, y_, z_));  
+            const TVector3 scint_point(x_, y_, z_); 
+            const double vis_tile = lightModel.VisibilityOpDetTile(tile.second, scint_point);  
+            vis += vis_tile; 
+            if (timeSCSys && vis_tile > vis_timing_min) {
+              auto time_pars = lightModel.ArrivalTimeOpDetTile(tile.second, scint_point); 
+              lightModel.ArrivalTimeQuantiles(time_pars, n_time_quantiles, quantiles); 
+              timeSCSys->AddEntry(ibin, ichannel, vis_tile, quantiles); 
+            }
+            ichannel++; 
           }
         }
 
@@ -114,6 +297,8 @@ void build_vis_map(const char* data_file_path, const char* output_path = "")
     TFile* fvismap = new TFile(output_path, "recreate"); 
     hvisPixSys->Write();
     hvisSCSys ->Write(); 
+    if (timePixSys) timePixSys->Write(); 
+    if (timeSCSys ) timeSCSys ->Write(); 
     fvismap->Close(); 
   }
 
@@ -125,16 +310,22 @@ void PrintUsage() {
   printf("Usage:\nbuild_vis_map\n");
   printf("\t-i(--input) input file with PDS configuration\n");
   printf("\t-o(--output) output file with visibility map\n"); 
+  printf("\t-t(--timing) number of arrival time quantiles stored in the timing library (default 0: no library)\n"); 
+  printf("\t-T(--timing-tables) file with the fitted arrival time tables (required with -t, written with -f)\n"); 
+  printf("\t-f(--fit-timing) full optical tracking file (photon bomb) to fit the arrival time tables to\n"); 
   printf("\t-h(--help) print this message\n");
 }
 
 int main(int argc, char *argv[])
 {
-  const char* short_opts = "i:o:h";
-  static struct option long_opts[4] = 
+  const char* short_opts = "i:o:t:T:f:h";
+  static struct option long_opts[7] = 
   {
     {"input", required_argument, 0, 'i'}, 
     {"output", required_argument, 0, 'o'}, 
+    {"timing", required_argument, 0, 't'}, 
+    {"timing-tables", required_argument, 0, 'T'}, 
+    {"fit-timing", required_argument, 0, 'f'}, 
     {"help", no_argument, 0, 'h'}, 
     {nullptr, no_argument, nullptr, 0} 
   };
@@ -143,6 +334,9 @@ int main(int argc, char *argv[])
 
   const char* input_file = ""; 
   const char* output_file = ""; 
+  const char* timing_tables_file = ""; 
+  const char* tracking_file = ""; 
+  int n_time_quantiles = 0; 
 
   while ( (c = getopt_long(argc, argv, short_opts, long_opts, &option_index)) != -1) {
     switch(c) {
@@ -152,13 +346,37 @@ int main(int argc, char *argv[])
       case 'o':
         output_file = optarg; 
         break;
+      case 't':
+        n_time_quantiles = std::atoi(optarg); 
+        break;
+      case 'T':
+        timing_tables_file = optarg; 
+        break;
+      case 'f':
+        tracking_file = optarg; 
+        break;
       case 'h':
         PrintUsage(); 
         return 4; 
         break;
     }
   }
+
+  // fit the arrival time tables first, so that they can be used right away 
+  if (tracking_file[0] != '\0') {
+    if (timing_tables_file[0] == '\0') {
+      fprintf(stderr, "build_vis_map: -f needs the output file of the fitted tables (-T)\n"); 
+      return 1; 
+    }
+    if (fit_arrival_time(tracking_file, timing_tables_file)) return 1; 
+    if (input_file[0] == '\0') return 0; 
+  }
+
+  if (n_time_quantiles > 0 && timing_tables_file[0] == '\0') {
+    fprintf(stderr, "build_vis_map: the timing library needs the fitted arrival time tables (-T)\n"); 
+    return 1; 
+  }
   
-  build_vis_map(input_file, output_file); 
+  build_vis_map(input_file, output_file, n_time_quantiles, timing_tables_file); 
   return 0;
 }
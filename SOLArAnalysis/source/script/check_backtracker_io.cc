@@ -0,0 +1,301 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        check_backtracker_io.cc
+ * @created     Monday Oct 19, 2026 11:04:52 CEST
+ */
+
+#include <iostream>
+#include <getopt.h>
+#include "TFile.h"
+#include "TTree.h"
+#include "TStreamerInfo.h"
+#include "TRandom3.h"
+
+#include "event/SLArMCEvent.hh"
+#include "event/SLArEventHitsCollection.hh"
+#include "event/SLArEventBacktrackerRecord.hh"
+
+//! Fill the records with random contributors, overflowing the inline storage
+void fill_random_vector(SLArEventBacktrackerVector& bkt_vector,
+    std::vector<BacktrackerCounter_t>& expected, TRandom3& rndm)
+{
+  const UShort_t n_records = 3;
+  bkt_vector.InitRecords(n_records);
+  expected.assign(n_records, BacktrackerCounter_t());
+  for (UShort_t ir = 0; ir < n_records; ir++) {
+    const int n_updates = rndm.Integer(3*SLArEventBacktrackerRecord::kInlineSize + 1);
+    for (int i = 0; i < n_updates; i++) {
+      const int key = static_cast<int>(rndm.Integer(12)) - 2;
+      const UShort_t count = 1 + rndm.Integer(100);
+      bkt_vector.GetRecords().at(ir).UpdateCounter(key, count);
+      expected.at(ir)[key] += count;
+    }
+  }
+}
+
+int compare_vector(const SLArEventBacktrackerVector& bkt_vector,
+    const std::vector<BacktrackerCounter_t>& expected, const char* label)
+{
+  if (bkt_vector.GetConstRecords().size() != expected.size()) {
+    printf("%s: %lu records read, %lu expected\n",
+        label, bkt_vector.GetConstRecords().size(), expected.size());
+    return 1;
+  }
+  for (size_t ir = 0; ir < expected.size(); ir++) {
+    if (bkt_vector.GetConstRecords().at(ir).GetConstCounter() != expected.at(ir)) {
+      printf("%s: record %lu differs from the one written\n", label, ir);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Write and read back the current (v2) backtracker layout
+ *
+ * The records are written as a top-level object, in a split and in a
+ * non-split tree branch holding a BacktrackerVectorCollection_t, which is
+ * how they are stored in the event tree.
+ */
+int check_write_read(const char* output_path, const int n_entries)
+{
+  int n_fail = 0;
+  TRandom3 rndm(0);
+
+  std::vector<std::map<UShort_t, std::vector<BacktrackerCounter_t>>> expected(n_entries);
+  SLArEventBacktrackerVector single_vector;
+  std::vector<BacktrackerCounter_t> single_expected;
+  fill_random_vector(single_vector, single_expected, rndm);
+
+  TFile* file = new TFile(output_path, "recreate");
+  file->WriteObject(&single_vector, "single_vector");
+
+  TTree* tree = new TTree("bkt_tree", "backtracker I/O check");
+  BacktrackerVectorCollection_t* collection = new BacktrackerVectorCollection_t();
+  tree->Branch("bkt_split", &collection, 32000, 99);
+  tree->Branch("bkt_nosplit", &collection, 32000, 0);
+  for (int iev = 0; iev < n_entries; iev++) {
+    collection->clear();
+    const int n_ticks = rndm.Integer(6);
+    for (int it = 0; it < n_ticks; it++) {
+      const UShort_t tick = rndm.Integer(1000);
+      if (collection->count(tick)) continue;
+      fill_random_vector((*collection)[tick], expected[iev][tick], rndm);
+    }
+    tree->Fill();
+  }
+  tree->Write();
+  file->Close();
+  delete file;
+  delete collection;
+
+  file = new TFile(output_path);
+  auto single_read = file->Get<SLArEventBacktrackerVector>("single_vector");
+  if (single_read == nullptr) {
+    printf("check_write_read: unable to read the top-level vector back\n");
+    n_fail++;
+  }
+  else {
+    n_fail += compare_vector(*single_read, single_expected, "single_vector");
+  }
+
+  tree = file->Get<TTree>("bkt_tree");
+  for (const auto& branch : {"bkt_split", "bkt_nosplit"}) {
+    BacktrackerVectorCollection_t* collection_read = nullptr;
+    tree->SetBranchAddress(branch, &collection_read);
+    for (int iev = 0; iev < tree->GetEntries(); iev++) {
+      tree->GetEntry(iev);
+      if (collection_read->size() != expected[iev].size()) {
+        printf("%s: entry %i has %lu ticks, %lu expected\n",
+            branch, iev, collection_read->size(), expected[iev].size());
+        n_fail++;
+        continue;
+      }
+      for (const auto& tick : expected[iev]) {
+        auto bkt_vector = collection_read->find(tick.first);
+        if (bkt_vector == collection_read->end()) {
+          printf("%s: entry %i misses tick %u\n", branch, iev, tick.first);
+          n_fail++;
+          continue;
+        }
+        n_fail += compare_vector(bkt_vector->second, tick.second, branch);
+      }
+    }
+    tree->ResetBranchAddresses();
+    delete collection_read;
+  }
+  file->Close();
+
+  printf("check_write_read: %i entries written and read back, %i failures\n",
+      n_entries, n_fail);
+  return n_fail;
+}
+
+struct BacktrackerStats_t {
+  size_t fNVectors = 0;
+  size_t fNRecords = 0;
+  size_t fNFilledRecords = 0;
+  size_t fNContributors = 0;
+  int fNFail = 0;
+};
+
+/**
+ * @details The backtracker of each hit tick is filled with the same
+ * weight used to register the hits, so the records must refer to ticks
+ * with hits, have positive counts and sum to at most the tick hits.
+ */
+template<class T>
+void check_collection(const SLArEventHitsCollection<T>& hits, BacktrackerStats_t& stats)
+{
+  const auto& hit_map = hits.GetConstHits();
+  for (const auto& bkt_vector : hits.GetBacktrackerRecordCollection()) {
+    stats.fNVectors++;
+    const auto tick = hit_map.find(bkt_vector.first);
+    if (tick == hit_map.end()) {
+      printf("%s: backtracker records for tick %u without hits\n",
+          hits.GetName(), bkt_vector.first);
+      stats.fNFail++;
+      continue;
+    }
+    for (const auto& record : bkt_vector.second.GetConstRecords()) {
+      stats.fNRecords++;
+      if (record.IsEmpty()) continue;
+      stats.fNFilledRecords++;
+      int total = 0;
+      for (UShort_t i = 0; i < record.GetSize(); i++) {
+        if (record.GetCount(i) == 0) {
+          printf("%s: null backtracker count in tick %u\n", hits.GetName(), tick->first);
+          stats.fNFail++;
+        }
+        total += record.GetCount(i);
+        stats.fNContributors++;
+      }
+      if (total > tick->second) {
+        printf("%s: tick %u has %i backtracked hits out of %u\n",
+            hits.GetName(), tick->first, total, tick->second);
+        stats.fNFail++;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Read the backtracker records of an existing event file
+ *
+ * Meant to be run on an output file produced before version 2 of the
+ * backtracker classes, in which the records were TObjects holding a
+ * std::map and were streamed member-wise in the split event tree.
+ */
+int check_event_file(const char* input_path)
+{
+  TFile* file = new TFile(input_path);
+  if (file->IsZombie()) {
+    printf("check_event_file: unable to open %s\n", input_path);
+    return 1;
+  }
+  TTree* tree = file->Get<TTree>("EventTree");
+  if (tree == nullptr) {
+    printf("check_event_file: no EventTree in %s\n", input_path);
+    return 1;
+  }
+
+  auto bkt_info = file->GetStreamerInfoList()->FindObject("SLArEventBacktrackerRecord");
+  if (bkt_info) {
+    printf("check_event_file: %s written with SLArEventBacktrackerRecord v%i\n",
+        input_path, static_cast<TStreamerInfo*>(bkt_info)->GetClassVersion());
+  }
+
+  SLArMCEvent* ev = nullptr;
+  tree->SetBranchAddress("MCEvent", &ev);
+
+  BacktrackerStats_t stats_tile, stats_pix, stats_sc;
+  for (Long64_t iev = 0; iev < tree->GetEntries(); iev++) {
+    tree->GetEntry(iev);
+    for (auto& anode : ev->GetEventAnode()) {
+      for (auto& megatile : anode.second.GetMegaTilesMap()) {
+        for (auto& tile : megatile.second.GetTileMap()) {
+          check_collection(tile.second, stats_tile);
+          for (auto& pixel : tile.second.GetPixelEvents()) {
+            check_collection(pixel.second, stats_pix);
+          }
+        }
+      }
+    }
+    for (auto& sc_array : ev->GetEventSuperCellArray()) {
+      for (auto& sc : sc_array.second.GetSuperCellMap()) {
+        check_collection(sc.second, stats_sc);
+      }
+    }
+  }
+
+  int n_fail = 0;
+  for (const auto& stats : {std::make_pair("tile", stats_tile),
+      std::make_pair("pixel", stats_pix), std::make_pair("supercell", stats_sc)}) {
+    printf("%-10s: %lu tick vectors, %lu records (%lu filled), %lu contributors, %i failures\n",
+        stats.first, stats.second.fNVectors, stats.second.fNRecords,
+        stats.second.fNFilledRecords, stats.second.fNContributors, stats.second.fNFail);
+    n_fail += stats.second.fNFail;
+  }
+  if (stats_tile.fNFilledRecords + stats_pix.fNFilledRecords + stats_sc.fNFilledRecords == 0) {
+    printf("check_event_file WARNING: no backtracker contributor read from %s\n", input_path);
+  }
+
+  file->Close();
+  return n_fail;
+}
+
+void PrintUsage() {
+  printf("check_backtracker_io: I/O check of the backtracker records\n");
+  printf("Usage:\ncheck_backtracker_io\n");
+  printf("\t-o(--output) file where the test records are written (default backtracker_io_check.root)\n");
+  printf("\t-n(--entries) number of test entries (default 1000)\n");
+  printf("\t-i(--input) event file written with a previous version of the records (optional)\n");
+  printf("\t-h(--help) print this message\n");
+}
+
+int main(int argc, char *argv[])
+{
+  const char* short_opts = "o:n:i:h";
+  static struct option long_opts[5] =
+  {
+    {"output", required_argument, 0, 'o'},
+    {"entries", required_argument, 0, 'n'},
+    {"input", required_argument, 0, 'i'},
+    {"help", no_argument, 0, 'h'},
+    {nullptr, no_argument, nullptr, 0}
+  };
+
+  int c, option_index;
+
+  const char* output_file = "backtracker_io_check.root";
+  const char* input_file = "";
+  int n_entries = 1000;
+
+  while ( (c = getopt_long(argc, argv, short_opts, long_opts, &option_index)) != -1) {
+    switch(c) {
+      case 'o':
+        output_file = optarg;
+        break;
+      case 'n':
+        n_entries = std::atoi(optarg);
+        break;
+      case 'i' :
+        input_file = optarg;
+        break;
+      case 'h':
+        PrintUsage();
+        return 4;
+        break;
+    }
+  }
+
+  int n_fail = check_write_read(output_file, n_entries);
+  if ( (input_file != NULL) && (input_file[0] != '\0') ) {
+    n_fail += check_event_file(input_file);
+  }
+
+  if (n_fail) printf("check_backtracker_io: FAILED\n");
+  else printf("check_backtracker_io: OK\n");
+
+  return (n_fail > 0);
+}
@@ -0,0 +1,277 @@
+/**
+ * @author      Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        check_timing_library.cc
+ * @created     Monday Oct 19, 2026 10:12:37 CEST
+ */
+
+#include <iostream>
+#include <getopt.h>
+#include <cmath>
+#include <algorithm>
+#include "TFile.h"
+#include "TRandom3.h"
+
+#include "SLArLightPropagationModel.hh"
+#include "SLArPhotonTimingLibrary.hh"
+
+/**
+ * @brief Check a timing library read back from file
+ *
+ * For each entry the stored quantiles must be sorted and start at the
+ * direct-path time; the times sampled with SampleArrivalTime must never be
+ * earlier than the direct-path time, and the fraction of samples below the
+ * k-th stored quantile must be compatible with k/(n_quantiles-1).
+ * When the model parameters of the entries are given, the stored quantiles
+ * are also compared with the model ones within half a time step.
+ */
+int check_library(const slarAna::SLArPhotonTimingLibrary* lib,
+    const std::vector<slarAna::ArrivalTimePars_t>* model_pars,
+    const int n_samples, TRandom* rndm)
+{
+  int n_fail = 0;
+  const int nq = lib->GetNQuantiles();
+  const double step = lib->GetTimeStep();
+  std::vector<double> model_q;
+  std::vector<int> n_below(nq, 0);
+
+  for (size_t entry = 0; entry < lib->GetNEntries(); entry++) {
+    bool entry_ok = true;
+
+    for (int k = 1; k < nq; k++) {
+      if (lib->GetEntryQuantileTime(entry, k) < lib->GetEntryQuantileTime(entry, k-1)) {
+        entry_ok = false;
+      }
+    }
+
+    if (model_pars) {
+      slarAna::SLArLightPropagationModel::ArrivalTimeQuantiles(
+          model_pars->at(entry), nq, model_q);
+      for (int k = 0; k < nq; k++) {
+        // the 16-bit offsets saturate at 65535 time steps
+        const double q_model = std::min(model_q[k], model_q[0] + 65535*step);
+        if (fabs(lib->GetEntryQuantileTime(entry, k) - q_model) > 0.5*step + 1e-3) {
+          printf("entry %lu: quantile %i is %g ns, model gives %g ns\n",
+              entry, k, lib->GetEntryQuantileTime(entry, k), q_model);
+          entry_ok = false;
+        }
+      }
+    }
+
+    std::fill(n_below.begin(), n_below.end(), 0);
+    const double t0 = lib->GetEntryQuantileTime(entry, 0);
+    for (int i = 0; i < n_samples; i++) {
+      const double t = lib->SampleArrivalTime(entry, rndm);
+      if (t < t0 - 1e-6) {
+        printf("entry %lu: sampled time %g ns before the direct-path time %g ns\n",
+            entry, t, t0);
+        entry_ok = false;
+        break;
+      }
+      for (int k = 1; k < nq; k++) {
+        if (t < lib->GetEntryQuantileTime(entry, k)) n_below[k]++;
+      }
+    }
+
+    for (int k = 1; k < nq-1; k++) {
+      const double p = k / (nq - 1.);
+      const double sigma = sqrt(p*(1-p)/n_samples);
+      const double f = n_below[k] / double(n_samples);
+      // degenerate quantiles (equal times) accumulate the samples of the
+      // following bins, only check the ones with a finite width
+      const bool degenerate =
+        lib->GetEntryQuantileTime(entry, k+1) == lib->GetEntryQuantileTime(entry, k) ||
+        lib->GetEntryQuantileTime(entry, k-1) == lib->GetEntryQuantileTime(entry, k);
+      if (!degenerate && fabs(f - p) > 5*sigma + 1e-3) {
+        printf("entry %lu: %g of the samples below quantile %i, expected %g\n",
+            entry, f, k, p);
+        entry_ok = false;
+      }
+    }
+
+    if (!entry_ok) n_fail++;
+  }
+
+  printf("%s: %lu entries checked, %i failed\n",
+      lib->GetName(), lib->GetNEntries(), n_fail);
+  return n_fail;
+}
+
+/**
+ * @brief Arrival time parameters of the test library entries
+ *
+ * With fitted tables the parameters are those of the model, otherwise the
+ * library machinery is exercised with test shapes spanning from a narrow
+ * Landau to a broad one with a dominant exponential tail. The test shapes
+ * are not a description of the light propagation.
+ */
+slarAna::ArrivalTimePars_t test_arrival_time(
+    slarAna::SLArLightPropagationModel& lightModel, const double distance)
+{
+  if (lightModel.HasArrivalTimeTables()) {
+    return lightModel.ArrivalTimeAtDistance(distance);
+  }
+
+  const double u = std::min(distance / 800., 1.);
+  slarAna::ArrivalTimePars_t pars;
+  pars.fT0 = slarAna::SLArLightPropagationModel::DirectPathTime(distance);
+  pars.fLandauMPV = pars.fT0 + 20.*u;
+  pars.fLandauWidth = 0.1 + 10.*u;
+  pars.fExpFraction = 0.9*u;
+  pars.fExpTau = 1. + 50.*u;
+  return pars;
+}
+
+/**
+ * @brief Round-trip check of the photon timing library
+ *
+ * A test library is filled with the quantiles given by test_arrival_time
+ * on a line of voxels at increasing distance from a detector, written to a
+ * file and read back, then checked against the model. If an input file is
+ * given, the timePix and timeSC libraries produced by build_vis_map are
+ * also read and checked.
+ */
+int check_timing_library(const char* output_path, const char* input_path,
+    const char* tables_path, const int n_quantiles, const int n_samples)
+{
+  int n_fail = 0;
+  TRandom3 rndm(0);
+
+  //------------------------------------------------ Build and write the test library
+  slarAna::SLArLightPropagationModel lightModel;
+  if ( (tables_path != NULL) && (tables_path[0] != '\0') ) {
+    lightModel.LoadArrivalTimeTables(tables_path);
+  }
+  const int n_voxels = 40;
+  const int n_channels = 2;
+  slarAna::SLArPhotonTimingLibrary* lib = new slarAna::SLArPhotonTimingLibrary(
+      "timeTest", "timing library round-trip test",
+      1, 0, 1,
+      1, 0, 1,
+      n_voxels, 0, 8000, n_quantiles);
+
+  std::vector<slarAna::ArrivalTimePars_t> model_pars;
+  std::vector<double> quantiles;
+  for (int ivox = 0; ivox < n_voxels; ivox++) {
+    double x, y, z;
+    lib->GetVoxelCenter(ivox, x, y, z);
+    for (int ich = 0; ich < n_channels; ich++) {
+      // channels at different distances from the voxel [cm]
+      const double distance = 0.1*z + 20.*ich;
+      const auto pars = test_arrival_time(lightModel, distance);
+      slarAna::SLArLightPropagationModel::ArrivalTimeQuantiles(pars, n_quantiles, quantiles);
+      lib->AddEntry(ivox, ich, 1.0, quantiles);
+      model_pars.push_back( pars );
+    }
+  }
+
+  TFile* file = new TFile(output_path, "recreate");
+  lib->Write();
+  file->Close();
+  delete file;
+  delete lib;
+
+  //------------------------------------------------- Read back and check
+  file = new TFile(output_path);
+  auto libRead = file->Get<slarAna::SLArPhotonTimingLibrary>("timeTest");
+  if (!libRead) {
+    printf("check_timing_library: unable to read the test library back from %s\n", output_path);
+    return 1;
+  }
+  if (libRead->GetNEntries() != model_pars.size() ||
+      libRead->GetNQuantiles() != n_quantiles) {
+    printf("check_timing_library: library read back with wrong header\n");
+    return 1;
+  }
+  for (int ivox = 0; ivox < n_voxels; ivox++) {
+    size_t first = 0, last = 0;
+    libRead->GetVoxelEntries(ivox, first, last);
+    if (last - first != n_channels) {
+      printf("check_timing_library: voxel %i has %lu entries, %i expected\n",
+          ivox, last - first, n_channels);
+      n_fail++;
+    }
+  }
+  n_fail += check_library(libRead, &model_pars, n_samples, &rndm);
+  file->Close();
+
+  //------------------------------------------------- Check the input libraries
+  if ( (input_path != NULL) && (input_path[0] != '\0') ) {
+    TFile* fvismap = new TFile(input_path);
+    for (const auto& name : {"timePix", "timeSC"}) {
+      auto libInput = fvismap->Get<slarAna::SLArPhotonTimingLibrary>(name);
+      if (!libInput) {
+        printf("check_timing_library: no %s library in %s\n", name, input_path);
+        continue;
+      }
+      n_fail += check_library(libInput, nullptr, n_samples, &rndm);
+    }
+    fvismap->Close();
+  }
+
+  return n_fail;
+}
+
+void PrintUsage() {
+  printf("check_timing_library: round-trip check of the photon timing library\n");
+  printf("Usage:\ncheck_timing_library\n");
+  printf("\t-o(--output) file where the test library is written (default timing_library_check.root)\n");
+  printf("\t-i(--input) visibility map produced by build_vis_map to be checked (optional)\n");
+  printf("\t-T(--timing-tables) fitted arrival time tables used for the test library (optional)\n");
+  printf("\t-t(--timing) number of arrival time quantiles of the test library (default 16)\n");
+  printf("\t-n(--samples) number of sampled arrival times per entry (default 20000)\n");
+  printf("\t-h(--help) print this message\n");
+}
+
+int main(int argc, char *argv[])
+{
+  const char* short_opts = "o:i:T:t:n:h";
+  static struct option long_opts[7] =
+  {
+    {"output", required_argument, 0, 'o'},
+    {"input", required_argument, 0, 'i'},
+    {"timing-tables", required_argument, 0, 'T'},
+    {"timing", required_argument, 0, 't'},
+    {"samples", required_argument, 0, 'n'},
+    {"help", no_argument, 0, 'h'},
+    {nullptr, no_argument, nullptr, 0}
+  };
+
+  int c, option_index;
+
+  const char* output_file = "timing_library_check.root";
+  const char* input_file = "";
+  const char* tables_file = "";
+  int n_quantiles = 16;
+  int n_samples = 20000;
+
+  while ( (c = getopt_long(argc, argv, short_opts, long_opts, &option_index)) != -1) {
+    switch(c) {
+      case 'o':
+        output_file = optarg;
+        break;
+      case 'i' :
+        input_file = optarg;
+        break;
+      case 'T':
+        tables_file = optarg;
+        break;
+      case 't':
+        n_quantiles = std::atoi(optarg);
+        break;
+      case 'n':
+        n_samples = std::atoi(optarg);
+        break;
+      case 'h':
+        PrintUsage();
+        return 4;
+        break;
+    }
+  }
+
+  const int n_fail = check_timing_library(output_file, input_file, tables_file,
+      n_quantiles, n_samples);
+  if (n_fail) printf("check_timing_library: FAILED\n");
+  else printf("check_timing_library: OK\n");
+
+  return (n_fail > 0);
+}
@@ -5,8 +5,10 @@
  */
 
 #include <getopt.h>
+#include <atomic>
 #include <iostream>
 #include <fstream>
+#include <memory>
 #include "TFile.h"
 #include "TDirectory.h"
 #include "TROOT.h"
@@ -29,6 +31,8 @@
 #include "config/SLArCfgMegaTile.hh"
 #include "config/SLArCfgSuperCellArray.hh"
 
+#include "TMCEventReader.hh"
+
 #include "solar_root_style.hpp"
 
 typedef SLArCfgBaseSystem<SLArCfgSuperCellArray> SLArPDSCfg;
@@ -47,9 +51,10 @@ std::vector<double>  vBinsLT = { -1.25,  1.25,  3.75,  6.25,  8.75, 11.25,
 
 struct  SLArHistoSet {
   public: 
-    SLArHistoSet(); 
+    SLArHistoSet(const TString suffix = ""); 
     ~SLArHistoSet(); 
 
+    void Add(const SLArHistoSet& h); 
     void Write(const char* output_path); 
 
     SLArPixCfg* fPixCfg; 
@@ -64,32 +69,32 @@ struct  SLArHistoSet {
 
 }; 
 
-SLArHistoSet::SLArHistoSet() : 
+SLArHistoSet::SLArHistoSet(const TString suffix) : 
   fPixCfg(nullptr), fSCCfg(nullptr), 
   hVtxOrigin(nullptr), 
   hvis(nullptr), hNPhotons(nullptr), 
   hPosition(3, nullptr), hResVsCoverage(nullptr)
 {
-  hVtxOrigin = new TH3D("hVtxOrigin", "Vertex Origin;#it{x} [mm];#it{y} [mm];#it{z} [mm]", 
+  hVtxOrigin = new TH3D("hVtxOrigin"+suffix, "Vertex Origin;#it{x} [mm];#it{y} [mm];#it{z} [mm]", 
       moduleSize[0]/100, -0.5*moduleSize[0], +0.5*moduleSize[0], 
       moduleSize[1]/100, -0.5*moduleSize[1], +0.5*moduleSize[1], 
       moduleSize[2]/100, -0.5*moduleSize[2], +0.5*moduleSize[2]
       );
   
-  hvis = new TH1D("hvis", "Visible Energy", 200, 0., 20); 
-  hNPhotons = new TH1D("hNPhotons", 
+  hvis = new TH1D("hvis"+suffix, "Visible Energy", 200, 0., 20); 
+  hNPhotons = new TH1D("hNPhotons"+suffix, 
       "Nr of photons produced;Nr of photons produced (true);Entries",
       1000, 0, 1e6);
   double  _dimensions[3] = {1.8, 3, 7}; 
   TString _positions[3] = {"x", "y", "z"};
   for (int i=0; i<3; i++) {
-    hPosition[i] = new TH1D(Form("hPosition%s", _positions[i].Data()), 
+    hPosition[i] = new TH1D(Form("hPosition%s%s", _positions[i].Data(), suffix.Data()), 
         Form("Event starting point #it{%s};#it{%s} [mm];Entries", 
           _positions[i].Data(), _positions[i].Data()), 
         200, -_dimensions[i]*1000, _dimensions[i]*1000); 
   }
 
-  hResVsCoverage = new TH2D("hResVsCoverage", 
+  hResVsCoverage = new TH2D("hResVsCoverage"+suffix, 
       Form("%s;%s;%s;%s", "Energy resolution vs eff photo-coverage", 
         "Readout Tile coverage [%]", "Light Trap coverage [%]", "#it{#sigma}(#it{E}_{L}) [%]"), 
       vBinsRT.size()-1, &vBinsRT[0], vBinsLT.size()-1, &vBinsLT[0]);
@@ -102,12 +107,12 @@ SLArHistoSet::SLArHistoSet() :
 
       hResCoverage.insert(
           std::make_pair(ib, 
-            new TH1D(Form("hResCoverage%i", ib), 
+            new TH1D(Form("hResCoverage%i%s", ib, suffix.Data()), 
               Form("Energy Resolution - #it{#varepsilon}_{RT} = %.2f%% - #it{#varepsilon}_{LT} = %.2f%%;#it{#delta}(E) [%%];Entries", 
                 epsRT, epsLT), 
               1000, -50, +50)));
       hEffLY.insert(
-          std::make_pair(ib, new TH1D(Form("hEffLY%i", ib), 
+          std::make_pair(ib, new TH1D(Form("hEffLY%i%s", ib, suffix.Data()), 
               Form("Effective LY - #it{#varepsilon}_{RT} = %.2f%% - #it{#varepsilon}_{LT} = %.2f%%;#it{#delta}(E) [%%];Entries", 
                 epsRT, epsLT), 
               500, 0, 1000)));
@@ -135,6 +140,23 @@ SLArHistoSet::~SLArHistoSet() {
   hEffLY.clear(); 
 }
 
+void SLArHistoSet::Add(const SLArHistoSet& h) {
+  hVtxOrigin->Add( h.hVtxOrigin ); 
+  hvis->Add( h.hvis ); 
+  hNPhotons->Add( h.hNPhotons ); 
+  hResVsCoverage->Add( h.hResVsCoverage ); 
+  for (int j=0; j<3; j++) {
+    hPosition[j]->Add( h.hPosition[j] ); 
+  }
+  for (auto &hh : hResCoverage) {
+    hh.second->Add( h.hResCoverage.at(hh.first) ); 
+  }
+  for (auto &hh : hEffLY) {
+    hh.second->Add( h.hEffLY.at(hh.first) ); 
+  }
+  return;
+}
+
 void SLArHistoSet::Write(const char* output_path) {
   TFile* output = new TFile(output_path, "recreate");
   output->cd(); 
@@ -166,10 +188,11 @@ void SLArHistoSet::Write(const char* output_path) {
   output->Close(); 
 }
 
-void process_event_tree(TTree* tree, SLArHistoSet* h, TH3D* visPix, TH3D* visSC); 
+void process_event_tree(TMCEventReader& reader, SLArHistoSet* h, 
+    const TH3D* visPix, const TH3D* visSC, const UInt_t n_threads); 
 
 void test_output(const char* input_path, const char* output_path = "", 
-    TH3D* hvisPix = nullptr, TH3D* hvisSC = nullptr) 
+    TH3D* hvisPix = nullptr, TH3D* hvisSC = nullptr, const UInt_t n_threads = 0) 
 {
   //--------------------------------------------------------- Source plot style 
   slide_default(); 
@@ -178,17 +201,15 @@ void test_output(const char* input_path, const char* output_path = "",
 
   //-------------------------------------------------------------- Open MC file
   printf("Opening input file...\n");
-  TFile* file = new TFile(input_path); 
+  TMCEventReader reader; 
+  reader.add_file( input_path ); 
   
   // create histograms
   printf("Building hist collection...\n");
   SLArHistoSet* h = new SLArHistoSet(); 
 
   //---------------------------------------------------- Readout the event tree
-  printf("Getting data tree...\n");
-  TTree* tree = (TTree*)file->Get("EventTree"); 
-
-  process_event_tree(tree, h, hvisPix, hvisSC); 
+  process_event_tree(reader, h, hvisPix, hvisSC, n_threads); 
   
   if ( (output_path != NULL) && (output_path[0] !=  '\0') ) {
     h->Write(output_path); 
@@ -197,31 +218,24 @@ void test_output(const char* input_path, const char* output_path = "",
 }
 
 void merge_and_plot(const char* root_file_list, const char* output_path, 
-    TH3D* hvisPix, TH3D* hvisSC) 
+    TH3D* hvisPix, TH3D* hvisSC, const UInt_t n_threads = 0) 
 {
   slide_default(); 
   gROOT->SetStyle("slide_default"); 
 
-  std::ifstream file_list; 
-  file_list.open( root_file_list ); 
-  if (!file_list.is_open()) {
+  SLArHistoSet* h = new SLArHistoSet(); 
+
+  TMCEventReader reader; 
+  try {
+    const int nfiles = reader.add_file_list( root_file_list ); 
+    printf("Added %i files to the chain\n", nfiles);
+  }
+  catch (const std::runtime_error& e) {
     printf("%s root file list is not opened. Quit.\n", root_file_list);
     return;
   }
 
-  SLArHistoSet* h = new SLArHistoSet(); 
-
-  TChain* ch = new TChain("EventTree", "G4SOLAr event tree"); 
-  std::string str; 
-  int ifile = 0; 
-  while ( std::getline(file_list, str) ) {
-    printf("Adding to %s to chain\n", str.c_str());
-    ch->AddFile(str.c_str());  
-    
-    ifile++; 
-  } 
-
-  process_event_tree(ch, h, hvisPix, hvisSC);
+  process_event_tree(reader, h, hvisPix, hvisSC, n_threads);
 
   if ( (output_path != NULL) && (output_path[0] !=  '\0') ) {
     h->Write(output_path); 
@@ -230,102 +244,101 @@ void merge_and_plot(const char* root_file_list, const char* output_path,
   return; 
 }
 
-void process_event_tree(TTree* tree, SLArHistoSet* h, TH3D* hvisPix, TH3D* hvisSC)
+void process_event(SLArMCEvent& ev, SLArHistoSet* h, TRandom3& rndm, 
+    const TH3D* hvisPix, const TH3D* hvisSC) 
 {
-  SLArMCEvent* ev = nullptr; 
-  tree->SetBranchAddress("MCEvent", &ev); 
-
-
-  int N = TMath::Min(tree->GetEntries(), (Long64_t)10000); 
-
-  for (int iev = 0; iev<N; iev++) {
-    tree->GetEntry(iev); 
-
-    if (iev%100 == 0) printf("processing ev %i\n", iev); 
-
-    auto primaries = ev->GetPrimaries(); 
-    double ev_edep = 0; 
-    double primary_pos[3] = {0};
-
-    //--------------------------------------------- Readout primaries and MC true
-    size_t ip = 0; 
-    int nphotons = 0; 
-    double Etrue = 0; 
-    for (const auto &p : primaries) {
-      int pPDGID = p->GetCode();     // Get primary PDG code 
-      int pTrkID = p->GetTrackID();  // Get primary trak id   
-      Etrue += p->GetTotalEdep(); 
-
-      nphotons += p->GetTotalScintPhotons(); 
-      auto trajectories = p->GetTrajectories(); 
-      int itrj = 0;
-      for (const auto &trj : trajectories) {
-        if (trj->GetTrackID() == pTrkID) {
-          primary_pos[0] = trj->GetPoints().front().fX; 
-          primary_pos[1] = trj->GetPoints().front().fY; 
-          primary_pos[2] = trj->GetPoints().front().fZ; 
-
-          for (int kk=0; kk<3; kk++) {
-            h->hPosition[kk]->Fill(primary_pos[kk]); 
-          }
-          h->hVtxOrigin->Fill(primary_pos[0], primary_pos[1], primary_pos[2]); 
-        }
-        /*
-         *for (const auto &tp : trj->GetPoints()) {
-         *  double pos_x = tp.fX;     // x coordinate [mm]
-         *  double pos_y = tp.fY;     // y coordinate [mm]
-         *  double pos_z = tp.fZ;     // z coordinate [mm]
-         *  double edep  = tp.fEdep;  // Energy deposited in the step [MeV]
-         *  ev_edep += edep; 
-         *}
-         */
-        itrj++;
-      } 
-      ip++;
+  auto& primaries = ev.GetPrimaries(); 
+  double ev_edep = 0; 
+  double primary_pos[3] = {0};
+
+  //--------------------------------------------- Readout primaries and MC true
+  int nphotons = 0; 
+  double Etrue = 0; 
+  for (const auto &p : primaries) {
+    Etrue += p.GetTotalEdep(); 
+    nphotons += p.GetTotalScintPhotons(); 
+
+    const auto vertex = p.GetVertex(); 
+    for (int kk=0; kk<3; kk++) {
+      primary_pos[kk] = vertex[kk]; 
+      h->hPosition[kk]->Fill(primary_pos[kk]); 
     }
-    h->hvis->Fill(ev_edep); 
-    h->hNPhotons->Fill(nphotons); 
+    h->hVtxOrigin->Fill(primary_pos[0], primary_pos[1], primary_pos[2]); 
+  }
+  h->hvis->Fill(ev_edep); 
+  h->hNPhotons->Fill(nphotons); 
 
-    //-------------------------------------------- Simulate photon propagation 
-    //-------------------------------- and detection using the visibility maps
-    double visRT = 0.; double epsRT = 1.0; 
-    double visLT = 0.; double epsLT = 1.0; 
+  //-------------------------------------------- Simulate photon propagation 
+  //-------------------------------- and detection using the visibility maps
+  double visRT = 0.; double epsRT = 1.0; 
+  double visLT = 0.; double epsLT = 1.0; 
 
-    if (hvisPix) {
-      int ibin = hvisPix->FindBin(primary_pos[0], primary_pos[1], primary_pos[2]); 
-      visRT = hvisPix->GetBinContent(ibin); 
-    }
+  if (hvisPix) {
+    int ibin = hvisPix->FindFixBin(primary_pos[0], primary_pos[1], primary_pos[2]); 
+    visRT = hvisPix->GetBinContent(ibin); 
+  }
 
-    if (hvisSC) {
-      int ibin = hvisSC->FindBin(primary_pos[0], primary_pos[1], primary_pos[2]); 
-      visLT = hvisSC->GetBinContent(ibin); 
-    }
+  if (hvisSC) {
+    int ibin = hvisSC->FindFixBin(primary_pos[0], primary_pos[1], primary_pos[2]); 
+    visLT = hvisSC->GetBinContent(ibin); 
+  }
 
-    double htotRT_expctd = nphotons*visRT*pdeSiPM;
-    double htotLT_expctd  = nphotons*visLT*pdeSC; 
+  double htotRT_expctd = nphotons*visRT*pdeSiPM;
+  double htotLT_expctd  = nphotons*visLT*pdeSC; 
 
-    for (int iRT = 1; iRT<=h->hResVsCoverage->GetNbinsX(); iRT++) {
-      for (int iLT = 1; iLT<=h->hResVsCoverage->GetNbinsY(); iLT++) {
-        epsRT = h->hResVsCoverage->GetXaxis()->GetBinCenter(iRT)*0.01; 
-        epsLT = h->hResVsCoverage->GetYaxis()->GetBinCenter(iLT)*0.01; 
+  for (int iRT = 1; iRT<=h->hResVsCoverage->GetNbinsX(); iRT++) {
+    for (int iLT = 1; iLT<=h->hResVsCoverage->GetNbinsY(); iLT++) {
+      epsRT = h->hResVsCoverage->GetXaxis()->GetBinCenter(iRT)*0.01; 
+      epsLT = h->hResVsCoverage->GetYaxis()->GetBinCenter(iLT)*0.01; 
 
-        double htotPix_ = gRandom->Poisson(htotRT_expctd*epsRT); 
-        double htotLT_  = gRandom->Poisson(htotLT_expctd*epsLT); 
-        
-        // compute reconstructed energy
-        double Eres = (htotPix_+htotLT_) / 
-          (avgLY*(visRT*pdeSiPM*epsRT + visLT*pdeSC*epsLT) ) / Etrue * 100;
-        //printf("hRT = %g, hLT = %g, Etrue = %g, epsLT = %g, epsRT = %g -> Eres = %g\n", 
-            //htotPix_, htotLT_, Etrue, epsRT, epsLT, Eres);
+      double htotPix_ = rndm.Poisson(htotRT_expctd*epsRT); 
+      double htotLT_  = rndm.Poisson(htotLT_expctd*epsLT); 
 
-        int resBin = h->hResVsCoverage->GetBin(iRT, iLT); 
-        h->hResCoverage[resBin]->Fill(100-Eres); 
+      // compute reconstructed energy
+      double Eres = (htotPix_+htotLT_) / 
+        (avgLY*(visRT*pdeSiPM*epsRT + visLT*pdeSC*epsLT) ) / Etrue * 100;
 
-        h->hEffLY[resBin]->Fill( (htotPix_ + htotLT_) / Etrue); 
-        //getchar(); 
-      }
+      int resBin = h->hResVsCoverage->GetBin(iRT, iLT); 
+      h->hResCoverage[resBin]->Fill(100-Eres); 
+
+      h->hEffLY[resBin]->Fill( (htotPix_ + htotLT_) / Etrue); 
     }
   }
+  return;
+}
+
+/**
+ * @details Events are processed in parallel through RDataFrame: every 
+ * processing slot fills its own histogram set with its own random 
+ * generator, the sets are merged at the end of the loop. 
+ */
+void process_event_tree(TMCEventReader& reader, SLArHistoSet* h, 
+    const TH3D* hvisPix, const TH3D* hvisSC, const UInt_t n_threads)
+{
+  TH1::AddDirectory(kFALSE); 
+  if (n_threads != 1) TSLArTreeReader::enable_implicit_mt(n_threads); 
+
+  auto df = reader.make_rdataframe(); 
+  const ULong64_t N = std::min(df.Count().GetValue(), static_cast<ULong64_t>(10000)); 
+
+  const UInt_t n_slots = df.GetNSlots(); 
+  std::vector<std::unique_ptr<SLArHistoSet>> h_slot; 
+  std::vector<TRandom3> rndm; 
+  for (UInt_t islot = 0; islot < n_slots; islot++) {
+    if (islot > 0) h_slot.push_back( std::make_unique<SLArHistoSet>( Form("_slot%u", islot) ) ); 
+    rndm.emplace_back( 4357 + islot ); 
+  }
+
+  std::atomic<ULong64_t> n_processed(0); 
+  df.Filter([N](const ULong64_t entry) {return entry < N;}, {"rdfentry_"})
+    .ForeachSlot([&](const unsigned int slot, SLArMCEvent& ev) {
+        SLArHistoSet* hh = (slot == 0) ? h : h_slot.at(slot-1).get(); 
+        process_event(ev, hh, rndm.at(slot), hvisPix, hvisSC); 
+        const ULong64_t iev = n_processed++; 
+        if (iev%100 == 0) printf("processing ev %llu\n", iev); 
+        }, {"MCEvent"}); 
+
+  for (const auto& hh : h_slot) h->Add( *hh ); 
 
   // Fill TH2 bins 
   for (int ix=1; ix<=h->hResVsCoverage->GetNbinsX(); ix++) {
@@ -345,19 +358,21 @@ void PrintUsage() {
   printf("\t-l(--list) input_list\n");
   printf("\t-o(--output) output_file\n");
   printf("\t-v(--visibility) visibility_file_map\n");
+  printf("\t-j(--threads) nr of processing threads (default: all available)\n");
   printf("\t-h(--help) print usage\n\n"); 
   return; 
 }
 
 int main(int argc, char *argv[])
 {
-  const char* short_opts = "i:l:o:v:h";
-  static struct option long_opts[6] = 
+  const char* short_opts = "i:l:o:v:j:h";
+  static struct option long_opts[7] = 
   {
     {"input"     , required_argument, 0, 'i'}, 
     {"list"      , required_argument, 0, 'l'}, 
     {"output"    , required_argument, 0, 'o'}, 
     {"visibility", required_argument, 0, 'v'}, 
+    {"threads"   , required_argument, 0, 'j'}, 
     {"help"      , no_argument, 0, 'h'}, 
     {nullptr, no_argument, nullptr, 0}
   };
@@ -368,6 +383,7 @@ int main(int argc, char *argv[])
   const char* input_list_ = ""; 
   const char* output_file_ = ""; 
   const char* visibility_file_ = ""; 
+  UInt_t n_threads = 0; 
 
   while ( (c = getopt_long(argc, argv, short_opts, long_opts, &option_index)) != -1) {
     switch(c) {
@@ -392,6 +408,11 @@ int main(int argc, char *argv[])
         visibility_file_ = optarg; 
         break;
       }
+      case 'j' : 
+      {
+        n_threads = std::atoi(optarg); 
+        break;
+      }
       case 'h':
       {
         PrintUsage();
@@ -417,9 +438,9 @@ int main(int argc, char *argv[])
   printf("input file: %s\n", input_file.Data()); 
   
   if (input_list.IsNull() && !input_file.IsNull()) {
-    test_output(input_file.Data(), output_file.Data(), hvisPix, hvisSC); 
+    test_output(input_file.Data(), output_file.Data(), hvisPix, hvisSC, n_threads); 
   } else if (!input_list.IsNull()) {
-    merge_and_plot(input_list.Data(), output_file.Data(), hvisPix, hvisSC); 
+    merge_and_plot(input_list.Data(), output_file.Data(), hvisPix, hvisSC, n_threads); 
   } else {
     printf("No valid input provided\n");
     PrintUsage(); 
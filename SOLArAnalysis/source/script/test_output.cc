@@ -27,6 +27,8 @@
 #include "config/SLArCfgMegaTile.hh"
 #include "config/SLArCfgSuperCellArray.hh"
 
+#include "TMCEventReader.hh"
+
 #include "solar_root_style.hpp"
 
 typedef SLArCfgBaseSystem<SLArCfgSuperCellArray> SLArPDSCfg;
@@ -233,7 +235,7 @@ void SLArHistoSet::Write(const char* output_path) {
   output->Close(); 
 }
 
-void readout_event_tree(TTree* tree, SLArHistoSet* h, TH3D* visPix, TH3D* visSC); 
+void readout_event_tree(TMCEventReader& reader, SLArHistoSet* h, TH3D* visPix, TH3D* visSC); 
 
 void test_output(const char* input_path, const char* output_path = "", 
     TH3D* hvisPix = nullptr, TH3D* hvisSC = nullptr) 
@@ -271,9 +273,10 @@ void test_output(const char* input_path, const char* output_path = "",
 
   //---------------------------------------------------- Readout the event tree
   printf("Getting data tree...\n");
-  TTree* tree = (TTree*)file->Get("EventTree"); 
+  TMCEventReader reader; 
+  reader.add_file( input_path ); 
 
-  readout_event_tree(tree, h, hvisPix, hvisSC); 
+  readout_event_tree(reader, h, hvisPix, hvisSC); 
   
   if ( (output_path != NULL) && (output_path[0] !=  '\0') ) {
     h->Write(output_path); 
@@ -298,7 +301,7 @@ void merge_and_plot(const char* root_file_list, const char* output_path,
   SLArPDSCfg* scCfg  = nullptr; 
   SLArHistoSet* h = new SLArHistoSet(); 
 
-  TChain* ch = new TChain("EventTree", "G4SOLAr event tree"); 
+  TMCEventReader reader; 
   std::string str; 
   int ifile = 0; 
   while ( std::getline(file_list, str) ) {
@@ -319,12 +322,12 @@ void merge_and_plot(const char* root_file_list, const char* output_path,
     }
 
     printf("Adding to %s to chain\n", str.c_str());
-    ch->AddFile(str.c_str());  
+    reader.add_file(str.c_str());  
     
     ifile++; 
   } 
 
-  readout_event_tree(ch, h, hvisPix, hvisSC);
+  readout_event_tree(reader, h, hvisPix, hvisSC);
 
   if ( (output_path != NULL) && (output_path[0] !=  '\0') ) {
     h->Write(output_path); 
@@ -333,18 +336,16 @@ void merge_and_plot(const char* root_file_list, const char* output_path,
   return; 
 }
 
-void readout_event_tree(TTree* tree, SLArHistoSet* h, TH3D* hvisPix, TH3D* hvisSC)
+void readout_event_tree(TMCEventReader& reader, SLArHistoSet* h, TH3D* hvisPix, TH3D* hvisSC)
 {
-  SLArMCEvent* ev = nullptr; 
-  tree->SetBranchAddress("MCEvent", &ev); 
-
   double tmax = 0; 
   double hmax = 0; 
 
-  for (int iev = 0; iev<tree->GetEntries(); iev++) {
-    tree->GetEntry(iev); 
+  const Long64_t n_entries = reader.get_entries(); 
+  while ( reader.next() ) {
+    SLArMCEvent* ev = reader.get_event(); 
 
-    auto primaries = ev->GetPrimaries(); 
+    auto& primaries = ev->GetPrimaries(); 
     double ev_edep = 0; 
     double primary_pos[3] = {0};
 
@@ -352,17 +353,17 @@ void readout_event_tree(TTree* tree, SLArHistoSet* h, TH3D* hvisPix, TH3D* hvisS
     size_t ip = 0; 
     int nphotons = 0; 
     for (const auto &p : primaries) {
-      int pPDGID = p->GetCode();     // Get primary PDG code 
-      int pTrkID = p->GetTrackID();  // Get primary trak id   
+      int pPDGID = p.GetCode();     // Get primary PDG code 
+      int pTrkID = p.GetTrackID();  // Get primary trak id   
 
-      nphotons += p->GetTotalScintPhotons(); 
-      auto trajectories = p->GetTrajectories(); 
+      nphotons += p.GetTotalScintPhotons(); 
+      const auto& trajectories = p.GetConstTrajectories(); 
       int itrj = 0;
       for (const auto &trj : trajectories) {
         if (trj->GetTrackID() == pTrkID) {
-          primary_pos[0] = trj->GetPoints().front().fX; 
-          primary_pos[1] = trj->GetPoints().front().fY; 
-          primary_pos[2] = trj->GetPoints().front().fZ; 
+          primary_pos[0] = trj->GetConstPoints().front().fX; 
+          primary_pos[1] = trj->GetConstPoints().front().fY; 
+          primary_pos[2] = trj->GetConstPoints().front().fZ; 
 
           for (int kk=0; kk<3; kk++) {
             h->hPosition[kk]->Fill(primary_pos[kk]); 
@@ -406,7 +407,7 @@ void readout_event_tree(TTree* tree, SLArHistoSet* h, TH3D* hvisPix, TH3D* hvisS
           htotPix += nhits; 
 
           for (const auto &hit : evTile->GetHits()) {
-            h->hPixTHits->Fill( hit->GetTime(), 1./tree->GetEntries() ); 
+            h->hPixTHits->Fill( hit->GetTime(), 1./n_entries ); 
             h->hWavelength->Fill( hit->GetWavelength()); 
           }
         }
@@ -502,7 +503,7 @@ void readout_event_tree(TTree* tree, SLArHistoSet* h, TH3D* hvisPix, TH3D* hvisS
   int imap = 0; 
   h2frame->DrawClone("axis"); 
   for (const auto &hmap : h->hPixNPhMap) {
-    hmap.second->Scale(1./tree->GetEntries()); 
+    hmap.second->Scale(1./n_entries); 
     if (hmax < hmap.second->GetMaximum()) 
       hmax = hmap.second->GetMaximum(); 
   }
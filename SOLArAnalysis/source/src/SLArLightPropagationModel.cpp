@@ -4,12 +4,19 @@
 #include <iostream>
 #include <fstream>
 #include <cmath>
+#include <algorithm>
+#include <array>
 
 #include "TRandom.h"
 #include "TSystem.h"
+#include "TFile.h"
+#include "TTree.h"
 #include "TMath.h"
 #include "TFormula.h"
 #include "Math/SpecFuncMathMore.h"
+#include "Math/ProbFuncMathCore.h"
+#include "Math/PdfFuncMathCore.h"
+#include "Math/QuantFuncMathCore.h"
 
 #include "G4UIcommand.hh"
 
@@ -219,6 +226,189 @@ namespace slarAna {
     return vis_vuv;
   }
 
+  /**
+   * @details The arrival time parameters depend only on the distance between
+   * the scintillation point and the center of the optical detector: the
+   * Landau location is the direct-path time plus a delay, while the width,
+   * the weight and the decay time of the diffuse light tail are
+   * interpolated from the tables loaded with LoadArrivalTimeTables.
+   */
+  ArrivalTimePars_t SLArLightPropagationModel::ArrivalTimeOpDetTile(
+      SLArCfgBaseModule* cfgTile, 
+      const TVector3 &ScintPoint) 
+  {
+    TVector3 OpDetPoint(
+        cfgTile->GetPhysX()/G4UIcommand::ValueOf("cm"), 
+        cfgTile->GetPhysY()/G4UIcommand::ValueOf("cm"), 
+        cfgTile->GetPhysZ()/G4UIcommand::ValueOf("cm"));
+    double distance = (ScintPoint - OpDetPoint).Mag();
+    return ArrivalTimeAtDistance(distance); 
+  }
+
+  ArrivalTimePars_t SLArLightPropagationModel::ArrivalTimeAtDistance(const double distance) 
+  {
+    if (fTimingDistance.empty()) {
+      throw(std::runtime_error("SLArLightPropagationModel::ArrivalTimeAtDistance: arrival time tables not loaded"));
+    }
+
+    ArrivalTimePars_t pars; 
+    pars.fT0 = DirectPathTime(distance); 
+    pars.fLandauMPV = pars.fT0 + 
+      std::max(interpolate(fTimingDistance, fTimingLandauDelay, distance, true), 0.); 
+    pars.fLandauWidth = 
+      std::max(interpolate(fTimingDistance, fTimingLandauWidth, distance, true), 0.01); 
+    pars.fExpFraction = 
+      interpolate(fTimingDistance, fTimingExpFraction, distance, false); 
+    pars.fExpTau = 
+      std::max(interpolate(fTimingDistance, fTimingExpTau, distance, true), 0.1); 
+
+    return pars; 
+  }
+
+  // arrival time of the direct light at the given distance [cm]
+  double SLArLightPropagationModel::DirectPathTime(const double distance) 
+  {
+    return distance / vuv_vgroup_mean; 
+  }
+
+  /**
+   * @details Read the arrival time tables fitted by build_vis_map to the 
+   * hit times of a full optical tracking run. The tree holds one entry per 
+   * distance bin with the branches distance [cm], landau_delay [ns], 
+   * landau_width [ns], exp_fraction and exp_tau [ns].
+   */
+  void SLArLightPropagationModel::LoadArrivalTimeTables(
+      const char* file_path, const char* tree_name) 
+  {
+    char err_msg[200]; 
+    TFile* file = TFile::Open(file_path); 
+    if (file == nullptr || file->IsZombie()) {
+      sprintf(err_msg, "SLArLightPropagationModel::LoadArrivalTimeTables: unable to open %s\n", 
+          file_path); 
+      throw std::runtime_error(err_msg); 
+    }
+    TTree* tree = file->Get<TTree>(tree_name); 
+    if (tree == nullptr || tree->GetEntries() < 2) {
+      sprintf(err_msg, "SLArLightPropagationModel::LoadArrivalTimeTables: no %s table with at least two entries in %s\n", 
+          tree_name, file_path); 
+      file->Close(); 
+      throw std::runtime_error(err_msg); 
+    }
+
+    double distance = 0., delay = 0., width = 0., fraction = 0., tau = 0.; 
+    tree->SetBranchAddress("distance", &distance); 
+    tree->SetBranchAddress("landau_delay", &delay); 
+    tree->SetBranchAddress("landau_width", &width); 
+    tree->SetBranchAddress("exp_fraction", &fraction); 
+    tree->SetBranchAddress("exp_tau", &tau); 
+
+    std::vector<std::array<double, 5>> rows; 
+    for (Long64_t i = 0; i < tree->GetEntries(); i++) {
+      tree->GetEntry(i); 
+      rows.push_back( {distance, delay, width, fraction, tau} ); 
+    }
+    file->Close(); 
+    delete file; 
+
+    // interpolate() needs the distances in increasing order
+    std::sort(rows.begin(), rows.end()); 
+    fTimingDistance.clear(); 
+    fTimingLandauDelay.clear(); 
+    fTimingLandauWidth.clear(); 
+    fTimingExpFraction.clear(); 
+    fTimingExpTau.clear(); 
+    for (const auto& row : rows) {
+      fTimingDistance.push_back( row[0] ); 
+      fTimingLandauDelay.push_back( row[1] ); 
+      fTimingLandauWidth.push_back( row[2] ); 
+      fTimingExpFraction.push_back( row[3] ); 
+      fTimingExpTau.push_back( row[4] ); 
+    }
+
+    printf("SLArLightPropagationModel: %lu arrival time table entries loaded from %s\n", 
+        fTimingDistance.size(), file_path); 
+    return;
+  }
+
+  // probability density of the arrival time, normalised to one
+  double SLArLightPropagationModel::ArrivalTimePDF(
+      const double t, const ArrivalTimePars_t& pars) 
+  {
+    if (t < pars.fT0) return 0.; 
+    const double l0 = ROOT::Math::landau_cdf(pars.fT0, pars.fLandauWidth, pars.fLandauMPV); 
+    const double pdf_landau = (l0 < 1.) ? 
+      ROOT::Math::landau_pdf(t, pars.fLandauWidth, pars.fLandauMPV) / (1. - l0) : 0.; 
+    const double pdf_exp = exp( -(t - pars.fT0) / pars.fExpTau ) / pars.fExpTau; 
+
+    return (1. - pars.fExpFraction)*pdf_landau + pars.fExpFraction*pdf_exp; 
+  }
+
+  // cumulative distribution of the arrival time. The Landau component 
+  // is truncated below the direct-path time
+  double SLArLightPropagationModel::ArrivalTimeCDF(
+      const double t, const ArrivalTimePars_t& pars) 
+  {
+    if (t <= pars.fT0) return 0.; 
+    const double l0 = ROOT::Math::landau_cdf(pars.fT0, pars.fLandauWidth, pars.fLandauMPV); 
+    const double l  = ROOT::Math::landau_cdf(t, pars.fLandauWidth, pars.fLandauMPV); 
+    const double cdf_landau = (l0 < 1.) ? (l - l0) / (1. - l0) : 1.; 
+    const double cdf_exp = 1. - exp( -(t - pars.fT0) / pars.fExpTau ); 
+
+    return (1. - pars.fExpFraction)*cdf_landau + pars.fExpFraction*cdf_exp; 
+  }
+
+  double SLArLightPropagationModel::SampleArrivalTime(
+      const ArrivalTimePars_t& pars, TRandom* rndm) 
+  {
+    if (rndm->Rndm() < pars.fExpFraction) {
+      return pars.fT0 + rndm->Exp(pars.fExpTau); 
+    }
+
+    // sample the truncated Landau by inverting its cumulative
+    const double l0 = ROOT::Math::landau_cdf(pars.fT0, pars.fLandauWidth, pars.fLandauMPV); 
+    const double u  = std::min(l0 + rndm->Rndm()*(1. - l0), 1. - 1e-12); 
+    return pars.fLandauMPV + ROOT::Math::landau_quantile(u, pars.fLandauWidth); 
+  }
+
+  /**
+   * @details Compute the arrival times corresponding to n_quantiles evenly 
+   * spaced values of the cumulative distribution, from 0 (the direct-path 
+   * time) to 0.999, so that the distribution can be stored as a compact 
+   * table and sampled by linear interpolation. The cumulative is inverted 
+   * by bisection.
+   */
+  void SLArLightPropagationModel::ArrivalTimeQuantiles(
+      const ArrivalTimePars_t& pars, 
+      const int n_quantiles, 
+      std::vector<double>& quantiles) 
+  {
+    const double p_max = 0.999; 
+    quantiles.resize(n_quantiles); 
+    if (n_quantiles < 2) {
+      quantiles.assign(n_quantiles, pars.fT0); 
+      return;
+    }
+
+    double t_max = pars.fLandauMPV + 20*pars.fLandauWidth + 10*pars.fExpTau; 
+    while (ArrivalTimeCDF(t_max, pars) < p_max) t_max *= 2;
+
+    quantiles[0] = pars.fT0; 
+    double t_low = pars.fT0; 
+    for (int k = 1; k < n_quantiles; k++) {
+      const double p = p_max * k / (n_quantiles - 1.); 
+      double lo = t_low, hi = t_max; 
+      for (int iter = 0; iter < 60; iter++) {
+        const double mid = 0.5*(lo + hi); 
+        if (ArrivalTimeCDF(mid, pars) < p) lo = mid; 
+        else hi = mid; 
+      }
+      quantiles[k] = 0.5*(lo + hi); 
+      t_low = quantiles[k]; 
+    }
+
+    return;
+  }
+
   // gaisser-hillas function definition
   Double_t SLArLightPropagationModel::GaisserHillas(double x,double *par) {
     //This is the Gaisser-Hillas function
@@ -0,0 +1,131 @@
+/**
+ * @author      : Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        : SLArPhotonTimingLibrary.cpp
+ * @created     : Wednesday Oct 21, 2026 10:41:02 CEST
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+
+#include "SLArPhotonTimingLibrary.hh"
+
+ClassImp(slarAna::SLArPhotonTimingLibrary)
+
+namespace slarAna {
+
+  SLArPhotonTimingLibrary::SLArPhotonTimingLibrary()
+    : TNamed(), fNx(0), fNy(0), fNz(0), fMin{0, 0, 0}, fMax{0, 0, 0},
+      fNQuantiles(0), fTimeStep(0.1)
+  {}
+
+  SLArPhotonTimingLibrary::SLArPhotonTimingLibrary(const char* name, const char* title,
+      const int nx, const double xmin, const double xmax,
+      const int ny, const double ymin, const double ymax,
+      const int nz, const double zmin, const double zmax,
+      const int n_quantiles, const double time_step)
+    : TNamed(name, title), fNx(nx), fNy(ny), fNz(nz),
+      fMin{xmin, ymin, zmin}, fMax{xmax, ymax, zmax},
+      fNQuantiles(n_quantiles), fTimeStep(time_step)
+  {
+    if (fNQuantiles < 2) {
+      char err_msg[200];
+      sprintf(err_msg, "SLArPhotonTimingLibrary: at least 2 quantiles are needed (%i given)\n",
+          fNQuantiles);
+      throw std::invalid_argument(err_msg);
+    }
+  }
+
+  int SLArPhotonTimingLibrary::FindVoxel(
+      const double x, const double y, const double z) const
+  {
+    const double pos[3] = {x, y, z};
+    const int nbins[3] = {fNx, fNy, fNz};
+    int ibin[3] = {0, 0, 0};
+    for (int j = 0; j < 3; j++) {
+      if (pos[j] < fMin[j] || pos[j] >= fMax[j]) return -1;
+      ibin[j] = static_cast<int>( nbins[j] * (pos[j] - fMin[j]) / (fMax[j] - fMin[j]) );
+    }
+    return (ibin[0]*fNy + ibin[1])*fNz + ibin[2];
+  }
+
+  void SLArPhotonTimingLibrary::GetVoxelCenter(
+      const int voxel, double& x, double& y, double& z) const
+  {
+    const int iz = voxel % fNz;
+    const int iy = (voxel / fNz) % fNy;
+    const int ix = voxel / (fNz*fNy);
+    x = fMin[0] + (ix + 0.5)*(fMax[0] - fMin[0]) / fNx;
+    y = fMin[1] + (iy + 0.5)*(fMax[1] - fMin[1]) / fNy;
+    z = fMin[2] + (iz + 0.5)*(fMax[2] - fMin[2]) / fNz;
+    return;
+  }
+
+  /**
+   * @details The quantiles are those computed by
+   * SLArLightPropagationModel::ArrivalTimeQuantiles: the first one is the
+   * direct-path time, the others are stored as offsets from it, rounded
+   * to the time step and saturated to the 16-bit range.
+   */
+  void SLArPhotonTimingLibrary::AddEntry(const int voxel, const int channel,
+      const float visibility, const std::vector<double>& quantiles)
+  {
+    if (voxel < 0 || voxel >= GetNVoxels() ||
+        voxel < static_cast<int>(fVoxelOffset.size()) - 1) {
+      char err_msg[200];
+      sprintf(err_msg, "SLArPhotonTimingLibrary::AddEntry: invalid voxel %i (entries must be added in voxel order)\n", voxel);
+      throw std::invalid_argument(err_msg);
+    }
+    if (static_cast<int>(quantiles.size()) != fNQuantiles) {
+      char err_msg[200];
+      sprintf(err_msg, "SLArPhotonTimingLibrary::AddEntry: %lu quantiles given, %i expected\n",
+          quantiles.size(), fNQuantiles);
+      throw std::invalid_argument(err_msg);
+    }
+
+    while (static_cast<int>(fVoxelOffset.size()) <= voxel) {
+      fVoxelOffset.push_back( fChannel.size() );
+    }
+
+    fChannel.push_back( channel );
+    fVisibility.push_back( visibility );
+    fT0.push_back( quantiles[0] );
+    for (int k = 1; k < fNQuantiles; k++) {
+      const double dt = std::round( (quantiles[k] - quantiles[0]) / fTimeStep );
+      fQuantile.push_back( static_cast<UShort_t>( std::min(std::max(dt, 0.), 65535.) ) );
+    }
+    return;
+  }
+
+  void SLArPhotonTimingLibrary::GetVoxelEntries(
+      const int voxel, size_t& first, size_t& last) const
+  {
+    const size_t n_closed = fVoxelOffset.size();
+    first = (voxel >= 0 && static_cast<size_t>(voxel) < n_closed) ?
+      fVoxelOffset[voxel] : fChannel.size();
+    last  = (voxel >= 0 && static_cast<size_t>(voxel) + 1 < n_closed) ?
+      fVoxelOffset[voxel+1] : fChannel.size();
+    if (voxel < 0) last = first;
+    return;
+  }
+
+  double SLArPhotonTimingLibrary::GetEntryQuantileTime(
+      const size_t entry, const int k) const
+  {
+    if (k <= 0) return fT0[entry];
+    return fT0[entry] + fTimeStep*fQuantile[entry*(fNQuantiles-1) + k - 1];
+  }
+
+  double SLArPhotonTimingLibrary::SampleArrivalTime(
+      const size_t entry, TRandom* rndm) const
+  {
+    const UShort_t* q = &fQuantile[entry*(fNQuantiles-1)];
+    const double u = rndm->Rndm() * (fNQuantiles - 1);
+    const int k = std::min(static_cast<int>(u), fNQuantiles - 2);
+    const double q_low = (k == 0) ? 0. : q[k-1];
+    const double q_high = q[k];
+    return fT0[entry] + fTimeStep*(q_low + (u - k)*(q_high - q_low));
+  }
+}
+
@@ -28,6 +28,8 @@
 
 #include <SLArRecoHits.hpp>
 
+class THitTreeReader;
+
 namespace display {
 
   struct GeoTPC_t {
@@ -55,9 +57,7 @@ class SLArEveDisplay : public TGMainFrame {
 
 
   private: 
-    TFile* fHitFile = {};
-    TTree* fHitTree = {}; 
-    hitvarContainersPtr_t fHitVars = {};
+    THitTreeReader* fHitReader = {}; //!
     std::unique_ptr<TTimer> fTimer = {};
     std::unique_ptr<TEveManager> fEveManager = {};
     std::vector<std::unique_ptr<TEveBoxSet>> fHitSet = {};
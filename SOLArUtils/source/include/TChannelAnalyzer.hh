@@ -8,19 +8,27 @@
 
 #define TCHANNELANALYZER_HH
 
+#include <cmath>
+#include <vector>
 #include <event/SLArEventChargePixel.hh>
+#include <event/SLArPixelFrontEnd.hh>
 #include <config/SLArCfgAnode.hh>
 #include <SLArRecoHits.hpp>
+#include <TPixelGeometryTable.hh>
 
 class TChannelAnalyzer {
   public: 
     TChannelAnalyzer() {}
     virtual ~TChannelAnalyzer() {}
 
-    inline void set_integration_window(const Float_t win) {fIntegrationWindow = win;}
+    inline void set_integration_window(const Float_t win) {
+      fIntegrationWindow = win;
+      if (fClockUnit > 0) update_hold_ticks(); 
+    }
+    inline void set_hit_threshold(const Float_t thr) {fFrontEnd.GetConfig().fThreshold = thr;}
     inline void set_drift_velocity(const Float_t v) {fDriftVelocity = v;}
     inline void set_drift_direction(const TVector3& v) {fDriftDirection = &v;}
-    inline void set_channel_rms(const Float_t rms) {fChannelPedestalRMS = rms;}
+    inline void set_channel_rms(const Float_t rms) {fFrontEnd.GetConfig().fNoiseRMS = rms;}
     inline void set_anode_config(SLArCfgAnode* anode_cfg) {
       fCfgAnode = anode_cfg;
       fRot.SetXEulerAngles( anode_cfg->GetPhi(), anode_cfg->GetTheta(), anode_cfg->GetPsi() );      
@@ -28,23 +36,33 @@ class TChannelAnalyzer {
     inline void set_megatile_config(const SLArCfgMegaTile* mt_cfg) {fCfgMegaTile = mt_cfg;}
     inline void set_tile_config(const SLArCfgReadoutTile* tile_cfg) {fCfgTile = tile_cfg;}
     inline void set_tpc_id(const Int_t itpc) {fTPCID = itpc;} 
+    inline void set_geometry_table(const TPixelGeometryTable* table) {fGeoTable = table;}
+    inline void set_tile_index(const Int_t mt_idx, const Int_t tile_idx) {fMegaTileIdx = mt_idx; fTileIdx = tile_idx;}
+    inline void set_seed(const ULong_t seed) {fFrontEnd.SetSeed(seed);}
+    inline SLArPixelFrontEnd& get_front_end() {return fFrontEnd;}
 
     int process_channel(const Int_t& pix_bin, const SLArEventChargePixel& pix_ev, hitvarContainers_t& hitvars); 
 
   private: 
-    Float_t fIntegrationWindow = {}; 
-    Float_t fHitThreshold = {};
-    Float_t fChannelPedestalRMS = {};
+    Float_t fIntegrationWindow = 1.0; 
     Float_t fDriftVelocity = {};
     UInt_t fClockUnit = 0;
     Int_t fTPCID = 0;
+    Int_t fMegaTileIdx = 0;
+    Int_t fTileIdx = 0;
     TRotation fRot = {};
     const SLArCfgReadoutTile* fCfgTile = {}; 
     SLArCfgAnode* fCfgAnode = {};
     const SLArCfgMegaTile* fCfgMegaTile = {};
     const TVector3* fDriftDirection = {};
+    const TPixelGeometryTable* fGeoTable = {};
+    SLArPixelFrontEnd fFrontEnd = {}; 
+    std::vector<SLArPixelPacket_t> fPackets = {}; 
 
-    int record_hit(const Int_t& pix_bin, const UInt_t& q, const UInt_t& trigger_t, hitvarContainers_t& hitvars);
+    inline void update_hold_ticks() {
+      fFrontEnd.GetConfig().fHoldTicks = std::round(fIntegrationWindow * 1000 / fClockUnit);
+    }
+    int record_hit(const Int_t& pix_bin, const UInt_t& q_true, const Float_t& q_reco, const UInt_t& trigger_t, hitvarContainers_t& hitvars);
     TVector3 get_bin_center(TH2PolyBin* bin, const TVector3& axis_x, const TVector3& axis_y);
 };
 
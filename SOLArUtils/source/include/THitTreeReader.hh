@@ -0,0 +1,50 @@
+/**
+ * @author      : Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        : THitTreeReader.hh
+ * @created     : Monday Oct 19, 2026 17:38:55 CEST
+ */
+
+#ifndef THITTREEREADER_HH
+
+#define THITTREEREADER_HH
+
+#include <TSLArTreeReader.hh>
+#include <TTreeReaderValue.h>
+
+/**
+ * @brief Reader of the reconstructed hit tree written by hit_converter
+ *
+ * Each hit variable is exposed as a TColumnView on the branch buffer of the
+ * current entry.
+ */
+class THitTreeReader : public TSLArTreeReader {
+  public:
+    THitTreeReader(const TString tree_key = "HitTree");
+    ~THitTreeReader() {}
+
+    inline UInt_t get_event_number() {return *fIev;}
+    inline size_t get_n_hits() {return fHitQ->GetSize();}
+    inline TColumnView<Float_t> hit_x() {return TColumnView<Float_t>::from_reader(*fHitX);}
+    inline TColumnView<Float_t> hit_y() {return TColumnView<Float_t>::from_reader(*fHitY);}
+    inline TColumnView<Float_t> hit_z() {return TColumnView<Float_t>::from_reader(*fHitZ);}
+    inline TColumnView<Float_t> hit_q() {return TColumnView<Float_t>::from_reader(*fHitQ);}
+    inline TColumnView<Float_t> hit_qtrue() {return TColumnView<Float_t>::from_reader(*fHitQTrue);}
+    inline TColumnView<Int_t>   hit_tpc() {return TColumnView<Int_t>::from_reader(*fHitTPC);}
+
+    ROOT::RDF::RNode make_dataframe() const;
+
+  protected:
+    void book_columns(TTreeReader& reader) override;
+
+  private:
+    std::unique_ptr<TTreeReaderValue<UInt_t>> fIev;
+    std::unique_ptr<TTreeReaderArray<Float_t>> fHitX;
+    std::unique_ptr<TTreeReaderArray<Float_t>> fHitY;
+    std::unique_ptr<TTreeReaderArray<Float_t>> fHitZ;
+    std::unique_ptr<TTreeReaderArray<Float_t>> fHitQ;
+    std::unique_ptr<TTreeReaderArray<Float_t>> fHitQTrue;
+    std::unique_ptr<TTreeReaderArray<Int_t>> fHitTPC;
+};
+
+#endif /* end of include guard THITTREEREADER_HH */
+
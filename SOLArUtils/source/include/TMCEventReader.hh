@@ -0,0 +1,48 @@
+/**
+ * @author      : Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        : TMCEventReader.hh
+ * @created     : Monday Oct 19, 2026 18:04:33 CEST
+ */
+
+#ifndef TMCEVENTREADER_HH
+
+#define TMCEVENTREADER_HH
+
+#include <TSLArTreeReader.hh>
+#include <TTreeReaderValue.h>
+#include <event/SLArMCEvent.hh>
+
+/**
+ * @brief Reader of the simulated event tree written by solar_sim
+ *
+ * The `MCEvent` branch is split, so whole parts of the event model 
+ * (trajectories, charge and light readout) can be switched off and are 
+ * then neither read from disk nor deserialized.
+ */
+class TMCEventReader : public TSLArTreeReader {
+  public:
+    TMCEventReader(const TString tree_key = "EventTree", const TString branch_key = "MCEvent");
+    ~TMCEventReader() {}
+
+    void read_trajectories(const bool do_read); 
+    void read_anodes(const bool do_read); 
+    void read_supercells(const bool do_read); 
+
+    inline SLArMCEvent* get_event() {return fEvent->Get();}
+
+    ROOT::RDF::RNode make_dataframe() const;
+
+  protected:
+    void book_columns(TTreeReader& reader) override;
+    void on_entry_loaded() override;
+
+  private:
+    TString fBranchKey; 
+    std::vector<TString> fDisabledBranches; 
+    std::unique_ptr<TTreeReaderValue<SLArMCEvent>> fEvent;
+
+    void set_branch_read(const TString pattern, const bool do_read); 
+};
+
+#endif /* end of include guard TMCEVENTREADER_HH */
+
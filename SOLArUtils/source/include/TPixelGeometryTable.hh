@@ -0,0 +1,56 @@
+/**
+ * @author      : Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        : TPixelGeometryTable.hh
+ * @created     : Monday Oct 19, 2026 10:12:31 CEST
+ */
+
+#ifndef TPIXELGEOMETRYTABLE_HH
+
+#define TPIXELGEOMETRYTABLE_HH
+
+#include <map>
+#include <vector>
+#include <TVector3.h>
+#include <config/SLArCfgAnode.hh>
+
+/**
+ * @brief Flat lookup table of the pixel pad centers
+ *
+ * The (tpc, megatile, tile, pixel) -> pad center mapping is computed once
+ * per anode configuration, so that the hit reconstruction does not need
+ * to walk the TH2Poly bins and rebuild the tile transformations for every
+ * recorded hit. Once filled the table is read-only and can be shared
+ * among worker threads.
+ */
+class TPixelGeometryTable {
+  public:
+    struct PadCenter_t {
+      Float_t x {};
+      Float_t y {};
+      Float_t z {};
+    };
+
+    TPixelGeometryTable() {}
+    virtual ~TPixelGeometryTable() {}
+
+    int add_anode(const Int_t tpc_id, SLArCfgAnode* anode_cfg);
+    const PadCenter_t* get_pad_center(const Int_t tpc_id, const Int_t mt_idx,
+        const Int_t tile_idx, const Int_t pix_bin) const;
+    const TVector3& get_drift_direction(const Int_t tpc_id) const;
+    inline bool has_anode(const Int_t tpc_id) const {return fAnodes.count(tpc_id);}
+
+  private:
+    struct AnodeTable_t {
+      TVector3 drift_direction = {};
+      UInt_t n_pixels = 0;
+      std::vector<UInt_t> tile_offset = {}; //!< first tile of each megatile
+      std::vector<UInt_t> n_tiles = {}; //!< number of tiles in each megatile
+      std::vector<PadCenter_t> pads = {};
+    };
+
+    std::map<Int_t, AnodeTable_t> fAnodes;
+};
+
+
+#endif /* end of include guard TPIXELGEOMETRYTABLE_HH */
+
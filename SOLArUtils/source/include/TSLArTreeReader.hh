@@ -0,0 +1,106 @@
+/**
+ * @author      : Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        : TSLArTreeReader.hh
+ * @created     : Monday Oct 19, 2026 17:05:12 CEST
+ */
+
+#ifndef TSLARTREEREADER_HH
+
+#define TSLARTREEREADER_HH
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <TString.h>
+#include <TChain.h>
+#include <TTreeReader.h>
+#include <TTreeReaderArray.h>
+#include <ROOT/RDataFrame.hxx>
+
+/**
+ * @brief Read-only view over a contiguous column of the current entry
+ *
+ * The view points directly into the buffer filled by the branch, no copy
+ * is made. It is valid until the next entry is loaded.
+ */
+template<typename T>
+class TColumnView {
+  public:
+    TColumnView() {}
+    TColumnView(const T* data, const size_t size) : fData(data), fSize(size) {}
+
+    inline const T* data() const {return fData;}
+    inline size_t size() const {return fSize;}
+    inline bool empty() const {return fSize == 0;}
+    inline const T* begin() const {return fData;}
+    inline const T* end() const {return fData + fSize;}
+    inline const T& operator[](const size_t i) const {return fData[i];}
+
+    static TColumnView<T> from_reader(TTreeReaderArray<T>& column) {
+      const size_t n = column.GetSize();
+      return (n > 0) ? TColumnView<T>(&column.At(0), n) : TColumnView<T>();
+    }
+
+  private:
+    const T* fData = nullptr;
+    size_t fSize = 0;
+};
+
+/**
+ * @brief Common backend of the G4SOLAr output readers
+ *
+ * Wraps a TChain and a TTreeReader: only the branches booked by the derived
+ * reader are deserialized, the TTreeCache is sized and primed once with
+ * those branches, and entries can be loaded both sequentially and at random
+ * (e.g. when jumping to a given event in the display).
+ * The same set of files can be handed over to RDataFrame for event-parallel
+ * processing with implicit multithreading.
+ */
+class TSLArTreeReader {
+  public:
+    TSLArTreeReader(const TString tree_key);
+    virtual ~TSLArTreeReader();
+
+    int add_file(const TString file_path);
+    int add_file_list(const TString list_path);
+
+    void set_cache_size(const Long64_t cache_size);
+    inline void set_cache_learn_entries(const Int_t n) {fCacheLearnEntries = n;}
+    void set_entry_range(const Long64_t first, const Long64_t last);
+
+    Long64_t get_entries();
+    inline Long64_t get_current_entry() const {return fCurrentEntry;}
+    bool load_entry(const Long64_t entry);
+    bool next();
+
+    inline TChain* get_chain() {return &fChain;}
+    inline const TString& get_tree_key() const {return fTreeKey;}
+    inline const std::vector<std::string>& get_file_names() const {return fFileNames;}
+
+    ROOT::RDataFrame make_rdataframe() const;
+
+    static void enable_implicit_mt(const UInt_t n_threads = 0);
+
+  protected:
+    TString fTreeKey;
+    TChain fChain;
+    std::unique_ptr<TTreeReader> fReader;
+    std::vector<std::string> fFileNames;
+    std::vector<TString> fCachedBranches; //!< branches primed in the TTreeCache
+    Long64_t fCacheSize;
+    Int_t fCacheLearnEntries;
+    Long64_t fFirstEntry;
+    Long64_t fLastEntry;
+    Long64_t fCurrentEntry;
+
+    //! Book the reader columns on the freshly created TTreeReader
+    virtual void book_columns(TTreeReader& reader) = 0;
+    //! Hook called after a new entry has been loaded
+    virtual void on_entry_loaded() {}
+
+  private:
+    void init();
+};
+
+#endif /* end of include guard TSLARTREEREADER_HH */
+
@@ -5,9 +5,13 @@
  */
 
 // std
+#include <algorithm>
 #include <cstdio>
 #include <getopt.h>
 #include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
 
 // config
 #include <config/SLArCfgAnode.hh>
@@ -23,9 +27,11 @@
 
 // hits
 #include <TChannelAnalyzer.hh>
+#include <TPixelGeometryTable.hh>
 #include <SLArRecoHits.hpp>
 
 // root
+#include <TROOT.h>
 #include <TFile.h>
 #include <TTree.h>
 #include <TH2Poly.h>
@@ -41,23 +47,94 @@ void print_usage() {
   printf("\t[--output    | -o] output_hit_file\n"); 
   printf("\t[--noise     | -n] optional - noise rms in Vee (default = 900)\n"); 
   printf("\t[--threshold | -t] optional - hit threshold (default 1500 Vee)\n"); 
-  printf("\t[--window    | -w] optional - charge integration window in μs (default 1)\n\n");
+  printf("\t[--window    | -w] optional - charge integration window in μs (default 1)\n");
+  printf("\t[--threads   | -j] optional - number of worker threads (default = hardware concurrency)\n");
+  printf("\t[--seed      | -s] optional - noise generator seed (default 4357)\n");
+  printf("\t[--frontend  | -f] optional - front-end emulator parameter as name=value (repeatable)\n\n");
 
   exit( EXIT_SUCCESS );
 }
 
+/**
+ * Per-entry conversion output, buffered until it can be written in order
+ */
+struct ConvertedEvent_t {
+  UInt_t iev = 0; 
+  hitvarContainers_t hitvars; 
+};
+
+/**
+ * Worker thread state: each worker reads the input file through its own 
+ * TFile/TTree and owns its channel analyzer (and thus its noise generator)
+ */
+struct ConverterWorker_t {
+  TFile* input_file = nullptr; 
+  TTree* mc_tree = nullptr; 
+  SLArMCEvent* mc_ev = nullptr; 
+  TChannelAnalyzer ch_analyzer; 
+};
+
+/**
+ * Convert a single Monte Carlo entry into a collection of hits. 
+ * The noise generator is reseeded on each entry so that the output does not 
+ * depend on the number of threads. 
+ */
+void convert_entry(ConverterWorker_t& worker, const Long64_t entry, 
+    const TPixelGeometryTable& geo_table, const ULong_t seed, ConvertedEvent_t& out) 
+{
+  out.hitvars.reset(); 
+
+  worker.mc_tree->GetEntry( entry ); 
+  out.iev = worker.mc_ev->GetEvNumber(); 
+
+  auto& ch_analyzer = worker.ch_analyzer; 
+  ch_analyzer.set_seed( seed + entry + 1 ); 
+
+  const auto& anodes_map = worker.mc_ev->GetEventAnode(); 
+  for (const auto& anode_itr : anodes_map) {
+    const Int_t itpc = anode_itr.first;
+    if (geo_table.has_anode(itpc) == false) continue;
+
+    const SLArEventAnode& anode = anode_itr.second;
+    ch_analyzer.set_drift_direction( geo_table.get_drift_direction(itpc) ); 
+    ch_analyzer.set_tpc_id( itpc ); 
+
+    const auto& mt_map = anode.GetConstMegaTilesMap();
+    for (const auto& mt_itr : mt_map) {
+      const auto& mt = mt_itr.second;
+      if (mt.GetNChargeHits() == 0) continue;
+
+      const auto& t_map = mt.GetConstTileMap(); 
+      for (const auto &t_itr : t_map) {
+        const auto& t = t_itr.second;
+        if (t.GetPixelHits() == 0) continue;
+        ch_analyzer.set_tile_index( mt_itr.first, t_itr.first ); 
+        const auto& pixels = t.GetConstPixelEvents();
+        for (const auto& pixel_itr : pixels) {
+          ch_analyzer.process_channel(pixel_itr.first, pixel_itr.second, out.hitvars ); 
+        } // end of loop over pixels
+      } // end of loop over tiles
+    } // end of loop over megatiles
+  } // end of loop over anodes
+
+  return;
+}
+
 /**
  * Convert solar simulation event into a collection of hits
  */
 int main (int argc, char *argv[]) {
-   const char* short_opts = "i:o:n:t:w:h";
-   static struct option long_opts[7] = 
+   const char* short_opts = "i:o:n:t:w:j:s:f:h";
+   static struct option long_opts[10] = 
    {
      {"input", required_argument, 0, 'i'}, 
      {"output", required_argument, 0, 'o'}, 
      {"noise", required_argument, 0, 'n'}, 
      {"threshold", required_argument, 0, 't'}, 
      {"window", required_argument, 0, 'w'}, 
+     {"threads", required_argument, 0, 'j'}, 
+     {"seed", required_argument, 0, 's'}, 
+     {"frontend", required_argument, 0, 'f'}, 
      {"help", no_argument, 0, 'h'}, 
      {nullptr, no_argument, nullptr, 0}
    };
@@ -69,6 +146,9 @@ int main (int argc, char *argv[]) {
   Float_t noise_rms_eeV =  900.0; 
   Float_t threshold_eeV = 3800.0; 
   Float_t window_int_us =    1.0; 
+  UInt_t  n_threads = std::max(1u, std::thread::hardware_concurrency()); 
+  ULong_t seed = 4357; 
+  std::vector<std::pair<std::string, double>> fe_pars; 
 
   while ( (c = getopt_long(argc, argv, short_opts, long_opts, &option_index)) != -1) {
     switch(c) {
@@ -92,6 +172,26 @@ int main (int argc, char *argv[]) {
         window_int_us = std::atof(optarg);
         printf("integration window: %.2f μs\n", window_int_us); 
         break;
+      case 'j' : 
+        n_threads = std::max(1, std::atoi(optarg));
+        printf("worker threads: %u\n", n_threads); 
+        break;
+      case 's' : 
+        seed = std::strtoul(optarg, nullptr, 10);
+        printf("noise generator seed: %lu\n", seed); 
+        break;
+      case 'f' : 
+        {
+          const std::string par = optarg; 
+          const size_t eq = par.find('='); 
+          if (eq == std::string::npos) {
+            fprintf(stderr, "ERROR: front-end parameter must be given as name=value (%s)\n", optarg); 
+            exit( EXIT_FAILURE ); 
+          }
+          fe_pars.push_back( {par.substr(0, eq), std::atof(par.substr(eq+1).c_str())} ); 
+          printf("front-end parameter %s: %g\n", fe_pars.back().first.data(), fe_pars.back().second); 
+        }
+        break;
       case 'h' : 
         print_usage(); 
         exit( EXIT_SUCCESS ); 
@@ -104,6 +204,8 @@ int main (int argc, char *argv[]) {
     }
   }
 
+  if (n_threads > 1) ROOT::EnableThreadSafety(); 
+
   // Setup input file and MC event
   TFile* input_file = new TFile(input_file_path); 
   if (input_file->IsZombie()) {
@@ -117,19 +219,53 @@ int main (int argc, char *argv[]) {
         input_file_path.Data()); 
     exit( EXIT_FAILURE ); 
   }
-  SLArMCEvent* mc_ev = nullptr; 
-  mc_tree->SetBranchAddress("MCEvent", &mc_ev); 
-  // Setup anode configuration
+  const Long64_t n_entries = mc_tree->GetEntries(); 
+
+  // Setup anode configuration and precompute the pixel pad centers
   std::map<Int_t, SLArCfgAnode*> anodeConfig; 
   anodeConfig.insert( {10, input_file->Get<SLArCfgAnode>("AnodeCfg50")} );
   anodeConfig.insert( {11, input_file->Get<SLArCfgAnode>("AnodeCfg51")} );
   Float_t drift_velocity = 1.582e-3; // mm/ns
 
+  TPixelGeometryTable geo_table; 
+  for (const auto& cfg_itr : anodeConfig) {
+    if (cfg_itr.second == nullptr) {
+      fprintf(stderr, "WARNING: No anode configuration for TPC %i\n", cfg_itr.first); 
+      continue;
+    }
+    const int n_pads = geo_table.add_anode(cfg_itr.first, cfg_itr.second); 
+    printf("TPC %i: %i pixel pads in geometry table\n", cfg_itr.first, n_pads); 
+  }
+
+  // Setup workers
+  std::vector<ConverterWorker_t> workers(n_threads); 
+  for (auto& worker : workers) {
+    worker.input_file = new TFile(input_file_path); 
+    worker.mc_tree = worker.input_file->Get<TTree>("EventTree"); 
+    worker.mc_tree->SetBranchAddress("MCEvent", &worker.mc_ev); 
+
+    auto& ch_analyzer = worker.ch_analyzer; 
+    ch_analyzer.set_geometry_table( &geo_table ); 
+    ch_analyzer.set_drift_velocity( drift_velocity );
+    ch_analyzer.set_channel_rms( noise_rms_eeV ); 
+    ch_analyzer.set_hit_threshold( threshold_eeV ); 
+    ch_analyzer.set_integration_window( window_int_us ); 
+    for (const auto& par : fe_pars) {
+      try {
+        ch_analyzer.get_front_end().SetParameter(par.first, par.second); 
+      }
+      catch (const std::invalid_argument& e) {
+        fprintf(stderr, "ERROR: %s\n", e.what()); 
+        exit( EXIT_FAILURE ); 
+      }
+    }
+  }
+  workers.front().ch_analyzer.get_front_end().GetConfig().Print(); 
+
   // Setup output file
   TFile* output_file = new TFile(output_file_path, "recreate"); 
   TTree* hit_tree = new TTree("HitTree", "hit collection tree"); 
   UInt_t iev = 0; 
-  Int_t itpc = 0;
   hitvarContainers_t hitvars; 
   hit_tree->Branch("iev", &iev); 
   hit_tree->Branch("hit_x", &hitvars.hit_x);
@@ -139,61 +275,48 @@ int main (int argc, char *argv[]) {
   hit_tree->Branch("hit_qtrue", &hitvars.hit_qtrue);
   hit_tree->Branch("hit_tpc", &hitvars.hit_tpc);
 
-  TChannelAnalyzer ch_analyzer; 
-  
-  for (Long64_t entry = 0; entry < mc_tree->GetEntries(); entry++) {
-    hitvars.reset(); 
-
-    mc_tree->GetEntry( entry ); 
-    iev = mc_ev->GetEvNumber(); 
-
-    const auto& anodes_map = mc_ev->GetEventAnode(); 
-    for (const auto& anode_itr : anodes_map) {
-      itpc = anode_itr.first;
-      const SLArEventAnode& anode = anode_itr.second;
-      SLArCfgAnode* anode_cfg = anodeConfig[anode_itr.first]; 
-      const TVector3 drift_direction = anode_cfg->GetNormal(); 
-
-      ch_analyzer.set_anode_config( anode_cfg ); 
-      ch_analyzer.set_drift_direction( drift_direction ); 
-      ch_analyzer.set_drift_velocity( drift_velocity );
-      ch_analyzer.set_tpc_id( itpc ); 
-      ch_analyzer.set_channel_rms( noise_rms_eeV ); 
-
-      const auto& mt_map = anode.GetConstMegaTilesMap();
-      for (const auto& mt_itr : mt_map) {
-        const auto& mt = mt_itr.second;
-        //std::printf("[%i] mt hits: %i\n", mt_itr.first, mt.GetNChargeHits()); 
-        if (mt.GetNChargeHits() == 0) continue;
-
-        const auto& mt_cfg = anode_cfg->GetBaseElement(mt_itr.first);
-        
-        ch_analyzer.set_megatile_config( &mt_cfg ); 
-
-        const auto& t_map = mt.GetConstTileMap(); 
-        for (const auto &t_itr : t_map) {
-          const auto& t = t_itr.second;
-          if (t.GetPixelHits() == 0) continue;
-          //printf("\t[%i]: tile hits: %g\n", t_itr.first, t.GetNPixelHits()); 
-          const auto& t_cfg = mt_cfg.GetBaseElement(t_itr.first); 
-          ch_analyzer.set_tile_config( &t_cfg ); 
-          const auto& pixels = t.GetConstPixelEvents();
-          for (const auto& pixel_itr : pixels) {
-            ch_analyzer.process_channel(pixel_itr.first, pixel_itr.second, hitvars ); 
-          } // end of loop over pixels
-        } // end of loop over tiles
-      } // end of loop over megatiles
-    } // end of loop over anodes
-    hit_tree->Fill(); 
+  // Process the entries in blocks: within a block, entries are distributed 
+  // round-robin among the workers and then written to HitTree in order
+  const Long64_t block_size = 64 * n_threads; 
+  std::vector<ConvertedEvent_t> block( block_size ); 
+
+  for (Long64_t block_start = 0; block_start < n_entries; block_start += block_size) {
+    const Long64_t block_end = std::min(block_start + block_size, n_entries); 
+
+    auto process_block = [&](const UInt_t ithread) {
+      for (Long64_t entry = block_start + ithread; entry < block_end; entry += n_threads) {
+        convert_entry(workers[ithread], entry, geo_table, seed, block[entry - block_start]); 
+      }
+    };
+
+    std::vector<std::thread> threads; 
+    for (UInt_t ithread = 1; ithread < n_threads; ithread++) {
+      threads.emplace_back( process_block, ithread ); 
+    }
+    process_block( 0 ); 
+    for (auto& t : threads) t.join(); 
+
+    for (Long64_t entry = block_start; entry < block_end; entry++) {
+      auto& converted = block[entry - block_start]; 
+      iev = converted.iev; 
+      hitvars = std::move( converted.hitvars ); 
+      hit_tree->Fill(); 
+    }
+
+    printf("\rprocessed %lld/%lld entries", block_end, n_entries); 
+    fflush(stdout); 
   } // end of loop over tree entries
+  printf("\n"); 
 
+  output_file->cd(); 
   hit_tree->Write(); 
   output_file->Close(); 
 
+  for (auto& worker : workers) {
+    worker.input_file->Close(); 
+    delete worker.input_file;
+  }
   input_file->Close(); 
 
   return 0;
 }
-
-
-
@@ -5,6 +5,7 @@
  */
 
 #include <iostream>
+#include <cstdlib>
 #include <getopt.h>
 #include <iterator>
 #include <TFile.h>
@@ -29,17 +30,20 @@ void print_usage() {
   printf("hit_viewer\n"); 
   printf("\t[--input     | -i] input_simulatin_file\n"); 
   printf("\t[--control   | -c] output_hit_file\n"); 
+  printf("\t[--event     | -e] first event to display (default 0)\n"); 
   exit( EXIT_SUCCESS );
 }
 
-int process_file(const TString input_file_path, const TString control_file_path = "");
+int process_file(const TString input_file_path, const TString control_file_path = "", 
+    const Long64_t first_event = 0);
 
 int main (int argc, char *argv[]) {
-  const char* short_opts = "i:c:h";
-  static struct option long_opts[4] = 
+  const char* short_opts = "i:c:e:h";
+  static struct option long_opts[5] = 
   {
     {"input", required_argument, 0, 'i'}, 
     {"control", required_argument, 0, 'c'}, 
+    {"event", required_argument, 0, 'e'}, 
     {"help", no_argument, 0, 'h'}, 
     {nullptr, no_argument, nullptr, 0}
   };
@@ -48,6 +52,7 @@ int main (int argc, char *argv[]) {
 
   TString input_file_path = ""; 
   TString control_file_path = ""; 
+  Long64_t first_event = 0; 
 
   while ( (c = getopt_long(argc, argv, short_opts, long_opts, &option_index)) != -1) {
     switch(c) {
@@ -59,6 +64,10 @@ int main (int argc, char *argv[]) {
         control_file_path = optarg;
         printf("mc truth file: %s\n", control_file_path.Data());
         break;
+      case 'e' :
+        first_event = std::atoll(optarg);
+        printf("first event: %lld\n", first_event);
+        break;
       case 'h' : 
         print_usage(); 
         exit( EXIT_SUCCESS ); 
@@ -73,35 +82,24 @@ int main (int argc, char *argv[]) {
 
   TApplication app("hit_viewer", &argc, argv); 
 
-  process_file( input_file_path, control_file_path) ; 
+  process_file( input_file_path, control_file_path, first_event ) ; 
 
   app.Run(); 
 
   return 0;
 }
 
-int process_event(TTree* hit_tree, TTree* mc_truth_tree, const Long64_t iev) {
-  hit_tree->GetEntry(iev); 
-
-  if (mc_truth_tree) {
-    mc_truth_tree->GetEntry(iev); 
-  }
-  return 0;
-}
-
-int process_file(const TString input_file_path, const TString control_file_path)
+int process_file(const TString input_file_path, const TString control_file_path, 
+    const Long64_t first_event)
 {
   TFile* mc_truth_file = nullptr;
-  TTree* mc_truth_tree = nullptr;
-  SLArMCEvent* ev = 0; 
 
   display::SLArEveDisplay* eve_display = new display::SLArEveDisplay();
   eve_display->LoadHitFile( input_file_path, "HitTree" ); 
 
   if (control_file_path.IsNull() == false) {
+    // only the geometry description is needed here
     mc_truth_file = new TFile(control_file_path); 
-    mc_truth_tree = mc_truth_file->Get<TTree>("EventTree"); 
-    mc_truth_tree->SetBranchAddress("MCEvent", &ev); 
 
     auto geometry_str = mc_truth_file->Get<TObjString>("geometry"); 
     rapidjson::Document d; 
@@ -115,7 +113,7 @@ int process_file(const TString input_file_path, const TString control_file_path)
   }
 
   eve_display->MakeGUI();
-  eve_display->GoToEvent(0); 
+  eve_display->GoToEvent( first_event ); 
 
   if (mc_truth_file) {
     mc_truth_file->Close(); 
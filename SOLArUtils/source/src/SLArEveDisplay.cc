@@ -6,6 +6,7 @@
 
 #include "TObject.h"
 #include <SLArEveDisplay.hh>
+#include <THitTreeReader.hh>
 #include <SLArUnit.hpp>
 #include <TGeoManager.h>
 #include <TEveFrameBox.h>
@@ -28,7 +29,7 @@ namespace display {
 
 
   SLArEveDisplay::SLArEveDisplay() 
-    : TGMainFrame(nullptr, 800, 800), fHitFile(nullptr), fHitTree(nullptr), fLastEvent(1), fCurEvent(0)
+    : TGMainFrame(nullptr, 800, 800), fHitReader(nullptr), fLastEvent(1), fCurEvent(0)
   {
     //gStyle->SetPalette(kSunset);
     fTimer = std::make_unique<TTimer>("gSystem->ProcessEvents();", 50, kFALSE);
@@ -38,28 +39,23 @@ namespace display {
 
   SLArEveDisplay::~SLArEveDisplay()
   { 
-    if (fHitFile) {
-      fHitFile->Close(); 
-      delete fHitFile;
-    }
+    if (fHitReader) delete fHitReader;
   }
 
   int SLArEveDisplay::LoadHitFile(const TString file_path, const TString tree_key) {
-    if (fHitFile) {
-      fHitFile->Close();
-      fHitTree = nullptr;
-    }
-    fHitFile = new TFile( file_path ); 
-    fHitTree = fHitFile->Get<TTree>( tree_key ); 
-    if (fHitTree) {
-      fLastEvent = fHitTree->GetEntries() - 1; 
-      fHitTree->SetBranchAddress("hit_tpc"  , &fHitVars.hit_tpc); 
-      fHitTree->SetBranchAddress("hit_x"    , &fHitVars.hit_x); 
-      fHitTree->SetBranchAddress("hit_y"    , &fHitVars.hit_y); 
-      fHitTree->SetBranchAddress("hit_z"    , &fHitVars.hit_z); 
-      fHitTree->SetBranchAddress("hit_q"    , &fHitVars.hit_q); 
-      fHitTree->SetBranchAddress("hit_qtrue", &fHitVars.hit_qtrue); 
+    if (fHitReader) delete fHitReader;
+    fHitReader = new THitTreeReader( tree_key ); 
+    if (fHitReader->add_file( file_path ) == 0) {
+      printf("SLArEveDisplay::LoadHitFile ERROR: cannot read %s from %s\n", 
+          tree_key.Data(), file_path.Data()); 
+      delete fHitReader; 
+      fHitReader = nullptr;
+      return 1;
     }
+    // events are accessed at random: keep the cache small
+    fHitReader->set_cache_size( 2*1024*1024 ); 
+    fLastEvent = fHitReader->get_entries() - 1; 
+    fCurEvent = 0;
 
     return 0;
   }
@@ -173,16 +169,22 @@ namespace display {
   }
 
   int SLArEveDisplay::ReadHits() {
-    fHitTree->GetEntry( fCurEvent );
+    if (fHitReader == nullptr || fHitReader->load_entry( fCurEvent ) == false) {
+      return 1;
+    }
 
     float q_max = 0;
     
-    for (size_t ihit = 0; ihit < fHitVars.hit_tpc->size(); ihit++) {
-      int tpc_idx = GetTPCindex( fHitVars.hit_tpc->at(ihit) ); 
-      fHitSet.at(tpc_idx)->AddBox( 
-          fHitVars.hit_x->at(ihit), fHitVars.hit_y->at(ihit), fHitVars.hit_z->at(ihit) ); 
-      fHitSet.at(tpc_idx)->DigitValue( fHitVars.hit_q->at(ihit) ); 
-      if (fHitVars.hit_q->at(ihit) > q_max) q_max = fHitVars.hit_q->at(ihit);
+    const auto hit_tpc = fHitReader->hit_tpc(); 
+    const auto hit_x = fHitReader->hit_x(); 
+    const auto hit_y = fHitReader->hit_y(); 
+    const auto hit_z = fHitReader->hit_z(); 
+    const auto hit_q = fHitReader->hit_q(); 
+    for (size_t ihit = 0; ihit < hit_tpc.size(); ihit++) {
+      int tpc_idx = GetTPCindex( hit_tpc[ihit] ); 
+      fHitSet.at(tpc_idx)->AddBox( hit_x[ihit], hit_y[ihit], hit_z[ihit] ); 
+      fHitSet.at(tpc_idx)->DigitValue( hit_q[ihit] ); 
+      if (hit_q[ihit] > q_max) q_max = hit_q[ihit];
     }
 
     fPalette->SetMax(1.1*q_max); 
@@ -211,6 +213,7 @@ namespace display {
   }
 
   void SLArEveDisplay::GoToEvent(const Long64_t iev) {
+    fCurEvent = TMath::Min( TMath::Max(static_cast<Long64_t>(0), iev), fLastEvent ); 
     printf("display event %lld\n", fCurEvent);
     ResetHits(); 
 
@@ -220,12 +223,10 @@ namespace display {
   }
 
   void SLArEveDisplay::NextEvent() { 
-    fCurEvent = TMath::Max(static_cast<Long64_t>(0), fCurEvent+1); 
-    GoToEvent( fCurEvent ); 
+    GoToEvent( fCurEvent+1 ); 
   } 
   void SLArEveDisplay::PrevEvent() {
-    fCurEvent = TMath::Min(static_cast<Long64_t>(fLastEvent), fCurEvent-1); 
-    GoToEvent( fCurEvent ); 
+    GoToEvent( fCurEvent-1 ); 
   }
 
 
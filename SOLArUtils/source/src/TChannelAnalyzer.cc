@@ -7,54 +7,64 @@
 #include <iostream>
 #include <TChannelAnalyzer.hh>
 #include <TList.h>
-#include <TRandom3.h>
 
+/**
+ * Emulate the pixel front-end on the channel tick stream and record 
+ * a hit for each digitized packet. If the raw ticks have been dropped, 
+ * the packets produced by the emulator in solar_sim are used instead. 
+ */
 int TChannelAnalyzer::process_channel(const Int_t& pix_bin, const SLArEventChargePixel& pix_ev, hitvarContainers_t& hitvars)
 {
   int nhit = 0;
-  if (pix_ev.GetNhits() < 200) return nhit;
-
-  //printf("\t\tpixel [%i]: %i hits\n", pixel_itr.first, pixel_itr.second.GetNhits());
-  if (fClockUnit == 0) fClockUnit = pix_ev.GetClockUnit(); 
-  UInt_t window_int_cu = std::round(fIntegrationWindow * 1000 / fClockUnit);
-  const auto& hit_stream = pix_ev.GetConstHits();
-            
-  UInt_t q = 0;
-  UInt_t trigger_t = 0; 
-  Bool_t sampling = false;
-  UInt_t sampled_time = 0;
-  for (auto stream_itr = hit_stream.begin(); stream_itr != hit_stream.end(); stream_itr++) {
-    q += stream_itr->second;
-    //printf("\t\t\t q = %u\n", q);
-    if ( q > fHitThreshold ) {
-      trigger_t = stream_itr->first;
-      sampling = true;
-    }
 
-    if (sampling) {
-      sampled_time = stream_itr->first - trigger_t;
-      if (sampled_time > window_int_cu || std::next(stream_itr) == hit_stream.end()) {
-        try {
-          record_hit(pix_bin, q, trigger_t, hitvars);
-        }
-        catch (const std::exception& e) {
-          std::cerr << e.what() << std::endl;
-        }
-
-        q = 0; 
-        trigger_t = 0;
-        sampling = false;
-      } // end of record and reset
-    } // end of sampling
-      //getchar(); 
-  } // end of loop over hit stream on pixel
+  if (fClockUnit == 0) {
+    fClockUnit = pix_ev.GetClockUnit(); 
+    update_hold_ticks(); 
+  }
+
+  const std::vector<SLArPixelPacket_t>* packets = &pix_ev.GetConstPackets(); 
+  if (!pix_ev.GetConstHits().empty()) {
+    fPackets.clear(); 
+    fFrontEnd.Process( pix_ev.GetConstHits(), fPackets ); 
+    packets = &fPackets; 
+  }
+
+  for (const auto& packet : *packets) {
+    try {
+      nhit += record_hit(pix_bin, packet.fQTrue, fFrontEnd.ToElectrons(packet.fADC), packet.fTick, hitvars);
+    }
+    catch (const std::exception& e) {
+      std::cerr << e.what() << std::endl;
+    }
+  } // end of loop over channel packets
   return nhit;
 }
 
-int TChannelAnalyzer::record_hit(const Int_t& pix_bin, const UInt_t& q, const UInt_t& trigger_t, hitvarContainers_t& hitvars) {
+int TChannelAnalyzer::record_hit(const Int_t& pix_bin, const UInt_t& q_true, const Float_t& q_reco, const UInt_t& trigger_t, hitvarContainers_t& hitvars) {
   //create hit and reset
   RecoHit_t hit; 
   hit.time = trigger_t * fClockUnit;
+
+  if (fGeoTable) {
+    // fast path: precomputed pad center
+    const auto pad = fGeoTable->get_pad_center(fTPCID, fMegaTileIdx, fTileIdx, pix_bin); 
+    if (pad == nullptr) {
+      char err_msg[200]; 
+      sprintf(err_msg, "TChannelAnalyzer::record_hit(%i) ERROR: Cannot find pad center for ch with index %i\n", pix_bin, pix_bin); 
+      throw std::runtime_error(err_msg);
+    }
+    const Float_t drift_length = fDriftVelocity * trigger_t * fClockUnit; 
+    hit.x = pad->x + drift_length * fDriftDirection->x(); 
+    hit.y = pad->y + drift_length * fDriftDirection->y(); 
+    hit.z = pad->z + drift_length * fDriftDirection->z(); 
+    hit.charge_true = q_true;
+    hit.charge_reco = q_reco; 
+    hit.tpc_id = fTPCID;
+
+    hitvars.push_back( hit ); 
+    return 1;
+  }
+
   TH2Poly* hbin = fCfgAnode->GetAnodeMap(2); 
   TH2PolyBin* bin = nullptr;
   bin = (TH2PolyBin*)hbin->GetBins()->At(pix_bin-1);
@@ -87,13 +97,11 @@ int TChannelAnalyzer::record_hit(const Int_t& pix_bin, const UInt_t& q, const UI
     hit.x = hit_coordinates.x(); 
     hit.y = hit_coordinates.y(); 
     hit.z = hit_coordinates.z(); 
-    hit.charge_true = q;
-    hit.charge_reco = q + gRandom->Gaus(0, fChannelPedestalRMS); 
+    hit.charge_true = q_true;
+    hit.charge_reco = q_reco; 
     hit.tpc_id = fTPCID;
 
-    if (hit.charge_reco >= fHitThreshold) {
-      hitvars.push_back( hit ); 
-    }
+    hitvars.push_back( hit ); 
   }
   else {
     char err_msg[200]; 
@@ -0,0 +1,36 @@
+/**
+ * @author      : Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        : THitTreeReader.cc
+ * @created     : Monday Oct 19, 2026 17:52:17 CEST
+ */
+
+#include <THitTreeReader.hh>
+#include <ROOT/RVec.hxx>
+
+THitTreeReader::THitTreeReader(const TString tree_key) 
+  : TSLArTreeReader(tree_key)
+{
+  fCachedBranches = {"iev", "hit_x", "hit_y", "hit_z", "hit_q", "hit_qtrue", "hit_tpc"}; 
+}
+
+void THitTreeReader::book_columns(TTreeReader& reader) {
+  fIev      = std::make_unique<TTreeReaderValue<UInt_t>>(reader, "iev"); 
+  fHitX     = std::make_unique<TTreeReaderArray<Float_t>>(reader, "hit_x"); 
+  fHitY     = std::make_unique<TTreeReaderArray<Float_t>>(reader, "hit_y"); 
+  fHitZ     = std::make_unique<TTreeReaderArray<Float_t>>(reader, "hit_z"); 
+  fHitQ     = std::make_unique<TTreeReaderArray<Float_t>>(reader, "hit_q"); 
+  fHitQTrue = std::make_unique<TTreeReaderArray<Float_t>>(reader, "hit_qtrue"); 
+  fHitTPC   = std::make_unique<TTreeReaderArray<Int_t>>(reader, "hit_tpc"); 
+  return;
+}
+
+/**
+ * @details The hit branches are read as ROOT::RVec columns, plus the 
+ * per-event summary columns `n_hits` and `hit_q_tot`.
+ */
+ROOT::RDF::RNode THitTreeReader::make_dataframe() const {
+  ROOT::RDF::RNode df = make_rdataframe(); 
+  return df
+    .Define("n_hits", [](const ROOT::RVec<Float_t>& q) {return q.size();}, {"hit_q"})
+    .Define("hit_q_tot", [](const ROOT::RVec<Float_t>& q) {return ROOT::VecOps::Sum(q);}, {"hit_q"}); 
+}
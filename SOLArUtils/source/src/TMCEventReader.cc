@@ -0,0 +1,104 @@
+/**
+ * @author      : Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        : TMCEventReader.cc
+ * @created     : Monday Oct 19, 2026 18:15:09 CEST
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <ROOT/RVec.hxx>
+#include <TMCEventReader.hh>
+
+TMCEventReader::TMCEventReader(const TString tree_key, const TString branch_key) 
+  : TSLArTreeReader(tree_key), fBranchKey(branch_key)
+{}
+
+void TMCEventReader::set_branch_read(const TString pattern, const bool do_read) {
+  if (fReader) {
+    char err_msg[200]; 
+    sprintf(err_msg, "TMCEventReader::set_branch_read(%s) ERROR: reader already initialized\n", 
+        pattern.Data()); 
+    throw std::runtime_error(err_msg); 
+  }
+
+  auto itr = std::find(fDisabledBranches.begin(), fDisabledBranches.end(), pattern); 
+  if (do_read && itr != fDisabledBranches.end()) fDisabledBranches.erase(itr); 
+  else if (!do_read && itr == fDisabledBranches.end()) fDisabledBranches.push_back(pattern); 
+  return;
+}
+
+void TMCEventReader::read_trajectories(const bool do_read) {
+  set_branch_read("*fTrajectories*", do_read); 
+}
+
+void TMCEventReader::read_anodes(const bool do_read) {
+  set_branch_read("*fEvAnode*", do_read); 
+}
+
+void TMCEventReader::read_supercells(const bool do_read) {
+  set_branch_read("*fEvSuperCellArray*", do_read); 
+}
+
+void TMCEventReader::book_columns(TTreeReader& reader) {
+  for (const auto& pattern : fDisabledBranches) {
+    fChain.SetBranchStatus(pattern, false); 
+  }
+  fEvent = std::make_unique<TTreeReaderValue<SLArMCEvent>>(reader, fBranchKey); 
+  return;
+}
+
+void TMCEventReader::on_entry_loaded() {
+  // the track ID index is transient
+  fEvent->Get()->BuildPrimaryIndex(); 
+  return;
+}
+
+/**
+ * @details Event-level columns extracted from the `MCEvent` branch: 
+ * `ev_number`, `n_primaries` and the per-primary vectors `primary_pdg`, 
+ * `primary_trkid`, `primary_energy`, `primary_edep`, `primary_vtx_[xyz]`
+ * and `primary_n_scint`. The full event remains available as `MCEvent`. 
+ */
+ROOT::RDF::RNode TMCEventReader::make_dataframe() const {
+  using ROOT::RVec; 
+  const std::string br = fBranchKey.Data(); 
+  ROOT::RDF::RNode df = make_rdataframe(); 
+
+  auto get_vtx = [](const int k) {
+    return [k](SLArMCEvent& ev) {
+      RVec<double> v; v.reserve( ev.GetPrimaries().size() ); 
+      for (const auto& p : ev.GetPrimaries()) {
+        const auto& vtx = p.GetVertex(); 
+        v.push_back( vtx.size() > static_cast<size_t>(k) ? vtx[k] : 0. ); 
+      }
+      return v; 
+    };
+  }; 
+
+  return df
+    .Define("ev_number", [](SLArMCEvent& ev) {return ev.GetEvNumber();}, {br})
+    .Define("n_primaries", [](SLArMCEvent& ev) {return ev.GetPrimaries().size();}, {br})
+    .Define("primary_pdg", [](SLArMCEvent& ev) {
+        RVec<int> v; v.reserve( ev.GetPrimaries().size() ); 
+        for (const auto& p : ev.GetPrimaries()) v.push_back( p.GetCode() ); 
+        return v;}, {br})
+    .Define("primary_trkid", [](SLArMCEvent& ev) {
+        RVec<int> v; v.reserve( ev.GetPrimaries().size() ); 
+        for (const auto& p : ev.GetPrimaries()) v.push_back( p.GetTrackID() ); 
+        return v;}, {br})
+    .Define("primary_energy", [](SLArMCEvent& ev) {
+        RVec<double> v; v.reserve( ev.GetPrimaries().size() ); 
+        for (const auto& p : ev.GetPrimaries()) v.push_back( p.GetEnergy() ); 
+        return v;}, {br})
+    .Define("primary_edep", [](SLArMCEvent& ev) {
+        RVec<double> v; v.reserve( ev.GetPrimaries().size() ); 
+        for (const auto& p : ev.GetPrimaries()) v.push_back( p.GetTotalEdep() ); 
+        return v;}, {br})
+    .Define("primary_n_scint", [](SLArMCEvent& ev) {
+        RVec<int> v; v.reserve( ev.GetPrimaries().size() ); 
+        for (const auto& p : ev.GetPrimaries()) v.push_back( p.GetTotalScintPhotons() ); 
+        return v;}, {br})
+    .Define("primary_vtx_x", get_vtx(0), {br})
+    .Define("primary_vtx_y", get_vtx(1), {br})
+    .Define("primary_vtx_z", get_vtx(2), {br}); 
+}
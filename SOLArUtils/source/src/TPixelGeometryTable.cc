@@ -0,0 +1,93 @@
+/**
+ * @author      : Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        : TPixelGeometryTable.cc
+ * @created     : Monday Oct 19, 2026 10:20:47 CEST
+ */
+
+#include <stdexcept>
+#include <TPixelGeometryTable.hh>
+#include <TGraph.h>
+#include <TList.h>
+#include <TRotation.h>
+
+int TPixelGeometryTable::add_anode(const Int_t tpc_id, SLArCfgAnode* anode_cfg) {
+  if (anode_cfg == nullptr) {
+    char err_msg[200];
+    sprintf(err_msg, "TPixelGeometryTable::add_anode(%i) ERROR: null anode configuration\n", tpc_id);
+    throw std::invalid_argument(err_msg);
+  }
+
+  AnodeTable_t table;
+  table.drift_direction = anode_cfg->GetNormal();
+
+  // pixel pad centers in the tile reference frame
+  TH2Poly* hpix = anode_cfg->GetAnodeMap(2);
+  const TVector3& axis_x = anode_cfg->GetAxis0();
+  const TVector3& axis_y = anode_cfg->GetAxis1();
+  std::vector<TVector3> pix_pos;
+  pix_pos.reserve( hpix->GetBins()->GetSize() );
+  for (const auto& obj : *hpix->GetBins()) {
+    const TGraph* g = static_cast<TGraph*>( static_cast<TH2PolyBin*>(obj)->GetPolygon() );
+    double x = 0.;
+    double y = 0.;
+    for (int i=0; i<g->GetN(); i++) {
+      x += g->GetX()[i];
+      y += g->GetY()[i];
+    }
+    x /= g->GetN();
+    y /= g->GetN();
+    pix_pos.push_back( axis_x*x + axis_y*y );
+  }
+  table.n_pixels = pix_pos.size();
+
+  TRotation rot;
+  rot.SetXEulerAngles( anode_cfg->GetPhi(), anode_cfg->GetTheta(), anode_cfg->GetPsi() );
+  const TVector3 anode_pos( anode_cfg->GetX(), anode_cfg->GetY(), anode_cfg->GetZ() );
+
+  UInt_t n_tiles_tot = 0;
+  for (const auto& mt_cfg : anode_cfg->GetConstMap()) {
+    table.tile_offset.push_back( n_tiles_tot );
+    table.n_tiles.push_back( mt_cfg.GetConstMap().size() );
+    n_tiles_tot += mt_cfg.GetConstMap().size();
+  }
+
+  table.pads.resize( n_tiles_tot * table.n_pixels );
+  size_t ipad = 0;
+  for (const auto& mt_cfg : anode_cfg->GetConstMap()) {
+    const TVector3 mt_pos( mt_cfg.GetX(), mt_cfg.GetY(), mt_cfg.GetZ() );
+    for (const auto& t_cfg : mt_cfg.GetConstMap()) {
+      TVector3 tile_pos = mt_pos + TVector3( t_cfg.GetX(), t_cfg.GetY(), t_cfg.GetZ() );
+      const TVector3 tile_phys = tile_pos.Transform(rot) + anode_pos;
+      for (const auto& p : pix_pos) {
+        auto& pad = table.pads[ipad++];
+        pad.x = tile_phys.x() + p.x();
+        pad.y = tile_phys.y() + p.y();
+        pad.z = tile_phys.z() + p.z();
+      }
+    }
+  }
+
+  fAnodes[tpc_id] = std::move(table);
+  return n_tiles_tot * pix_pos.size();
+}
+
+const TPixelGeometryTable::PadCenter_t* TPixelGeometryTable::get_pad_center(
+    const Int_t tpc_id, const Int_t mt_idx, const Int_t tile_idx, const Int_t pix_bin) const
+{
+  const auto anode_itr = fAnodes.find(tpc_id);
+  if (anode_itr == fAnodes.end()) return nullptr;
+  const auto& table = anode_itr->second;
+
+  if (mt_idx < 0 || mt_idx >= static_cast<Int_t>(table.tile_offset.size())) return nullptr;
+  if (tile_idx < 0 || tile_idx >= static_cast<Int_t>(table.n_tiles[mt_idx])) return nullptr;
+  if (pix_bin < 1 || pix_bin > static_cast<Int_t>(table.n_pixels)) return nullptr;
+
+  const size_t idx =
+    (table.tile_offset[mt_idx] + tile_idx) * static_cast<size_t>(table.n_pixels) + (pix_bin-1);
+  return &table.pads[idx];
+}
+
+const TVector3& TPixelGeometryTable::get_drift_direction(const Int_t tpc_id) const {
+  return fAnodes.at(tpc_id).drift_direction;
+}
+
@@ -0,0 +1,139 @@
+/**
+ * @author      : Daniele Guffanti (daniele.guffanti@mib.infn.it)
+ * @file        : TSLArTreeReader.cc
+ * @created     : Monday Oct 19, 2026 17:21:40 CEST
+ */
+
+#include <fstream>
+#include <stdexcept>
+#include <TROOT.h>
+#include <TSLArTreeReader.hh>
+
+TSLArTreeReader::TSLArTreeReader(const TString tree_key)
+  : fTreeKey(tree_key), fChain(tree_key), fReader(nullptr),
+    fCacheSize(32*1024*1024), fCacheLearnEntries(10),
+    fFirstEntry(0), fLastEntry(-1), fCurrentEntry(-1)
+{}
+
+TSLArTreeReader::~TSLArTreeReader()
+{
+  fReader.reset();
+}
+
+int TSLArTreeReader::add_file(const TString file_path) {
+  if (fReader) {
+    char err_msg[200];
+    sprintf(err_msg, "TSLArTreeReader::add_file(%s) ERROR: cannot add files after the first read\n",
+        file_path.Data());
+    throw std::runtime_error(err_msg);
+  }
+  const int n_added = fChain.Add(file_path);
+  if (n_added > 0) fFileNames.push_back( file_path.Data() );
+  return n_added;
+}
+
+int TSLArTreeReader::add_file_list(const TString list_path) {
+  std::ifstream file_list( list_path.Data() );
+  if (!file_list.is_open()) {
+    char err_msg[200];
+    sprintf(err_msg, "TSLArTreeReader::add_file_list(%s) ERROR: cannot open file list\n",
+        list_path.Data());
+    throw std::runtime_error(err_msg);
+  }
+
+  int n_added = 0;
+  std::string line;
+  while ( std::getline(file_list, line) ) {
+    if (line.empty() || line[0] == '#') continue;
+    n_added += add_file( line.c_str() );
+  }
+  return n_added;
+}
+
+void TSLArTreeReader::set_cache_size(const Long64_t cache_size) {
+  fCacheSize = cache_size;
+  if (fReader) fChain.SetCacheSize( fCacheSize );
+  return;
+}
+
+void TSLArTreeReader::set_entry_range(const Long64_t first, const Long64_t last) {
+  fFirstEntry = first;
+  fLastEntry = last;
+  if (fReader) fReader->SetEntriesRange(fFirstEntry, fLastEntry);
+  return;
+}
+
+/**
+ * @details Create the TTreeReader and let the derived reader book its
+ * columns. The TTreeCache is restricted to the booked branches when they
+ * are known, otherwise it learns the accessed branches on the first
+ * entries.
+ */
+void TSLArTreeReader::init() {
+  if (fReader) return;
+
+  fReader = std::make_unique<TTreeReader>(&fChain);
+  book_columns( *fReader );
+
+  // the cache is attached to the current file of the chain: load the first
+  // tree before configuring it, it is then carried over when switching files
+  fChain.SetCacheSize( fCacheSize );
+  if (fCacheSize > 0 && fChain.LoadTree(fFirstEntry) >= 0) {
+    if (fCachedBranches.empty()) {
+      fChain.SetCacheLearnEntries( fCacheLearnEntries );
+    }
+    else {
+      for (const auto& branch : fCachedBranches) {
+        fChain.AddBranchToCache( branch, kTRUE );
+      }
+      fChain.StopCacheLearningPhase();
+    }
+  }
+
+  if (fLastEntry > fFirstEntry || fFirstEntry > 0) {
+    fReader->SetEntriesRange(fFirstEntry, fLastEntry);
+  }
+  return;
+}
+
+Long64_t TSLArTreeReader::get_entries() {
+  init();
+  return fReader->GetEntries();
+}
+
+bool TSLArTreeReader::load_entry(const Long64_t entry) {
+  init();
+  if (fReader->SetEntry(entry) != TTreeReader::kEntryValid) {
+    return false;
+  }
+  fCurrentEntry = entry;
+  on_entry_loaded();
+  return true;
+}
+
+bool TSLArTreeReader::next() {
+  init();
+  if (fReader->Next() == false) return false;
+  fCurrentEntry = fReader->GetCurrentEntry();
+  on_entry_loaded();
+  return true;
+}
+
+ROOT::RDataFrame TSLArTreeReader::make_rdataframe() const {
+  if (fFileNames.empty()) {
+    char err_msg[200];
+    sprintf(err_msg, "TSLArTreeReader::make_rdataframe() ERROR: no input file for %s\n",
+        fTreeKey.Data());
+    throw std::runtime_error(err_msg);
+  }
+  return ROOT::RDataFrame(fTreeKey.Data(), fFileNames);
+}
+
+void TSLArTreeReader::enable_implicit_mt(const UInt_t n_threads) {
+  if (ROOT::IsImplicitMTEnabled()) return;
+  ROOT::EnableImplicitMT(n_threads);
+  printf("TSLArTreeReader: implicit multithreading enabled with %u threads\n",
+      ROOT::GetThreadPoolSize());
+  return;
+}
+